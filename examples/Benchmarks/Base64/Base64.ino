@@ -0,0 +1,142 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example tests the conformance and the throughput of the base64 encoder and decoder
+ * which are used for blob and file data.
+ *
+ * The RFC 4648 test vectors and the random data of all lengths up to MAX_TEST_LENGTH are encoded,
+ * compared with the simple reference encoder and decoded back.
+ *
+ * The encode and decode throughput of DATA_SIZE bytes data are printed.
+ * No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the maximum length of random data to test and the size of data to benchmark */
+#define MAX_TEST_LENGTH 130
+#define DATA_SIZE 4096
+#define ROUNDS 20
+
+Base64Helper bh;
+MB_FS mbfs;
+
+const char *rfc_vectors[][2] = {{"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}};
+
+// The reference encoder which encodes one bit group at a time.
+MB_String refEncode(const uint8_t *src, size_t len)
+{
+  const char *table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  MB_String out;
+  uint32_t bits = 0;
+  int count = 0;
+  for (size_t i = 0; i < len; i++)
+  {
+    bits = (bits << 8) | src[i];
+    count += 8;
+    while (count >= 6)
+    {
+      count -= 6;
+      out += table[(bits >> count) & 0x3F];
+    }
+  }
+  if (count > 0)
+    out += table[(bits << (6 - count)) & 0x3F];
+  while (out.length() % 4)
+    out += '=';
+  return out;
+}
+
+bool roundTrip(const uint8_t *data, size_t len, const char *expected)
+{
+  MB_String encoded = bh.encodeToString(&mbfs, (uint8_t *)data, len);
+
+  MB_VECTOR<uint8_t> decoded;
+  bool ok = strcmp(encoded.c_str(), expected) == 0;
+
+  // The empty string has nothing to decode.
+  if (len > 0)
+  {
+    ok &= bh.decodeToArray<uint8_t>(&mbfs, encoded, decoded);
+    ok &= decoded.size() == len && memcmp(decoded.data(), data, len) == 0;
+  }
+
+  if (!ok)
+    Serial.printf("Length %d, encoded %s, expected %s, decoded %d bytes\n", (int)len, encoded.c_str(), expected, (int)decoded.size());
+
+  return ok;
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+
+  randomSeed(micros());
+
+  int failed = 0;
+
+  for (size_t i = 0; i < sizeof(rfc_vectors) / sizeof(rfc_vectors[0]); i++)
+  {
+    if (!roundTrip((const uint8_t *)rfc_vectors[i][0], strlen(rfc_vectors[i][0]), rfc_vectors[i][1]))
+      failed++;
+  }
+
+  uint8_t *data = new uint8_t[DATA_SIZE];
+  for (int i = 0; i < DATA_SIZE; i++)
+    data[i] = random(256);
+
+  for (size_t len = 0; len <= MAX_TEST_LENGTH; len++)
+  {
+    if (!roundTrip(data, len, refEncode(data, len).c_str()))
+      failed++;
+  }
+
+  Serial.printf("Conformance: %d failed\n", failed);
+
+  MB_String encoded;
+  MB_VECTOR<uint8_t> decoded;
+  decoded.reserve(DATA_SIZE);
+
+  unsigned long us = micros();
+  for (int i = 0; i < ROUNDS; i++)
+    encoded = bh.encodeToString(&mbfs, data, DATA_SIZE);
+  unsigned long encode_us = micros() - us;
+
+  us = micros();
+  for (int i = 0; i < ROUNDS; i++)
+  {
+    decoded.clear();
+    bh.decodeToArray<uint8_t>(&mbfs, encoded, decoded);
+  }
+  unsigned long decode_us = micros() - us;
+
+  if (decoded.size() != DATA_SIZE || memcmp(decoded.data(), data, DATA_SIZE) != 0)
+    failed++;
+
+  delete[] data;
+
+  // The bytes per us are MB per second.
+  Serial.printf("Encode %.2f MB/s, decode %.2f MB/s of %d bytes data\n",
+                encode_us > 0 ? (float)DATA_SIZE * ROUNDS / encode_us : 0,
+                decode_us > 0 ? (float)DATA_SIZE * ROUNDS / decode_us : 0, DATA_SIZE);
+
+  Serial.printf("Base64 test %s\n", failed == 0 ? "PASSED" : "FAILED");
+}
+
+void loop()
+{
+}
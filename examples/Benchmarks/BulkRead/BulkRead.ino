@@ -0,0 +1,205 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example benchmarks the reading of server response through the receive buffer of TCP client
+ * by replaying the canned RTDB response.
+ *
+ * The canned client serves the HTTP response of PAYLOAD_SIZE bytes string in SEGMENT_SIZE bytes segments
+ * as the network client does. The response header is read line by line and the payload is read in blocks,
+ * then the same response is read one byte per read for comparison.
+ *
+ * The read throughput in bytes per second is printed, the test fails when the payload that was read
+ * does not match the canned payload. No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the size of payload, the size of network segment and the number of reads */
+#define PAYLOAD_SIZE 8192
+#define SEGMENT_SIZE 1460
+#define READ_ROUNDS 50
+
+// The client that serves the canned response instead of the network.
+class CannedClient : public Client
+{
+public:
+  void setResponse(const char *data, size_t len)
+  {
+    _data = data;
+    _len = len;
+    _pos = 0;
+  }
+
+  void rewind() { _pos = 0; }
+
+  int connect(IPAddress ip, uint16_t port) { return 1; }
+  int connect(const char *host, uint16_t port) { return 1; }
+  size_t write(uint8_t b) { return 1; }
+  size_t write(const uint8_t *buf, size_t size) { return size; }
+
+  // The data of current segment only is available as it was received from network.
+  int available()
+  {
+    size_t remaining = SEGMENT_SIZE - _pos % SEGMENT_SIZE;
+    return _len - _pos < remaining ? _len - _pos : remaining;
+  }
+
+  int read()
+  {
+    return _pos < _len ? (uint8_t)_data[_pos++] : -1;
+  }
+
+  int read(uint8_t *buf, size_t size)
+  {
+    int avail = available();
+    if (avail <= 0)
+      return -1;
+    if ((int)size > avail)
+      size = avail;
+    memcpy(buf, _data + _pos, size);
+    _pos += size;
+    return size;
+  }
+
+  int peek() { return _pos < _len ? (uint8_t)_data[_pos] : -1; }
+  void flush() {}
+  void stop() {}
+  uint8_t connected() { return 1; }
+  operator bool() { return true; }
+
+private:
+  const char *_data = nullptr;
+  size_t _len = 0, _pos = 0;
+};
+
+CannedClient canned;
+Firebase_TCP_Client tcp;
+HttpHelper hh;
+int responseCode = 0;
+
+MB_String response;
+char *payload = nullptr;
+
+void networkConnection() {}
+void networkStatus() { tcp.setNetworkStatus(true); }
+
+// Read the response header and return the content length.
+int readHeader()
+{
+  char line[128];
+  int contentLength = -1;
+  while (true)
+  {
+    int len = hh.readLine(&tcp, line, sizeof(line) - 1);
+    if (len <= 0)
+      return -1;
+    line[len] = 0;
+    if (strncmp(line, "Content-Length: ", 16) == 0)
+      contentLength = atoi(line + 16);
+    if (strcmp(line, "\r\n") == 0)
+      return contentLength;
+  }
+}
+
+// Read the payload in blocks.
+int readBlocks(int len)
+{
+  int read = 0;
+  while (read < len)
+  {
+    int n = hh.readAvailable(&tcp, payload + read, len - read);
+    if (n <= 0)
+      break;
+    read += n;
+  }
+  return read;
+}
+
+// Read the payload one byte per read.
+int readBytes(int len)
+{
+  int read = 0;
+  while (read < len && tcp.available() > 0)
+  {
+    int c = tcp.read();
+    if (c < 0)
+      break;
+    payload[read++] = c;
+  }
+  return read;
+}
+
+bool readRound(bool block, unsigned long &us)
+{
+  // The unread data is discarded by flush before the response is replayed.
+  tcp.flush();
+  canned.rewind();
+
+  unsigned long start = micros();
+  int len = readHeader();
+  int read = len == PAYLOAD_SIZE + 2 ? (block ? readBlocks(len) : readBytes(len)) : 0;
+  us += micros() - start;
+
+  // The payload is the JSON string of the canned data.
+  return read == len && memcmp(payload, response.c_str() + response.length() - len, len) == 0;
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+
+  response = "HTTP/1.1 200 OK\r\nServer: nginx\r\nContent-Type: application/json; charset=utf-8\r\n"
+             "Connection: keep-alive\r\nAccess-Control-Allow-Origin: *\r\nCache-Control: no-cache\r\n";
+  response += "Content-Length: ";
+  response += PAYLOAD_SIZE + 2;
+  response += "\r\n\r\n\"";
+  for (int i = 0; i < PAYLOAD_SIZE; i++)
+    response += (char)('a' + i % 26);
+  response += "\"";
+
+  payload = new char[PAYLOAD_SIZE + 2];
+
+  canned.setResponse(response.c_str(), response.length());
+  tcp.setClient(&canned, networkConnection, networkStatus);
+  tcp.begin("canned.firebaseio.com", 80, &responseCode);
+
+  bool ok = tcp.connect();
+  if (!ok)
+    Serial.println("Connect canned client... FAILED");
+
+  unsigned long block_us = 0, byte_us = 0;
+
+  for (int i = 0; ok && i < READ_ROUNDS; i++)
+  {
+    ok &= readRound(true, block_us);
+    ok &= readRound(false, byte_us);
+  }
+
+  delete[] payload;
+
+  unsigned long bytes = (unsigned long)response.length() * READ_ROUNDS;
+
+  Serial.printf("Block read %lu bytes/sec, byte read %lu bytes/sec of %d bytes response\n",
+                block_us > 0 ? (unsigned long)((double)bytes * 1000000 / block_us) : 0,
+                byte_us > 0 ? (unsigned long)((double)bytes * 1000000 / byte_us) : 0, (int)response.length());
+
+  Serial.printf("Bulk read test %s\n", ok ? "PASSED" : "FAILED");
+}
+
+void loop()
+{
+}
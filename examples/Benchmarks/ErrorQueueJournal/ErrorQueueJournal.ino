@@ -0,0 +1,123 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example tests the Firebase Error Queues journal file and compares its write time with saveErrorQueue.
+ *
+ * The WiFi is turned off, the failed set operations are added to the error queues and each one is appended
+ * to the journal file in flash. The time of the append per queue and the time of saving the whole queues
+ * with saveErrorQueue are printed.
+ *
+ * The queues are then cleared from memory only and restored from the journal file as it happens
+ * after the power loss, the test fails when the number of restored queues is not the same.
+ *
+ * No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the RTDB URL and database secret, the requests are not sent */
+#define DATABASE_URL "URL" //<databaseName>.firebaseio.com or <databaseName>.<region>.firebasedatabase.app
+#define DATABASE_SECRET "DATABASE_SECRET"
+
+/* 2. Define the number of queues and the files */
+#define QUEUE_COUNT 50
+#define JOURNAL_FILE "/test/queue.jnl"
+#define QUEUE_FILE "/test/queue.txt"
+
+FirebaseData fbdo;
+
+FirebaseAuth auth;
+FirebaseConfig config;
+
+bool check(const char *step, int expected)
+{
+  int count = Firebase.errorQueueCount(fbdo);
+  Serial.printf("%s, %d queues%s\n", step, count, count == expected ? "" : ", FAILED");
+  return count == expected;
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  WiFi.mode(WIFI_OFF);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+
+  config.database_url = DATABASE_URL;
+  config.signer.tokens.legacy_token = DATABASE_SECRET;
+
+  Firebase.reconnectNetwork(false);
+
+  Firebase.begin(&config, &auth);
+
+  Firebase.setMaxErrorQueue(fbdo, QUEUE_COUNT);
+
+  Firebase.deleteStorageFile(JOURNAL_FILE, StorageType::FLASH);
+  Firebase.deleteStorageFile(JOURNAL_FILE ".tmp", StorageType::FLASH);
+  Firebase.deleteStorageFile(QUEUE_FILE, StorageType::FLASH);
+
+  bool ok = Firebase.beginErrorQueueJournal(fbdo, JOURNAL_FILE, StorageType::FLASH);
+  if (!ok)
+    Serial.printf("Begin journal... %s\n", fbdo.errorReason().c_str());
+
+  // Each failed set operation is added to the queues and appended to the journal.
+  unsigned long ms = millis();
+  for (int i = 0; i < QUEUE_COUNT; i++)
+  {
+    MB_String path = "/test/journal/";
+    path += i;
+    Firebase.setInt(fbdo, path.c_str(), i);
+  }
+  unsigned long append_ms = millis() - ms;
+
+  ok &= check("Add", QUEUE_COUNT);
+
+  // The whole queues are rewritten to file.
+  ms = millis();
+  ok &= Firebase.saveErrorQueue(fbdo, QUEUE_FILE, StorageType::FLASH);
+  unsigned long save_ms = millis() - ms;
+
+  ok &= Firebase.errorQueueCount(fbdo, QUEUE_FILE, StorageType::FLASH) == QUEUE_COUNT;
+
+  Serial.printf("Journal append %.2f ms per queue, saveErrorQueue %lu ms for %d queues\n",
+                (float)append_ms / QUEUE_COUNT, save_ms, QUEUE_COUNT);
+
+  // The queues in memory are lost while the journal file is kept.
+  Firebase.endErrorQueueJournal(fbdo);
+  Firebase.clearErrorQueue(fbdo);
+  ok &= check("Clear memory", 0);
+
+  ms = millis();
+  ok &= Firebase.beginErrorQueueJournal(fbdo, JOURNAL_FILE, StorageType::FLASH);
+  Serial.printf("Restore from journal in %lu ms\n", millis() - ms);
+  ok &= check("Restore", QUEUE_COUNT);
+
+  // The cleared queues are also cleared from journal.
+  Firebase.clearErrorQueue(fbdo);
+  Firebase.endErrorQueueJournal(fbdo);
+  ok &= Firebase.beginErrorQueueJournal(fbdo, JOURNAL_FILE, StorageType::FLASH);
+  ok &= check("Clear and restore", 0);
+
+  Firebase.endErrorQueueJournal(fbdo);
+  Firebase.deleteStorageFile(JOURNAL_FILE, StorageType::FLASH);
+  Firebase.deleteStorageFile(QUEUE_FILE, StorageType::FLASH);
+
+  Serial.printf("Error queue journal test %s\n", ok ? "PASSED" : "FAILED");
+}
+
+void loop()
+{
+}
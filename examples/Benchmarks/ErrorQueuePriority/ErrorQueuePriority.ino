@@ -0,0 +1,206 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example tests the capacity, the lookup time and the priority classes of the Firebase Error Queues.
+ *
+ * While WiFi is off, QUEUE_CAPACITY failed set operations (more than 255) are added to the queues,
+ * the time of add and the time of queue ID lookup are printed and the next add should be rejected as the queues are full.
+ *
+ * Then the queues of bulk, normal and control priority classes are added in turn, the WiFi is connected and
+ * the queues are processed. The test fails when the control queues are not processed first, or the queues
+ * of the same class are not processed in the order they were added.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the WiFi credentials */
+#define WIFI_SSID "WIFI_AP"
+#define WIFI_PASSWORD "WIFI_PASSWORD"
+
+/* 2. Define the RTDB URL and database secret */
+#define DATABASE_URL "URL" //<databaseName>.firebaseio.com or <databaseName>.<region>.firebasedatabase.app
+#define DATABASE_SECRET "DATABASE_SECRET"
+
+/* 3. Define the number of queues for the capacity test and the priority test */
+#define QUEUE_CAPACITY 300
+#define PRIORITY_QUEUES 12
+
+FirebaseData fbdo;
+
+FirebaseAuth auth;
+FirebaseConfig config;
+
+uint32_t queueID[QUEUE_CAPACITY];
+
+int processed[PRIORITY_QUEUES];
+int processedCount = 0;
+
+#if defined(ARDUINO_RASPBERRY_PI_PICO_W)
+WiFiMulti multi;
+#endif
+
+void callback(QueueInfo queueinfo)
+{
+  String path = queueinfo.dataPath();
+  const char *node = strrchr(path.c_str(), '/');
+  if (node && processedCount < PRIORITY_QUEUES)
+    processed[processedCount++] = atoi(node + 1);
+}
+
+firebase_queue_priority priorityOf(int index)
+{
+  return (firebase_queue_priority)(index % FIREBASE_QUEUE_PRIORITY_CLASSES);
+}
+
+bool addQueue(const char *node, int index)
+{
+  MB_String path = "/test/";
+  path += node;
+  path += "/";
+  path += index;
+  int count = Firebase.errorQueueCount(fbdo);
+  Firebase.setInt(fbdo, path.c_str(), index);
+  return Firebase.errorQueueCount(fbdo) == count + 1;
+}
+
+bool testCapacity()
+{
+  bool ok = true;
+
+  Firebase.setMaxErrorQueue(fbdo, QUEUE_CAPACITY);
+  Firebase.setErrorQueuePriority(fbdo, firebase_queue_priority_bulk);
+
+  unsigned long us = micros();
+  for (int i = 0; i < QUEUE_CAPACITY; i++)
+  {
+    ok &= addQueue("queue_capacity", i);
+    queueID[i] = Firebase.getErrorQueueID(fbdo);
+  }
+  unsigned long add_us = micros() - us;
+
+  ok &= Firebase.errorQueueCount(fbdo) == QUEUE_CAPACITY && Firebase.isErrorQueueFull(fbdo);
+
+  // The queues are full.
+  ok &= !addQueue("queue_capacity", QUEUE_CAPACITY);
+
+  us = micros();
+  for (int i = 0; i < QUEUE_CAPACITY; i++)
+    ok &= Firebase.isErrorQueueExisted(fbdo, queueID[i]);
+  unsigned long lookup_us = micros() - us;
+
+  Serial.printf("Capacity: %d queues, add %.2f us (includes the request preparation), lookup %.2f us per queue\n",
+                Firebase.errorQueueCount(fbdo), (float)add_us / QUEUE_CAPACITY, (float)lookup_us / QUEUE_CAPACITY);
+
+  Firebase.clearErrorQueue(fbdo);
+
+  ok &= Firebase.errorQueueCount(fbdo) == 0 && !Firebase.isErrorQueueExisted(fbdo, queueID[0]);
+
+  Serial.printf("Capacity test %s\n\n", ok ? "PASSED" : "FAILED");
+
+  return ok;
+}
+
+bool testPriority()
+{
+  bool ok = true;
+
+  for (int i = 0; i < PRIORITY_QUEUES; i++)
+  {
+    Firebase.setErrorQueuePriority(fbdo, priorityOf(i));
+    ok &= addQueue("queue_priority", i);
+  }
+
+  Firebase.setErrorQueuePriority(fbdo, firebase_queue_priority_normal);
+
+#if defined(ARDUINO_RASPBERRY_PI_PICO_W)
+  multi.addAP(WIFI_SSID, WIFI_PASSWORD);
+  multi.run();
+#else
+  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+#endif
+
+  Serial.print("Connecting to Wi-Fi");
+  while (WiFi.status() != WL_CONNECTED)
+  {
+    Serial.print(".");
+    delay(300);
+  }
+  Serial.println();
+
+  while (!Firebase.ready())
+    delay(100);
+
+  unsigned long ms = millis();
+  Firebase.processErrorQueue(fbdo, callback);
+  ms = millis() - ms;
+
+  // The failed queues stay in the queues.
+  int remaining = Firebase.errorQueueCount(fbdo);
+  Serial.printf("Processed %d queues in %lu ms, %d queues remaining\n", processedCount, ms, remaining);
+
+  ok &= remaining == 0 && processedCount == PRIORITY_QUEUES;
+
+  // The expected order, from the highest class and in the order that was added in each class.
+  int n = 0;
+  for (int p = FIREBASE_QUEUE_PRIORITY_CLASSES - 1; p >= 0; p--)
+  {
+    for (int i = 0; i < PRIORITY_QUEUES; i++)
+    {
+      if (priorityOf(i) != p)
+        continue;
+
+      if (n >= processedCount || processed[n] != i)
+        ok = false;
+
+      Serial.printf("%d%s", n < processedCount ? processed[n] : -1, n < PRIORITY_QUEUES - 1 ? ", " : "\n");
+      n++;
+    }
+  }
+
+  Serial.printf("Priority test %s\n\n", ok ? "PASSED" : "FAILED");
+
+  return ok;
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  WiFi.mode(WIFI_OFF);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+
+  config.database_url = DATABASE_URL;
+  config.signer.tokens.legacy_token = DATABASE_SECRET;
+
+#if defined(ARDUINO_RASPBERRY_PI_PICO_W)
+  config.wifi.clearAP();
+  config.wifi.addAP(WIFI_SSID, WIFI_PASSWORD);
+#endif
+
+  // The network is not reconnected while the WiFi is off.
+  Firebase.reconnectNetwork(false);
+
+  Firebase.begin(&config, &auth);
+
+  bool ok = testCapacity();
+  ok &= testPriority();
+
+  Serial.printf("Error queue test %s\n", ok ? "PASSED" : "FAILED");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,172 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example tests the conformance and the speed of the float and double formatting and parsing.
+ *
+ * The JSON number of the random double should be read back to the same double, the parsing should be
+ * the same as strtod and the fixed precision formatting (setFloatDigits and setDoubleDigits) should be
+ * the same as sprintf "%.<precision>f" with the trailing zeros trimmed.
+ *
+ * The time of number printing and parsing is printed and compared with sprintf and strtod.
+ * No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the number of random values to test */
+#define VALUE_COUNT 2000
+
+const double special_values[] = {0, 0.1, 0.3, 1e-5, 25.5, -273.15, 1.0 / 3, 123456789012345678.0, 1e21, 1e300, 5e-324, 1.7976931348623157e308};
+
+double randomDouble()
+{
+  // The random 62 bits significand and decimal exponent from -20 to 20
+  double d = random(0x7fffffff) / 2147483648.0 + random(0x7fffffff) / 4611686018427387904.0;
+  d *= pow(10, random(-20, 21));
+  return random(2) ? -d : d;
+}
+
+// The number printing of MB_JSON, the caller should free the result by MB_JSON_free.
+char *printNumber(double d)
+{
+  MB_JSON *item = MB_JSON_CreateNumber(d);
+  char *s = MB_JSON_PrintUnformatted(item);
+  MB_JSON_Delete(item);
+  return s;
+}
+
+// The shortest number printing with sprintf i.e. "%1.15g" which is checked by reading back or "%1.17g"
+void sprintfNumber(char *buf, double d)
+{
+  sprintf(buf, "%1.15g", d);
+  if (strtod(buf, nullptr) != d)
+    sprintf(buf, "%1.17g", d);
+}
+
+bool checkValue(double d, char *buf)
+{
+  bool ok = true;
+
+  char *s = printNumber(d);
+  if (!s)
+    return false;
+
+  char *end = nullptr;
+  double v = MB_JSON_StrToDouble(s, &end);
+  ok &= v == d && *end == 0;
+  ok &= v == strtod(s, nullptr);
+
+  if (!ok)
+    Serial.printf("Printed %s, read back %.17g, expected %.17g\n", s, v, d);
+
+  MB_JSON_free(s);
+
+  // The fixed precision formatting of small magnitude values
+  if (fabs(d) < 1e9)
+  {
+    int precision = random(10);
+    MB_String str;
+    str.appendNum(d, precision);
+    sprintf(buf, "%.*f", precision, d);
+    // The formatted number is trimmed, only the trailing zeros and decimal point of sprintf result can be removed.
+    size_t len = str.length();
+    bool same = len > 0 && strncmp(str.c_str(), buf, len) == 0 && str[len - 1] != '.';
+    for (size_t j = len; same && buf[j]; j++)
+      same = buf[j] == '0' || buf[j] == '.';
+    if (!same)
+    {
+      Serial.printf("Fixed %s, expected %s\n", str.c_str(), buf);
+      ok = false;
+    }
+  }
+
+  return ok;
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+
+  randomSeed(micros());
+
+  char buf[64];
+  int failed = 0;
+
+  for (size_t i = 0; i < sizeof(special_values) / sizeof(special_values[0]); i++)
+  {
+    if (!checkValue(special_values[i], buf) || !checkValue(-special_values[i], buf))
+      failed++;
+  }
+
+  for (int i = 0; i < VALUE_COUNT; i++)
+  {
+    if (!checkValue(randomDouble(), buf))
+      failed++;
+
+    if (i % 100 == 0)
+      delay(0);
+  }
+
+  Serial.printf("Conformance: %d values, %d failed\n", VALUE_COUNT + 2 * (int)(sizeof(special_values) / sizeof(special_values[0])), failed);
+
+  // Speed of the sensor like values
+  double *values = new double[100];
+  for (int i = 0; i < 100; i++)
+    values[i] = random(-40000, 80000) / 1000.0;
+
+  unsigned long us = micros();
+  for (int i = 0; i < 100; i++)
+    sprintfNumber(buf, values[i]);
+  unsigned long sprintf_us = micros() - us;
+
+  us = micros();
+  for (int i = 0; i < 100; i++)
+  {
+    char *s = printNumber(values[i]);
+    MB_JSON_free(s);
+  }
+  unsigned long print_us = micros() - us;
+
+  us = micros();
+  for (int i = 0; i < 100; i++)
+  {
+    sprintf(buf, "%.3f", values[i]);
+    values[i] = strtod(buf, nullptr);
+  }
+  unsigned long strtod_us = micros() - us;
+
+  us = micros();
+  for (int i = 0; i < 100; i++)
+  {
+    sprintf(buf, "%.3f", values[i]);
+    values[i] = MB_JSON_StrToDouble(buf, nullptr);
+  }
+  unsigned long parse_us = micros() - us;
+
+  delete[] values;
+
+  Serial.printf("Print: sprintf %.2f us, MB_JSON %.2f us per number (MB_JSON includes the item allocation)\n",
+                sprintf_us / 100.0, print_us / 100.0);
+  Serial.printf("Parse: sprintf and strtod %.2f us, sprintf and MB_JSON_StrToDouble %.2f us per number\n",
+                strtod_us / 100.0, parse_us / 100.0);
+
+  Serial.printf("Float formatting test %s\n", failed == 0 ? "PASSED" : "FAILED");
+}
+
+void loop()
+{
+}
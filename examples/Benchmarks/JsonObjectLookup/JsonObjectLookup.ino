@@ -0,0 +1,110 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example benchmarks the member lookup of the wide JSON objects e.g. the shallow data and push keys.
+ *
+ * The object member lookup of MB_JSON uses the hash index of the object that has MB_JSON_INDEX_THRESHOLD
+ * or more members. The average lookup time of objects of 10, 100 and 1000 members is printed and compared
+ * with walking the member list.
+ *
+ * The test fails when the member found by lookup is not the same as the member found by walking the list.
+ * No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the number of lookups of all members */
+#define LOOKUP_ROUNDS 10
+
+const int member_counts[] = {10, 100, 1000};
+
+// The member lookup by walking the member list
+MB_JSON *walkLookup(MB_JSON *object, const char *key)
+{
+  MB_JSON *item = object->child;
+  while (item && strcmp(item->string, key) != 0)
+    item = item->next;
+  return item;
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+  Serial.printf("Index threshold: %d\n", MB_JSON_INDEX_THRESHOLD);
+
+  int failed = 0;
+  char key[16];
+
+  for (size_t t = 0; t < sizeof(member_counts) / sizeof(member_counts[0]); t++)
+  {
+    int n = member_counts[t];
+
+    MB_JSON *object = MB_JSON_CreateObject();
+    for (int i = 0; i < n; i++)
+    {
+      snprintf(key, sizeof(key), "-Nk%05d", i);
+      MB_JSON_AddNumberToObject(object, key, i);
+    }
+
+    bool ok = true;
+    unsigned long lookups = (unsigned long)n * LOOKUP_ROUNDS;
+
+    unsigned long us = micros();
+    for (int r = 0; r < LOOKUP_ROUNDS; r++)
+    {
+      for (int i = 0; i < n; i++)
+      {
+        snprintf(key, sizeof(key), "-Nk%05d", i);
+        MB_JSON *item = walkLookup(object, key);
+        ok &= item && item->valueint == i;
+      }
+      delay(0);
+    }
+    unsigned long walk_us = micros() - us;
+
+    us = micros();
+    for (int r = 0; r < LOOKUP_ROUNDS; r++)
+    {
+      for (int i = 0; i < n; i++)
+      {
+        snprintf(key, sizeof(key), "-Nk%05d", i);
+        MB_JSON *item = MB_JSON_GetObjectItemCaseSensitive(object, key);
+        ok &= item && item->valueint == i;
+      }
+      delay(0);
+    }
+    unsigned long lookup_us = micros() - us;
+
+    // The case insensitive lookup and the key that is not existed
+    ok &= MB_JSON_GetObjectItem(object, "-nK00000") == object->child;
+    ok &= MB_JSON_GetObjectItemCaseSensitive(object, "-Nk99999") == nullptr;
+
+    MB_JSON_Delete(object);
+
+    if (!ok)
+      failed++;
+
+    Serial.printf("%d members, list walk: %.3f us, lookup: %.3f us per lookup, %s\n", n,
+                  (float)walk_us / lookups, (float)lookup_us / lookups, ok ? "PASSED" : "FAILED");
+  }
+
+  Serial.printf("JSON object lookup test %s\n", failed == 0 ? "PASSED" : "FAILED");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,204 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example tests the streaming JSON reader which is used by Firebase.getJSON with FirebaseJsonReader.
+ *
+ * The generated JSON text of ITEM_COUNT items is fed to the reader in chunks of different sizes as the response
+ * chunks arrive from server, the events of every chunk size should be the same as the events of the whole text.
+ *
+ * The time and the memory used by the reader are printed and compared with parsing the whole text into FirebaseJson.
+ * No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the number of items in JSON text */
+#define ITEM_COUNT 100
+
+/* 2. Define the chunk sizes to test, 0 for the whole text */
+const int chunk_sizes[] = {0, 1, 7, 64, 512};
+
+/* 3. Define the strict parsing cases, the JSON text and the path and value of its last event, NULL for invalid text */
+struct strict_case_t
+{
+  const char *text;
+  const char *path;
+  const char *value;
+};
+
+const strict_case_t strict_cases[] = {
+    {"{\"a/b\":{\"c\\\\d\":1}}", "/a\\/b/c\\\\d", "1"},
+    {"\"\\ud83d\\ude00\"", "/", "\xF0\x9F\x98\x80"},
+    {"\"\\ud83d-\"", "/", "\xEF\xBF\xBD-"},
+    {"\"\\ude00\\ud83d\"", "/", "\xEF\xBF\xBD\xEF\xBF\xBD"},
+    {"[-0.5e+3,0]", "/[1]", "0"},
+    {"[01]", NULL, NULL},
+    {"[1.]", NULL, NULL},
+    {"[-]", NULL, NULL}};
+
+FirebaseJsonReader reader;
+MB_String text;
+
+uint32_t hash = 0;
+unsigned long events = 0;
+long id_sum = 0;
+uint32_t min_heap = 0;
+MB_String last_path, last_value;
+
+uint32_t freeHeap()
+{
+#if defined(ESP8266) || defined(ESP32)
+  return ESP.getFreeHeap();
+#elif defined(ARDUINO_RASPBERRY_PI_PICO_W)
+  return rp2040.getFreeHeap();
+#else
+  return 0;
+#endif
+}
+
+// FNV-1a
+void hashBytes(const char *p, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= (uint8_t)p[i];
+    hash *= 16777619UL;
+  }
+}
+
+void readerCallback(FirebaseJsonReaderEvent event)
+{
+  // The string larger than the value buffer is reported in parts, only its value is hashed per part.
+  if (!event.partial)
+  {
+    hashBytes(event.path, strlen(event.path));
+    hashBytes((const char *)&event.type, sizeof(event.type));
+    events++;
+  }
+
+  hashBytes(event.value, event.length);
+
+  last_path = event.path;
+  last_value = event.value;
+
+  const char *key = strrchr(event.path, '/');
+  if (event.type == FirebaseJson::JSON_INT && key && strcmp(key, "/id") == 0)
+    id_sum += atol(event.value);
+
+  uint32_t heap = freeHeap();
+  if (heap < min_heap)
+    min_heap = heap;
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+
+  // The object of items e.g. {"items":{"k0":{"id":0,"name":"item \"0\"","temp":25.5,"on":true,"tags":[1,2]},...}}
+  text = "{\"items\":{";
+  for (int i = 0; i < ITEM_COUNT; i++)
+  {
+    if (i > 0)
+      text += ",";
+    text += "\"k";
+    text += i;
+    text += "\":{\"id\":";
+    text += i;
+    text += ",\"name\":\"item \\\"";
+    text += i;
+    text += "\\\"\",\"temp\":";
+    text += 20 + i % 10;
+    text += ".5,\"on\":";
+    text += i % 2 ? "true" : "false";
+    text += ",\"tags\":[1,2,null]}";
+  }
+  text += "}}";
+
+  Serial.printf("JSON text: %d bytes\n", (int)text.length());
+
+  uint32_t expected_hash = 0;
+  unsigned long expected_events = 0;
+  int failed = 0;
+
+  for (size_t t = 0; t < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); t++)
+  {
+    size_t chunk = chunk_sizes[t] > 0 ? chunk_sizes[t] : text.length();
+
+    hash = 2166136261UL;
+    events = 0;
+    id_sum = 0;
+
+    uint32_t heap = freeHeap();
+    min_heap = heap;
+    unsigned long us = micros();
+
+    reader.begin(readerCallback);
+    bool ok = true;
+    for (size_t i = 0; i < text.length() && ok; i += chunk)
+      ok = reader.parse(text.c_str() + i, i + chunk < text.length() ? chunk : text.length() - i);
+    ok = reader.end() && ok;
+
+    us = micros() - us;
+
+    if (t == 0)
+    {
+      expected_hash = hash;
+      expected_events = events;
+    }
+
+    ok = ok && hash == expected_hash && events == expected_events && id_sum == (long)ITEM_COUNT * (ITEM_COUNT - 1) / 2;
+    if (!ok)
+      failed++;
+
+    Serial.printf("Chunk size %d, events: %lu, time: %lu us, memory: %u bytes, %s\n", (int)chunk, events, us,
+                  heap - min_heap, ok ? "PASSED" : "FAILED");
+
+    delay(0);
+  }
+
+  uint32_t heap = freeHeap();
+  unsigned long us = micros();
+  FirebaseJson *json = new FirebaseJson();
+  json->setJsonData(text.c_str());
+  FirebaseJsonData result;
+  json->get(result, "items/k0/id");
+  us = micros() - us;
+  Serial.printf("FirebaseJson, time: %lu us, memory: %u bytes\n", us, heap - freeHeap());
+  delete json;
+
+  for (size_t t = 0; t < sizeof(strict_cases) / sizeof(strict_cases[0]); t++)
+  {
+    const strict_case_t &c = strict_cases[t];
+    last_path.clear();
+    last_value.clear();
+
+    reader.begin(readerCallback);
+    bool valid = reader.parse(c.text) && reader.end();
+
+    bool ok = c.path ? valid && strcmp(last_path.c_str(), c.path) == 0 && strcmp(last_value.c_str(), c.value) == 0 : !valid;
+    if (!ok)
+      failed++;
+
+    Serial.printf("Strict case %s, %s\n", c.text, ok ? "PASSED" : "FAILED");
+  }
+
+  Serial.printf("JSON reader test %s\n", failed == 0 ? "PASSED" : "FAILED");
+}
+
+void loop()
+{
+}
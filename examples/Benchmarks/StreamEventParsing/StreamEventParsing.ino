@@ -0,0 +1,112 @@
+/**
+ * Created by K. Suwatchai (Mobizt)
+ *
+ * Email: k_suwatchai@hotmail.com
+ *
+ * Github: https://github.com/mobizt/Firebase-ESP8266
+ *
+ * Copyright (c) 2023 mobizt
+ *
+ */
+
+/** This example benchmarks the stream event parsing by replaying the captured RTDB stream traffic.
+ *
+ * The events of the captured stream payload are located and parsed in place in the receive buffer,
+ * the event type, path and data are the offsets and lengths in the buffer without copy.
+ *
+ * The average parsing time per event and the free heap before and after the replay are printed.
+ * No network connection is required.
+ */
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <FirebaseESP8266.h>
+
+/* 1. Define the number of times to replay the captured traffic */
+#define REPLAY_ROUNDS 1000
+
+/* 2. The captured stream payload that contains multiple events (bursty stream) */
+const char CAPTURED_STREAM[] PROGMEM = "event: put\n"
+                                       "data: {\"path\":\"/\",\"data\":{\"sensor\":{\"temp\":25.5,\"humid\":60},\"led\":true,\"name\":\"node \\\"1\\\"\"}}\n\n"
+                                       "event: patch\n"
+                                       "data: {\"path\":\"/sensor\",\"data\":{\"temp\":25.6}}\n\n"
+                                       "event: put\n"
+                                       "data: {\"path\":\"/led\",\"data\":false}\n\n"
+                                       "event: put\n"
+                                       "data: {\"path\":\"/counter\",\"data\":12345}\n\n"
+                                       "event: put\n"
+                                       "data: {\"path\":\"/name\",\"data\":\"node 2\"}\n\n"
+                                       "event: put\n"
+                                       "data: {\"path\":\"/sensor/humid\",\"data\":null}\n\n"
+                                       "event: keep-alive\n"
+                                       "data: null\n\n";
+
+// The helpers that the library uses to locate and parse the stream events
+StringHelper sh;
+HttpHelper hh;
+
+uint32_t freeHeap()
+{
+#if defined(ESP8266) || defined(ESP32)
+  return ESP.getFreeHeap();
+#elif defined(ARDUINO_RASPBERRY_PI_PICO_W)
+  return rp2040.getFreeHeap();
+#else
+  return 0;
+#endif
+}
+
+void setup()
+{
+
+  Serial.begin(115200);
+  delay(1000);
+
+  Serial.printf("Firebase Client v%s\n\n", FIREBASE_CLIENT_VERSION);
+
+  // The receive buffer
+  MB_String payload = CAPTURED_STREAM;
+  const char *buf = payload.c_str();
+  int len = payload.length();
+
+  unsigned long events = 0, bytes = 0;
+  uint32_t heapBefore = freeHeap();
+  unsigned long us = micros();
+
+  for (int i = 0; i < REPLAY_ROUNDS; i++)
+  {
+    int ofs = 0, begin = 0, end = 0;
+    while (hh.nextStreamEvent(&sh, buf, len, ofs, begin, end))
+    {
+      struct server_response_data_t response;
+      hh.parseStreamEvent(&sh, buf, begin, end, response);
+      bytes += response.eventType.len + response.eventPath.len + response.eventData.len;
+      events++;
+    }
+
+    if (i % 100 == 0)
+      delay(0);
+  }
+
+  us = micros() - us;
+  uint32_t heapAfter = freeHeap();
+
+  Serial.printf("Events: %lu, parsed bytes: %lu\n", events, bytes);
+  Serial.printf("Time: %lu us, %.2f us/event\n", us, (float)us / events);
+  Serial.printf("Free heap before: %u, after: %u\n", heapBefore, heapAfter);
+  Serial.println(heapBefore == heapAfter ? "PASSED" : "FAILED, the heap was changed");
+
+  // Print the parts of each event
+  int ofs = 0, begin = 0, end = 0;
+  while (hh.nextStreamEvent(&sh, buf, len, ofs, begin, end))
+  {
+    struct server_response_data_t response;
+    hh.parseStreamEvent(&sh, buf, begin, end, response);
+    Serial.printf("type: %.*s, path: %.*s, data: %.*s\n", response.eventType.len, buf + response.eventType.ofs,
+                  response.eventPath.len, buf + response.eventPath.ofs, response.eventData.len, buf + response.eventData.ofs);
+  }
+}
+
+void loop()
+{
+}
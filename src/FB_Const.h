@@ -49,6 +49,7 @@
 
 // FirebaseJson was already included in MB_FS.h
 #include "./mbfs/MB_FS.h"
+#include "./json/FirebaseJsonReader.h"
 
 #if (defined(ENABLE_OTA_FIRMWARE_UPDATE) || defined(FIREBASE_ENABLE_OTA_FIRMWARE_UPDATE)) && (defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB) || (defined(ENABLE_FB_STORAGE) || defined(FIREBASE_ENABLE_FB_STORAGE)) || defined(ENABLE_GC_STORAGE))
 #if defined(ESP32)
@@ -101,6 +102,8 @@
 
 #define MIN_TOKEN_GENERATION_ERROR_INTERVAL 5 * 1000
 
+#define DEFAULT_TOKEN_SIGNING_SLICE 10
+
 #define MIN_NTP_SERVER_SYNC_TIME_OUT 15 * 1000
 
 #define FB_TIME_SYNC_INTERVAL 1500
@@ -109,11 +112,38 @@
 
 #define DEFAULT_AUTH_TOKEN_EXPIRED_SECONDS 3600
 
+#define DEFAULT_TOKEN_REFRESH_LEAD_SECONDS 10 * 60
+
+#define DEFAULT_TOKEN_REFRESH_JITTER_SECONDS 5 * 60
+
 #define DEFAULT_REQUEST_TIMEOUT 2000
 
 // The TCP session will be closed when time out reached
 #define DEFAULT_TCP_CONNECTION_TIMEOUT 3 * 60 * 1000
 
+// The idle connection in the shared connection pool will be closed when time out reached
+#define DEFAULT_CONNECTION_POOL_IDLE_TIMEOUT 60 * 1000
+#define DEFAULT_CONNECTION_POOL_SIZE 2
+#define MAX_CONNECTION_POOL_SIZE 4
+
+// The cached TLS session will not be offered to server after this period in seconds since it was saved
+#define DEFAULT_TLS_SESSION_CACHE_TTL 24 * 60 * 60
+#define MAX_TLS_SESSION_CACHE_SIZE 4
+
+// The SSL I/O buffer sizes of adaptive buffer sizing for the host that supports the maximum fragment length negotiation
+#define ADAPTIVE_BSSL_STREAM_RX_SIZE 1024
+#define ADAPTIVE_BSSL_REQUEST_RX_SIZE 2048
+#define ADAPTIVE_BSSL_TRANSFER_SIZE 4096
+#define ADAPTIVE_BSSL_TX_SIZE 512
+// The receive buffer size for download from the host that does not support the maximum fragment length negotiation
+#define ADAPTIVE_BSSL_MAX_RX_SIZE 16384
+#define MAX_MFLN_CACHE_SIZE 4
+// The host that does not support the negotiation will be learned again from the next handshake after this period in ms
+#define MFLN_PROBE_RETRY_INTERVAL 10 * 60 * 1000
+
+// The size of receive buffer that the TCP client reads the server response into in block
+#define DEFAULT_TCP_READ_BUFFER_SIZE 256
+
 #define SD_CS_PIN 15
 
 #define STREAM_TASK_STACK_SIZE 8192
@@ -135,6 +165,7 @@
 #define _IS_ASYNC true
 #define _NO_ASYNC false
 #define _NO_QUEUE false
+#define _IS_QUEUE true
 
 #include "FB_Error.h"
 
@@ -743,6 +774,13 @@ struct firebase_auth_token_error_t
     int code = 0;
 };
 
+// The part of response payload buffer that was parsed in place (without copy).
+struct firebase_payload_view_t
+{
+    int ofs = 0;
+    int len = 0;
+};
+
 struct server_response_data_t
 {
     int httpCode = 0;
@@ -771,18 +809,35 @@ struct server_response_data_t
     MB_String location;
     MB_String contentType;
     MB_String connection;
-    MB_String eventPath;
-    MB_String eventType;
-    MB_String eventData;
+    // The stream event parts in the payload buffer.
+    firebase_payload_view_t eventPath;
+    firebase_payload_view_t eventType;
+    firebase_payload_view_t eventData;
     MB_String etag;
     MB_String pushName;
     MB_String fbError;
     MB_String transferEnc;
 };
 
+enum firebase_chunk_state
+{
+    // reading the hex digits of chunk size
+    firebase_chunk_state_size,
+    // reading the chunk extension until the end of chunk size line
+    firebase_chunk_state_ext,
+    // reading the chunk data
+    firebase_chunk_state_data,
+    // reading the CRLF after chunk data
+    firebase_chunk_state_data_end,
+    // reading the trailer lines after the last (zero size) chunk
+    firebase_chunk_state_trailer,
+    // the last chunk and trailer were read
+    firebase_chunk_state_complete
+};
+
 struct firebase_chunk_state_info
 {
-    int state = 0;
+    int state = firebase_chunk_state_size;
     int chunkedSize = 0;
     int dataLen = 0;
 };
@@ -889,6 +944,91 @@ typedef struct firebase_rtdb_download_status_info_t
 typedef void (*RTDB_UploadProgressCallback)(RTDB_UploadStatusInfo);
 typedef void (*RTDB_DownloadProgressCallback)(RTDB_DownloadStatusInfo);
 
+typedef struct firebase_rtdb_async_result_info_t
+{
+    // The sequence number of pipelined async request of Firebase Data object, starts from 1.
+    uint32_t id = 0;
+    MB_String path;
+    // The http status code or the negative error code when response could not be read.
+    int httpCode = 0;
+    MB_String payload;
+    // The payload was larger than the response buffer size (see setResponseSize) and only its beginning was kept.
+    bool truncated = false;
+
+} RTDB_AsyncResultInfo;
+
+typedef void (*RTDB_AsyncResultCallback)(RTDB_AsyncResultInfo);
+
+enum firebase_rtdb_async_read_state
+{
+    firebase_rtdb_async_read_status,
+    firebase_rtdb_async_read_header,
+    firebase_rtdb_async_read_content,
+    firebase_rtdb_async_read_chunk_size,
+    firebase_rtdb_async_read_chunk_data,
+    firebase_rtdb_async_read_chunk_end,
+    firebase_rtdb_async_read_trailer
+};
+
+struct firebase_rtdb_async_request_t
+{
+    uint32_t id = 0;
+    MB_String path;
+};
+
+typedef struct firebase_rtdb_batch_info_t
+{
+    // The number of writes that were added to batch.
+    uint32_t writes = 0;
+    // The number of writes that replaced the pending writes of the same or child paths.
+    uint32_t deduplicated = 0;
+    // The number of multi-path update requests that were sent.
+    uint32_t commits = 0;
+    // The number of multi-path update requests that were failed.
+    uint32_t failures = 0;
+    // The number of requests that were saved by batching.
+    uint32_t saved = 0;
+    // The number of writes that currently kept in batch.
+    uint16_t pending = 0;
+
+} RTDB_BatchInfo;
+
+struct firebase_rtdb_batch_item_t
+{
+    // The path relative to the batch path
+    MB_String path;
+    // The JSON value
+    MB_String value;
+};
+
+struct firebase_rtdb_batch_t
+{
+    bool active = false;
+    bool committing = false;
+    // The last commit was failed and its writes are still kept in batch.
+    bool failed = false;
+    MB_String path;
+    MB_VECTOR<struct firebase_rtdb_batch_item_t> items;
+    size_t payload_size = 0;
+    unsigned long begin_ms = 0;
+    RTDB_BatchInfo info;
+};
+
+// The state of the response reader of pipelined async requests which the response
+// can be read partially from many calls.
+struct firebase_rtdb_async_reader_t
+{
+    firebase_rtdb_async_read_state state = firebase_rtdb_async_read_status;
+    int http_code = 0;
+    int remaining = 0;
+    bool close = false;
+    bool truncated = false;
+    unsigned long data_ms = 0;
+    MB_String line;
+    MB_String header;
+    MB_String payload;
+};
+
 struct firebase_rtdb_request_info_t
 {
     MB_String path;
@@ -901,6 +1041,8 @@ struct firebase_rtdb_request_info_t
     firebase_rtdb_task_type task_type = firebase_rtdb_task_undefined;
     bool queue = false;
     bool async = false;
+    // The payload in memory was sent with the request header.
+    bool payload_sent = false;
     size_t fileSize = 0;
 #if defined(FIREBASE_ESP_CLIENT)
     firebase_mem_storage_type storageType = mem_storage_type_undefined;
@@ -978,6 +1120,14 @@ struct firebase_auth_cert_t
     firebase_mem_storage_type file_storage = mem_storage_type_flash;
 #else
     uint8_t file_storage = StorageType::UNDEFINED;
+#endif
+    // The file that keeps the decoded (DER) certificates of PEM certificate data e.g. "/ca.der",
+    // the DER certificates will be loaded instead of decoding the PEM data after reboot.
+    MB_String der_file;
+#if defined(FIREBASE_ESP_CLIENT)
+    firebase_mem_storage_type der_file_storage = mem_storage_type_flash;
+#else
+    uint8_t der_file_storage = StorageType::FLASH;
 #endif
 };
 
@@ -1060,6 +1210,19 @@ struct firebase_stream_info_t
     size_t max_payload_length = 0;
     int httpCode = 0;
 };
+
+// The node of multiple paths stream child path index (path segments tree),
+// node 0 is the parent (stream) path.
+struct firebase_mp_stream_path_node_t
+{
+    // The path segment (node name).
+    MB_String key;
+    // The full child path of the node with assigned callback.
+    MB_String path;
+    int first_child = -1;
+    int next_sibling = -1;
+    int callback_index = -1;
+};
 #endif
 
 struct firebase_session_info
@@ -1142,11 +1305,41 @@ struct firebase_cfg_int_t
 #endif
 };
 
+struct firebase_rtdb_batch_config_t
+{
+    // The maximum number of writes in batch before commit, 0 for no limit.
+    uint16_t max_writes = 32;
+    // The maximum payload size in bytes of batch before commit, 0 for no limit.
+    size_t max_payload_size = 2048;
+    // The maximum time in ms to keep the first write in batch before commit, 0 for no limit.
+    // This time is checked only by the next batch write and Firebase.ready(), the idle batch
+    // is never committed on time unless Firebase.ready() was polled in the loop.
+    // The failed commit is retried when this time was reached again.
+    unsigned long max_delay_ms = 1000;
+};
+
 struct firebase_rtdb_config_t
 {
     bool data_type_stricted = false;
     size_t upload_buffer_size = 128;
 
+    // The maximum number of async requests that can be sent on the same keep-alive connection
+    // before their responses were read (HTTP/1.1 pipelining).
+    // The async request fails with FIREBASE_ERROR_ASYNC_PIPELINE_FULL when the pipeline is full.
+    // The responses are read in order and passed to the callback that set via setAsyncCallback
+    // from Firebase.ready() or readAsyncResponses.
+    // Set to 0 to ignore the responses of async requests.
+    uint8_t async_pipeline_depth = 0;
+
+    // The limits of write batch that began by beginBatch.
+    struct firebase_rtdb_batch_config_t batch;
+
+    // The size of arena memory in bytes that the transient buffers of each request will be allocated from
+    // and released at once when the request completed, to prevent the heap fragmentation.
+    // The size should be larger than the response chunk size (fbdo.setResponseSize), e.g. 2048.
+    // Set to 0 to allocate from heap.
+    size_t request_arena_size = 0;
+
     // unused, call fbdo.setResponseSize instead
     // size_t download_buffer_size = 256;
 };
@@ -1323,10 +1516,166 @@ struct firebase_client_timeout_t
 
     uint16_t tokenGenerationError = MIN_TOKEN_GENERATION_ERROR_INTERVAL;
 
+    // The maximum time in ms of each JWT token RSA signing slice per Firebase.ready() call (0 for signing at once).
+    uint16_t tokenSigningSlice = DEFAULT_TOKEN_SIGNING_SLICE;
+
     // NTP server sync timeout in ms
     uint16_t ntpServerRequest = MIN_NTP_SERVER_SYNC_TIME_OUT;
 };
 
+struct firebase_connection_pool_config_t
+{
+    // Share the idle kept-alive server connections between Firebase Data objects (non-stream RTDB, FCM and token requests).
+    bool enable = false;
+
+    // The maximum number of idle connections to keep in pool (1 - 4).
+    uint8_t max_connections = DEFAULT_CONNECTION_POOL_SIZE;
+
+    // Idle connection timeout in ms before the pooled connection will be closed.
+    // The idle connections are only closed when Firebase.ready() was called or the connection
+    // was taken from or returned to the pool, Firebase.ready() should be polled in the loop.
+    unsigned long idle_timeout = DEFAULT_CONNECTION_POOL_IDLE_TIMEOUT;
+};
+
+typedef struct firebase_connection_pool_info_t
+{
+    // The number of requests that reused the pooled connection (no new SSL handshake).
+    uint32_t hits = 0;
+    // The number of requests that found no pooled connection for its host.
+    uint32_t misses = 0;
+    // The number of pooled connections that were closed by idle time out, disconnection or size limit.
+    uint32_t evictions = 0;
+    // The number of connections that currently kept in pool.
+    uint8_t size = 0;
+} ConnectionPoolInfo;
+
+struct firebase_tls_session_cache_config_t
+{
+    // The file that keeps the TLS session (session ID and master secret) of each host across reboots e.g. "/tls_sessions.bin".
+    // The session cache is disabled when no file name assigned.
+    // The master secret is written to file in plaintext, anyone who can read the flash or SD card can decrypt
+    // the captured traffic of the cached sessions, use it only when the storage is trusted.
+    // The file is rewritten after every full SSL handshake, which adds the flash wear when the connections
+    // are frequently closed and opened without session resumption.
+    MB_String filename;
+
+    // The storage type of file.
+#if defined(FIREBASE_ESP_CLIENT)
+    firebase_mem_storage_type storage_type = mem_storage_type_flash;
+#else
+    uint8_t storage_type = StorageType::FLASH;
+#endif
+
+    // The time in seconds since the session was saved that it will not be resumed, 0 for no expiry.
+    // The expiry can only be checked when the device time was set.
+    uint32_t ttl = DEFAULT_TLS_SESSION_CACHE_TTL;
+};
+
+typedef struct firebase_tls_session_cache_info_t
+{
+    // The number of SSL handshakes that the server resumed the offered session (abbreviated handshake).
+    uint32_t resumed = 0;
+    // The number of full SSL handshakes.
+    uint32_t full = 0;
+    // The number of cached sessions that were restored to the client which has no session.
+    uint32_t restored = 0;
+    // The number of cached sessions that were removed by expiry.
+    uint32_t expired = 0;
+    // The number of times the cache file was written.
+    uint32_t saves = 0;
+    // The number of sessions that currently kept in cache.
+    uint8_t size = 0;
+} TLSSessionCacheInfo;
+
+typedef enum
+{
+    // The normal request.
+    firebase_bssl_buffer_profile_request,
+    // The stream.
+    firebase_bssl_buffer_profile_stream,
+    // The file, backup and OTA download.
+    firebase_bssl_buffer_profile_download,
+    // The file and restore upload.
+    firebase_bssl_buffer_profile_upload
+
+} firebase_bssl_buffer_profile;
+
+typedef struct firebase_trust_anchor_store_info_t
+{
+    // The number of times the certificates were decoded from PEM data or certificate file.
+    uint32_t decodes = 0;
+    // The number of times the certificates were loaded from DER file instead of decoding PEM data.
+    uint32_t der_loads = 0;
+    // The number of times the decoded trust anchors were shared instead of decoding.
+    uint32_t hits = 0;
+    // The number of certificate sources that currently kept in store.
+    uint8_t size = 0;
+    // The number of trust anchors that currently kept in store.
+    uint16_t anchors = 0;
+} TrustAnchorStoreInfo;
+
+struct firebase_bssl_buffer_config_t
+{
+    // Size the SSL I/O buffers of each connection to its workload (stream, request, file download or upload)
+    // instead of using the sizes from FirebaseData::setBSSLBufferSize.
+    // The maximum fragment length negotiation support of each host is learned from the handshake of its first connection,
+    // which uses the sizes from FirebaseData::setBSSLBufferSize, the host that does not support it is learned again
+    // after MFLN_PROBE_RETRY_INTERVAL.
+    // The open connection is resized only when its receive buffer can't hold the records of the workload.
+    bool adaptive = false;
+};
+
+typedef struct firebase_request_arena_info_t
+{
+    // The request arena size in bytes.
+    size_t size = 0;
+    // The highest number of arena bytes that were in use.
+    size_t peak = 0;
+    // The number of allocations that were served from arena.
+    uint32_t allocations = 0;
+    // The number of allocations that were served from heap because the arena was full.
+    uint32_t fallbacks = 0;
+    // The number of completed requests that released the arena.
+    uint32_t resets = 0;
+    // The free heap in bytes.
+    uint32_t free_heap = 0;
+    // The largest free heap block in bytes (0 when not supported).
+    uint32_t max_free_block = 0;
+    // The heap fragmentation in percent (0 when not supported).
+    uint8_t heap_fragmentation = 0;
+} RequestArenaInfo;
+
+struct firebase_token_refresh_config_t
+{
+    // Refresh the auth token in background before it expires instead of refreshing after expiry.
+    // The refresh runs while the sessions and streams are still open which requires the memory for one more SSL client.
+    // The current token is still used by requests and streams until the new token was received.
+    bool background = false;
+
+    // The seconds before the token expiry time to start the background refresh.
+    unsigned long lead_seconds = DEFAULT_TOKEN_REFRESH_LEAD_SECONDS;
+
+    // The maximum random seconds that the background refresh starts earlier,
+    // to spread the refresh of devices that were started at the same time.
+    unsigned long jitter_seconds = DEFAULT_TOKEN_REFRESH_JITTER_SECONDS;
+};
+
+typedef struct firebase_token_refresh_info_t
+{
+    // The number of auth tokens that were refreshed in background before expiry.
+    uint32_t background = 0;
+    // The number of background refresh errors (retried until the token expired).
+    uint32_t failures = 0;
+    // The number of times that the requests were blocked waiting for the auth token.
+    uint32_t blocked = 0;
+    // The total time in ms that the requests were blocked waiting for the auth token.
+    unsigned long blocked_ms = 0;
+    // The longest time in ms that the requests were blocked waiting for the auth token.
+    unsigned long max_blocked_ms = 0;
+    // The seconds before the token expiry time of the scheduled background refresh (0 when not scheduled).
+    unsigned long lead_seconds = 0;
+} TokenRefreshInfo;
+
 struct firebase_cfg_t
 {
     struct firebase_service_account_t service_account;
@@ -1361,6 +1710,10 @@ struct firebase_cfg_t
 
     SPI_ETH_Module spi_ethernet_module;
     struct firebase_client_timeout_t timeout;
+    struct firebase_connection_pool_config_t connection_pool;
+    struct firebase_tls_session_cache_config_t tls_session_cache;
+    struct firebase_bssl_buffer_config_t bssl_buffer;
+    struct firebase_token_refresh_config_t token_refresh;
 
 public:
     firebase_cfg_t(){};
@@ -1368,6 +1721,22 @@ public:
 };
 
 #if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
+struct firebase_rtdb_header_cache_t
+{
+    // The ".json" and auth query parameter with token that appended to the request path.
+    MB_String auth_query;
+    // The request line end, Host, User-Agent, custom headers and Authorization (OAuth2.0 access token) headers.
+    MB_String common;
+    // The config and token states that the cache was built from.
+    MB_String host;
+    MB_String custom_headers;
+    firebase_auth_token_type token_type = token_type_undefined;
+    bool test_mode = false;
+    bool auth_param = false;
+    bool has_token = false;
+    size_t token_len = 0;
+};
+
 struct firebase_rtdb_info_t
 {
     bool data_tmo = false;
@@ -1384,6 +1753,15 @@ struct firebase_rtdb_info_t
     bool async = false;
     bool new_stream = false;
     size_t async_count = 0;
+    uint32_t async_id = 0;
+    // The async requests that were sent and wait for their responses (FIFO)
+    MB_VECTOR<struct firebase_rtdb_async_request_t> async_pending;
+    // The results of async requests that were read and wait to be passed to the callback
+    MB_VECTOR<RTDB_AsyncResultInfo> async_results;
+    struct firebase_rtdb_async_reader_t async_reader;
+    struct firebase_rtdb_header_cache_t header_cache;
+    RTDB_AsyncResultCallback async_cb = NULL;
+    struct firebase_rtdb_batch_t batch;
 
     uint8_t connection_status = 0;
     uint32_t queue_ID = 0;
@@ -1428,6 +1806,9 @@ struct firebase_rtdb_info_t
     size_t file_size = 0;
 
     struct firebase_stream_info_t stream;
+    MB_VECTOR<struct firebase_mp_stream_path_node_t> mp_stream_paths;
+    // streaming reader of the current getJSON request, the payload is not buffered when it was set
+    FirebaseJsonReader *json_reader = nullptr;
 
 #if defined(ESP32) || defined(MB_ARDUINO_PICO)
     bool stream_loop_task_enable = false;
@@ -2645,6 +3026,7 @@ static const char firebase_rtdb_err_pgm_str_2[] PROGMEM = "path not exist";
 static const char firebase_rtdb_err_pgm_str_3[] PROGMEM = "data type mismatch";
 static const char firebase_rtdb_err_pgm_str_4[] PROGMEM = "security rules are not a valid JSON";
 static const char firebase_rtdb_err_pgm_str_5[] PROGMEM = "the FirebaseData object was paused";
+static const char firebase_rtdb_err_pgm_str_6[] PROGMEM = "the async pipeline is full";
 
 // FCM error string
 static const char firebase_fcm_err_pgm_str_1[] PROGMEM = "no ID token or registration token provided";
@@ -106,5 +106,6 @@
 #define FIREBASE_ERROR_USER_TIME_SETTING_REQUIRED /*          */ (FB_ERROR_RANGE - 38)
 #define FIREBASE_ERROR_SYS_TIME_IS_NOT_READY /*          */ (FB_ERROR_RANGE - 39)
 #define FIREBASE_ERROR_USER_PAUSE /*          */ (FB_ERROR_RANGE - 40)
+#define FIREBASE_ERROR_ASYNC_PIPELINE_FULL /*          */ (FB_ERROR_RANGE - 41)
 
 #endif
\ No newline at end of file
@@ -49,6 +49,11 @@
 
 using namespace mb_string;
 
+// The Stream peek buffer API is available in ESP8266 Arduino Core v3.x.x
+#if defined(ESP8266) && defined(ARDUINO_ESP8266_MAJOR) && ARDUINO_ESP8266_MAJOR >= 3
+#define FIREBASE_HAS_PEEK_BUFFER_API
+#endif
+
 #define stringPtr2Str(p) (MB_String().appendPtr(p).c_str())
 
 namespace FBUtils
@@ -61,6 +66,30 @@ namespace FBUtils
         delay(0);
 #endif
     }
+
+    // The random number from hardware generator when available.
+    inline uint32_t random32()
+    {
+#if defined(ESP32)
+        return esp_random();
+#elif defined(ESP8266)
+        return RANDOM_REG32;
+#else
+        return (uint32_t)random(0x7fffffff) ^ micros();
+#endif
+    }
+
+    // The Fletcher-16 checksum of data, the checksum of the previous data can be passed to continue.
+    inline uint16_t fletcher16(const uint8_t *buf, size_t len, uint16_t sum = 0)
+    {
+        uint16_t a = sum & 0xff, b = sum >> 8;
+        for (size_t i = 0; i < len; i++)
+        {
+            a = (a + buf[i]) % 255;
+            b = (b + a) % 255;
+        }
+        return (b << 8) | a;
+    }
 };
 
 class StringHelper
@@ -97,6 +126,25 @@ public:
         return -1;
     }
 
+    /* find the PROGMEM token in buffer (length len) from offset without the temporary copy of token */
+    int strposP(const char *buf, int len, PGM_P token, int offset)
+    {
+        int tlen = strlen_P(token);
+
+        if (!buf || tlen == 0 || offset < 0)
+            return -1;
+
+        char c = pgm_read_byte(token);
+
+        for (int i = offset; i + tlen <= len; i++)
+        {
+            if (buf[i] == c && strncmp_P(buf + i, token, tlen) == 0)
+                return i;
+        }
+
+        return -1;
+    }
+
     size_t getReservedLen(MB_FS *mbfs, size_t len)
     {
         return mbfs->getReservedLen(len);
@@ -143,6 +191,26 @@ public:
         return caseInSensitive ? (strcasecmp(pgm2Str(token), copy.c_str()) == 0) : (strcmp(pgm2Str(token), copy.c_str()) == 0);
     }
 
+    /* compare the PROGMEM token with buffer (length len) at offset without the temporary copies */
+    bool compare(const char *buf, int len, int ofs, PGM_P token, bool caseInSensitive = false)
+    {
+        int tlen = strlen_P(token);
+
+        if (!buf || ofs < 0 || ofs + tlen > len)
+            return false;
+
+        if (!caseInSensitive)
+            return strncmp_P(buf + ofs, token, tlen) == 0;
+
+        for (int i = 0; i < tlen; i++)
+        {
+            if (tolower(buf[ofs + i]) != tolower(pgm_read_byte(token + i)))
+                return false;
+        }
+
+        return true;
+    }
+
     /* convert string to boolean */
     bool str2Bool(const MB_String &v)
     {
@@ -783,18 +851,26 @@ public:
     }
 
     void setNumDataType(const MB_String &buf, int ofs, struct server_response_data_t &response, bool dec)
+    {
+        setNumDataType(buf.c_str(), buf.length(), ofs, response, dec);
+    }
+
+    void setNumDataType(const char *buf, int len, int ofs, struct server_response_data_t &response, bool dec)
     {
         if (ofs < 0)
             return;
 
-        int len = (int)buf.length();
-
         if (ofs >= len)
             return;
 
         if (response.payloadLen > 0 && response.payloadLen <= len && ofs < len && ofs + response.payloadLen <= len)
         {
-            double d = atof(buf.substr(ofs, response.payloadLen).c_str());
+            // the number text is copied to the stack buffer for conversion
+            char num[32];
+            int n = response.payloadLen < (int)sizeof(num) ? response.payloadLen : (int)sizeof(num) - 1;
+            memcpy(num, buf + ofs, n);
+            num[n] = 0;
+            double d = atof(num);
 
             if (dec)
             {
@@ -825,51 +901,166 @@ public:
         }
     }
 
-    void parseRespPayload(StringHelper *sh, const MB_String &src, struct server_response_data_t &response, bool getOfs)
+#if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
+
+    /* Get the offsets of next stream event block ("event: ...\ndata: ...") in stream payload buffer (length len),
+    the search begins at ofs and ofs will be advanced to the end of found block */
+    bool nextStreamEvent(StringHelper *sh, const char *buf, int len, int &ofs, int &begin, int &end)
     {
-        int payloadPos = 0;
-        int payloadOfs = 0;
+        begin = sh->strposP(buf, len, firebase_rtdb_pgm_str_12 /* "event: " */, ofs);
 
-        MB_String out;
+        int data = begin > -1 ? sh->strposP(buf, len, firebase_rtdb_pgm_str_13 /* "data: " */, begin + 1) : -1;
 
-#if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
+        if (data < 0)
+        {
+            ofs = len;
+            return false;
+        }
 
-        if (!response.isEvent && !response.noEvent)
+        end = sh->strposP(buf, len, firebase_pgm_str_12 /* "\n" */, data + 1);
+        if (end < 0)
+            end = len;
+
+        ofs = end + 1;
+
+        return true;
+    }
+
+    /* Parse the event type, event path and event data of stream event block (from begin to end of buffer) in one
+    forward pass, the results are the offsets and lengths of parts in the buffer */
+    void parseEventHeader(StringHelper *sh, const char *buf, int begin, int end, struct server_response_data_t &response,
+                          int &payloadPos, int &payloadOfs)
+    {
+        int pos1 = sh->strposP(buf, end, firebase_rtdb_pgm_str_12 /* "event: " */, begin);
+        if (pos1 < 0)
+            return;
+
+        pos1 += strlen_P(firebase_rtdb_pgm_str_12 /* "event: " */);
+        int pos2 = sh->strposP(buf, end, firebase_pgm_str_12 /* "\n" */, pos1 + 1);
+        if (pos2 < 0)
+            pos2 = end;
+
+        response.eventType.ofs = pos1;
+        response.eventType.len = pos2 - pos1;
+        response.isEvent = true;
+        payloadPos = pos2 + 1;
+        payloadOfs = payloadPos;
+
+        if (sh->strposP(buf, end, firebase_rtdb_pgm_str_13 /* "data: " */, payloadPos) < 0)
+            return;
+
+        payloadOfs += strlen_P(firebase_rtdb_pgm_str_13 /* "data: " */);
+        payloadPos = payloadOfs;
+        response.hasEventData = true;
+
+        pos1 = sh->strposP(buf, end, firebase_pgm_str_54 /* "\"path\":\"" */, payloadPos);
+        if (pos1 < 0)
+            return;
+
+        pos1 += strlen_P(firebase_pgm_str_54 /* "\"path\":\"" */);
+        pos2 = sh->strposP(buf, end, firebase_pgm_str_4 /* "\"" */, pos1 + 1);
+        if (pos2 < 0)
+            pos2 = end;
+
+        response.eventPath.ofs = pos1;
+        response.eventPath.len = pos2 - pos1;
+        payloadPos = pos2 + 1;
+        payloadOfs = payloadPos;
+
+        pos1 = sh->strposP(buf, end, firebase_pgm_str_55 /* "\"data\":" */, payloadPos);
+        if (pos1 < 0)
+            return;
+
+        pos1 += strlen_P(firebase_pgm_str_55 /* "\"data\":" */);
+        pos2 = sh->strposP(buf, end, firebase_pgm_str_12 /* "\n" */, pos1 + 1);
+        if (pos2 < 0)
+            pos2 = end;
+
+        // exclude the closing brace of event JSON object
+        response.eventData.ofs = pos1;
+        response.eventData.len = pos2 - pos1 > 1 ? pos2 - pos1 - 1 : 0;
+
+        payloadPos = pos2 + 1;
+        response.payloadLen = response.eventData.len;
+        payloadOfs += strlen_P(firebase_pgm_str_55 /* "\"data\":" */) + 1;
+        response.payloadOfs = payloadOfs;
+    }
+
+    /* Parse the stream event block (from begin to end of buffer) in place, the event parts are the offsets and lengths in the buffer */
+    void parseStreamEvent(StringHelper *sh, const char *buf, int begin, int end, struct server_response_data_t &response)
+    {
+        int payloadPos = begin;
+        int payloadOfs = begin;
+
+        parseEventHeader(sh, buf, begin, end, response, payloadPos, payloadOfs);
+
+        if (end >= payloadOfs)
+            setDataType(sh, buf, end, payloadOfs, response, false);
+    }
+
+    /* Get the data type of payload (length len) at offset */
+    void setDataType(StringHelper *sh, const char *buf, int len, int payloadOfs, struct server_response_data_t &response, bool getOfs)
+    {
+        if (sh->compare(buf, len, payloadOfs, firebase_rtdb_pgm_str_7 /* "\"blob,base64," */, true))
         {
-            if (sh->tokenSubString(src, response.eventType,
-                                   firebase_rtdb_pgm_str_12 /* "event: " */,
-                                   firebase_pgm_str_12 /* "\n" */, payloadPos, 0, true))
+            response.dataType = firebase_data_type::d_blob;
+            if ((response.isEvent && response.hasEventData) || getOfs)
             {
-                response.isEvent = true;
-                payloadOfs = payloadPos;
-
-                if (sh->tokenSubString(src, out,
-                                       firebase_rtdb_pgm_str_13 /* "data: " */,
-                                       firebase_pgm_str_12 /* "\n" */, payloadPos, 0, true))
+                if (response.eventData.len > 0)
                 {
-                    payloadOfs += strlen_P(firebase_rtdb_pgm_str_13 /* "data: " */);
-                    payloadPos = payloadOfs;
-                    response.hasEventData = true;
-
-                    if (sh->tokenSubString(src, response.eventPath,
-                                           firebase_pgm_str_54 /* "\"path\":\"" */,
-                                           firebase_pgm_str_4 /* "\"" */, payloadPos, 0, true))
-                    {
-                        payloadOfs = payloadPos;
-
-                        if (sh->tokenSubString(src, response.eventData,
-                                               firebase_pgm_str_55 /* "\"data\":" */,
-                                               firebase_pgm_str_12 /* "\n" */, payloadPos, 0, true))
-                        {
-                            response.eventData[response.eventData.length() - 1] = 0;
-                            response.payloadLen = response.eventData.length();
-                            payloadOfs += strlen_P(firebase_pgm_str_55 /* "\"data\":" */) + 1;
-                            response.payloadOfs = payloadOfs;
-                        }
-                    }
+                    int dlen = response.eventData.len - strlen_P(firebase_rtdb_pgm_str_7) - 1;
+                    response.payloadLen = dlen;
                 }
+                response.payloadOfs += strlen_P(firebase_rtdb_pgm_str_7);
+                response.eventData.len = 0;
             }
         }
+        else if (sh->compare(buf, len, payloadOfs, firebase_rtdb_pgm_str_8 /* "\"file,base64," */, true))
+        {
+            response.dataType = firebase_data_type::d_file;
+            if ((response.isEvent && response.hasEventData) || getOfs)
+            {
+                if (response.eventData.len > 0)
+                {
+                    int dlen = response.eventData.len - strlen_P(firebase_rtdb_pgm_str_8) - 1;
+                    response.payloadLen = dlen;
+                }
+
+                response.payloadOfs += strlen_P(firebase_rtdb_pgm_str_8);
+                response.eventData.len = 0;
+            }
+        }
+        else if (sh->compare(buf, len, payloadOfs, firebase_pgm_str_4 /* "\"" */))
+            response.dataType = firebase_data_type::d_string;
+        else if (sh->compare(buf, len, payloadOfs, firebase_pgm_str_10 /* "{" */))
+            response.dataType = firebase_data_type::d_json;
+        else if (sh->compare(buf, len, payloadOfs, firebase_pgm_str_6 /* "[" */))
+            response.dataType = firebase_data_type::d_array;
+        else if (sh->compare(buf, len, payloadOfs, firebase_pgm_str_19 /* "false" */) ||
+                 sh->compare(buf, len, payloadOfs, firebase_pgm_str_20 /* "true" */))
+        {
+            response.dataType = firebase_data_type::d_boolean;
+            response.boolData = sh->compare(buf, len, payloadOfs, firebase_pgm_str_20 /* "true" */);
+        }
+        else if (sh->compare(buf, len, payloadOfs, firebase_pgm_str_59 /* "null" */))
+            response.dataType = firebase_data_type::d_null;
+        else
+            setNumDataType(buf, len, payloadOfs, response, sh->strposP(buf, len, firebase_pgm_str_5 /* "." */, payloadOfs) > -1);
+    }
+
+#endif
+
+    void parseRespPayload(StringHelper *sh, const MB_String &src, struct server_response_data_t &response, bool getOfs)
+    {
+        int payloadPos = 0;
+        int payloadOfs = 0;
+
+        MB_String out;
+
+#if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
+
+        if (!response.isEvent && !response.noEvent)
+            parseEventHeader(sh, src.c_str(), 0, src.length(), response, payloadPos, payloadOfs);
 
 #endif
 
@@ -894,51 +1085,7 @@ public:
                     response.fbError = d.stringValue.c_str();
             }
 #if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
-            if (sh->compare(src, payloadOfs, firebase_rtdb_pgm_str_7 /* "\"blob,base64," */, true))
-            {
-                response.dataType = firebase_data_type::d_blob;
-                if ((response.isEvent && response.hasEventData) || getOfs)
-                {
-                    if (response.eventData.length() > 0)
-                    {
-                        int dlen = response.eventData.length() - strlen_P(firebase_rtdb_pgm_str_7) - 1;
-                        response.payloadLen = dlen;
-                    }
-                    response.payloadOfs += strlen_P(firebase_rtdb_pgm_str_7);
-                    response.eventData.clear();
-                }
-            }
-            else if (sh->compare(src, payloadOfs, firebase_rtdb_pgm_str_8 /* "\"file,base64," */, true))
-            {
-                response.dataType = firebase_data_type::d_file;
-                if ((response.isEvent && response.hasEventData) || getOfs)
-                {
-                    if (response.eventData.length() > 0)
-                    {
-                        int dlen = response.eventData.length() - strlen_P(firebase_rtdb_pgm_str_8) - 1;
-                        response.payloadLen = dlen;
-                    }
-
-                    response.payloadOfs += strlen_P(firebase_rtdb_pgm_str_8);
-                    response.eventData.clear();
-                }
-            }
-            else if (sh->compare(src, payloadOfs, firebase_pgm_str_4 /* "\"" */))
-                response.dataType = firebase_data_type::d_string;
-            else if (sh->compare(src, payloadOfs, firebase_pgm_str_10 /* "{" */))
-                response.dataType = firebase_data_type::d_json;
-            else if (sh->compare(src, payloadOfs, firebase_pgm_str_6 /* "[" */))
-                response.dataType = firebase_data_type::d_array;
-            else if (sh->compare(src, payloadOfs, firebase_pgm_str_19 /* "false" */) ||
-                     sh->compare(src, payloadOfs, firebase_pgm_str_20 /* "true" */))
-            {
-                response.dataType = firebase_data_type::d_boolean;
-                response.boolData = sh->compare(src, payloadOfs, firebase_pgm_str_20 /* "true" */);
-            }
-            else if (sh->compare(src, payloadOfs, firebase_pgm_str_59 /* "null" */))
-                response.dataType = firebase_data_type::d_null;
-            else
-                setNumDataType(src, payloadOfs, response, src.find(pgm2Str(firebase_pgm_str_5 /* "." */), payloadOfs) != MB_String::npos);
+            setDataType(sh, src.c_str(), src.length(), payloadOfs, response, getOfs);
 #endif
         }
     }
@@ -1034,6 +1181,29 @@ public:
         int idx = 0;
         if (!client)
             return idx;
+
+#if defined(FIREBASE_HAS_PEEK_BUFFER_API)
+        // scan the line from the receive buffer in block
+        while (client->hasPeekBufferAPI() && idx < bufLen)
+        {
+            size_t avail = client->peekAvailable();
+            const char *p = client->peekBuffer();
+            if (avail == 0 || !p)
+                break;
+            size_t i = 0;
+            while (i < avail && idx < bufLen)
+            {
+                c = p[i++];
+                buf[idx++] = c;
+                if (c == '\n')
+                    break;
+            }
+            client->peekConsume(i);
+            if (c == '\n')
+                return idx;
+        }
+#endif
+
         while (client->available() && idx < bufLen)
         {
             if (!client)
@@ -1063,6 +1233,25 @@ public:
         int idx = 0;
         if (!client)
             return idx;
+
+#if defined(FIREBASE_HAS_PEEK_BUFFER_API)
+        // scan the line from the receive buffer in block
+        while (client->hasPeekBufferAPI())
+        {
+            size_t avail = client->peekAvailable();
+            const char *p = client->peekBuffer();
+            if (avail == 0 || !p)
+                break;
+            const char *end = (const char *)memchr(p, '\n', avail);
+            size_t len = end ? end - p + 1 : avail;
+            buf.append(p, len);
+            idx += len;
+            client->peekConsume(len);
+            if (end)
+                return idx;
+        }
+#endif
+
         while (client->available())
         {
             if (!client)
@@ -1103,119 +1292,143 @@ public:
         return val;
     }
 
-    // Returns -1 when complete
-    int readChunkedData(StringHelper *sh, MB_FS *mbfs, Client *client, char *out1, MB_String *out2,
-                        struct firebase_tcp_response_handler_t &tcpHandler)
+    // Read the available data up to len bytes to buf without blocking.
+    // The data is copied directly from the receive buffer of client when the peek buffer API is supported.
+    int readAvailable(Client *client, char *buf, int len)
     {
-        if (!client)
+        if (!client || len <= 0)
             return 0;
 
-        int bufLen = tcpHandler.chunkBufSize;
-        char *buf = nullptr;
-        int p1 = 0;
-        int olen = 0;
-
-        if (tcpHandler.chunkState.state == 0)
+#if defined(FIREBASE_HAS_PEEK_BUFFER_API)
+        if (client->hasPeekBufferAPI())
         {
-            tcpHandler.chunkState.state = 1;
-            tcpHandler.chunkState.chunkedSize = -1;
-            tcpHandler.chunkState.dataLen = 0;
-
-            MB_String s;
-            int readLen = 0;
-
-            if (out2)
-                readLen = readLine(client, s);
-            else if (out1)
+            size_t avail = client->peekAvailable();
+            const char *p = client->peekBuffer();
+            if (avail > 0 && p)
             {
-                buf = reinterpret_cast<char *>(mbfs->newP(bufLen));
-                readLen = readLine(client, buf, bufLen);
+                if ((int)avail < len)
+                    len = avail;
+                memcpy(buf, p, len);
+                client->peekConsume(len);
+                return len;
             }
+        }
+#endif
 
-            if (readLen)
-            {
-                if (out1)
-                    s = buf;
+        int avail = client->available();
+        if (avail <= 0)
+            return 0;
 
-                p1 = sh->strpos(s.c_str(), (const char *)MBSTRING_FLASH_MCR(";"), 0);
-                if (p1 == -1)
-                    p1 = sh->strpos(s.c_str(), (const char *)MBSTRING_FLASH_MCR("\r\n"), 0);
+        if (avail < len)
+            len = avail;
 
-                if (p1 != -1)
-                {
-                    if (out2)
-                        tcpHandler.chunkState.chunkedSize = hex2int(s.substr(0, p1).c_str());
-                    else if (out1)
-                    {
-                        char *temp = reinterpret_cast<char *>(mbfs->newP(p1 + 1));
-                        memcpy(temp, buf, p1);
-                        tcpHandler.chunkState.chunkedSize = hex2int(temp);
-                        mbfs->delP(&temp);
-                    }
-                }
+        return client->read(reinterpret_cast<uint8_t *>(buf), len);
+    }
 
-                // last chunk
-                if (tcpHandler.chunkState.chunkedSize < 1)
-                    olen = -1;
+    // Parse the chunk size line and the CRLF after chunk data, returns false when chunk data is ready to read
+    bool parseChunkControl(struct firebase_chunk_state_info &chunk, char c)
+    {
+        if (chunk.state == firebase_chunk_state_size)
+        {
+            if (isxdigit(c))
+            {
+                chunk.chunkedSize = (chunk.chunkedSize << 4) | (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+                return true;
             }
-            else
-                tcpHandler.chunkState.state = 0;
+            chunk.state = firebase_chunk_state_ext;
+        }
+
+        if (c != '\n')
+        {
+            // count the length of trailer line
+            if (chunk.state == firebase_chunk_state_trailer && c != '\r')
+                chunk.dataLen++;
+            return true;
+        }
 
-            if (out1)
-                mbfs->delP(&buf);
+        if (chunk.state == firebase_chunk_state_ext)
+        {
+            chunk.dataLen = 0;
+            chunk.state = chunk.chunkedSize > 0 ? firebase_chunk_state_data : firebase_chunk_state_trailer;
         }
-        else
+        else if (chunk.state == firebase_chunk_state_trailer)
+        {
+            // the empty line ends the trailer
+            if (chunk.dataLen == 0)
+                chunk.state = firebase_chunk_state_complete;
+            chunk.dataLen = 0;
+        }
+        else if (chunk.state == firebase_chunk_state_data_end)
+        {
+            chunk.chunkedSize = 0;
+            chunk.state = firebase_chunk_state_size;
+        }
+
+        return chunk.state != firebase_chunk_state_data && chunk.state != firebase_chunk_state_complete;
+    }
+
+    // Read the chunked encoding data to out (should be at least outLen + 1 bytes for null terminator).
+    // The state was kept in tcpHandler.chunkState between calls.
+    // Returns the number of decoded bytes or -1 when the last chunk was read.
+    int readChunkedData(Client *client, char *out, int outLen, struct firebase_tcp_response_handler_t &tcpHandler)
+    {
+        struct firebase_chunk_state_info &chunk = tcpHandler.chunkState;
+
+        if (chunk.state == firebase_chunk_state_complete)
+            return -1;
+
+        if (!client || !out)
+            return 0;
+
+        int olen = 0;
+
+        while (olen < outLen && chunk.state != firebase_chunk_state_complete)
         {
-            if (tcpHandler.chunkState.chunkedSize > -1)
+            if (chunk.state == firebase_chunk_state_data)
             {
-                MB_String s;
-                int readLen = 0;
+                int len = chunk.chunkedSize - chunk.dataLen;
+                if (len > outLen - olen)
+                    len = outLen - olen;
 
-                if (out2)
-                    readLen = readLine(client, s);
-                else if (out1)
-                {
-                    buf = reinterpret_cast<char *>(mbfs->newP(bufLen));
-                    readLen = readLine(client, buf, bufLen);
-                }
+                len = readAvailable(client, out + olen, len);
+                if (len <= 0)
+                    break;
 
-                if (readLen > 0)
-                {
-                    // chunk may contain trailing
-                    if (tcpHandler.chunkState.dataLen + readLen - 2 < tcpHandler.chunkState.chunkedSize)
-                    {
-                        tcpHandler.chunkState.dataLen += readLen;
-                        if (out2)
-                            *out2 += s;
-                        else if (out1)
-                            memcpy(out1, buf, readLen);
+                olen += len;
+                chunk.dataLen += len;
+                if (chunk.dataLen == chunk.chunkedSize)
+                    chunk.state = firebase_chunk_state_data_end;
+                continue;
+            }
 
-                        olen = readLen;
-                    }
-                    else
-                    {
-                        if (tcpHandler.chunkState.chunkedSize - tcpHandler.chunkState.dataLen > 0)
-                        {
-                            if (out2)
-                                *out2 += s;
-                            else if (out1)
-                                memcpy(out1, buf, tcpHandler.chunkState.chunkedSize - tcpHandler.chunkState.dataLen);
-                        }
-
-                        tcpHandler.chunkState.dataLen = tcpHandler.chunkState.chunkedSize;
-                        tcpHandler.chunkState.state = 0;
-                        olen = readLen;
-                    }
+#if defined(FIREBASE_HAS_PEEK_BUFFER_API)
+            if (client->hasPeekBufferAPI())
+            {
+                size_t avail = client->peekAvailable();
+                const char *p = client->peekBuffer();
+                if (avail > 0 && p)
+                {
+                    size_t i = 0;
+                    while (i < avail && parseChunkControl(chunk, p[i++]))
+                        ;
+                    client->peekConsume(i);
+                    continue;
                 }
-                // if all chunks read, returns -1
-                else if (tcpHandler.chunkState.dataLen == tcpHandler.chunkState.chunkedSize)
-                    olen = -1;
-
-                if (out1)
-                    mbfs->delP(&buf);
             }
+#endif
+            // only few bytes of control data to read
+            int c = client->available() > 0 ? client->read() : -1;
+            if (c < 0)
+                break;
+
+            parseChunkControl(chunk, (char)c);
         }
 
+        out[olen] = '\0';
+
+        if (olen == 0 && chunk.state == firebase_chunk_state_complete)
+            return -1;
+
         return olen;
     }
 
@@ -1265,6 +1478,8 @@ public:
         {
             // parse header string to get the header field
             tcpHandler.isHeader = false;
+            // the new chunked encoding payload begins
+            tcpHandler.chunkState = firebase_chunk_state_info();
             parseRespHeader(sh, tcpHandler.header, response);
         }
         // accumulate the remaining header field
@@ -1297,9 +1512,11 @@ public:
         return ((len + 2) / 3 * 4) + 1;
     }
 
-    int decodedLen(const char *src)
+    int decodedLen(const char *src, size_t len = 0)
     {
-        int len = strlen(src), i = len - 1, pad = 0;
+        if (len == 0)
+            len = strlen(src);
+        int i = len - 1, pad = 0;
         if (len < 4)
             return 0;
         while (i > 0 && src[i--] == '=')
@@ -1309,18 +1526,6 @@ public:
         return (3 * (len / 4)) - pad;
     }
 
-    unsigned char *creatBase64EncBuffer(MB_FS *mbfs, bool isURL)
-    {
-        unsigned char *base64EncBuf = reinterpret_cast<unsigned char *>(mbfs->newP(65));
-        strcpy_P((char *)base64EncBuf, (char *)firebase_base64_table);
-        if (isURL)
-        {
-            base64EncBuf[62] = '-';
-            base64EncBuf[63] = '_';
-        }
-        return base64EncBuf;
-    }
-
     bool updateWrite(uint8_t *data, size_t len)
     {
 #if (defined(ENABLE_OTA_FIRMWARE_UPDATE) || defined(FIREBASE_ENABLE_OTA_FIRMWARE_UPDATE)) && (defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB) || defined(ENABLE_FB_STORAGE) || defined(ENABLE_GC_STORAGE) || defined(FIREBASE_ENABLE_GC_STORAGE))
@@ -1382,88 +1587,145 @@ public:
         return true;
     }
 
+    // Decode the groups of 4 characters without padding and invalid character to dst, up to maxGroups groups.
+    // Returns the number of characters decoded, the number of bytes written is returned by written.
+    size_t decodeBlock(const unsigned char *base64DecBuf, const uint8_t *src, size_t len, uint8_t *dst,
+                       size_t maxGroups, size_t &written)
+    {
+        size_t i = 0;
+        written = 0;
+        while (maxGroups > 0 && len - i >= 4)
+        {
+            uint8_t a = base64DecBuf[src[i]], b = base64DecBuf[src[i + 1]];
+            uint8_t c = base64DecBuf[src[i + 2]], d = base64DecBuf[src[i + 3]];
+
+            // '=' is decoded to 0, leave it to the byte by byte decoding
+            if (((a | b | c | d) & 0x80) || src[i] == '=' || src[i + 1] == '=' || src[i + 2] == '=' || src[i + 3] == '=')
+                break;
+
+            dst[written++] = (a << 2) | (b >> 4);
+            dst[written++] = (b << 4) | (c >> 2);
+            dst[written++] = (c << 6) | d;
+            i += 4;
+            maxGroups--;
+        }
+        return i;
+    }
+
     template <typename T>
     bool decode(MB_FS *mbfs, unsigned char *base64DecBuf, const char *src, size_t len, firebase_base64_io_t<T> &out)
     {
         // the maximum chunk size that writes to output is limited by out.bufLen, the minimum is depending on the source length
-        bool ret = false;
-        unsigned char *block = reinterpret_cast<unsigned char *>(mbfs->newP(4, false));
-        unsigned char temp;
-        size_t i, count;
+        unsigned char block[4];
+        size_t i = 0, count = 0, valid = 0;
         int pad = 0;
-        size_t extra_pad;
         T *pos = out.outT ? (T *)&out.outT[0] : nullptr;
+        bool buffered = out.ota || out.outC || out.filetype != mb_fs_mem_storage_type_undefined;
+        const uint8_t *in = (const uint8_t *)src;
         if (len == 0)
             len = strlen(src);
 
-        count = 0;
-
-        for (i = 0; i < len; i++)
+        while (i < len)
         {
-            if ((uint8_t)base64DecBuf[(uint8_t)src[i]] != 0x80)
-                count++;
-        }
-
-        if (count == 0)
-            goto skip;
-
-        extra_pad = (4 - count % 4) % 4;
-        count = 0;
-        for (i = 0; i < len + extra_pad; i++)
-        {
-            unsigned char val;
+            // the complete groups are decoded straight to the output buffer
+            if (count == 0 && out.outT && sizeof(T) == 1)
+            {
+                if (buffered && out.bufLen - out.bufWrite < 3 && !writeOutput(mbfs, out))
+                    return false;
 
-            if (i >= len)
-                val = '=';
-            else
-                val = src[i];
+                uint8_t *dst = buffered ? (uint8_t *)out.outT + out.bufWrite : (uint8_t *)pos;
+                size_t written = 0;
+                size_t n = decodeBlock(base64DecBuf, in + i, len - i, dst,
+                                       buffered ? (out.bufLen - out.bufWrite) / 3 : (len - i) / 4, written);
+                if (n > 0)
+                {
+                    if (buffered)
+                        out.bufWrite += written;
+                    else
+                        pos += written;
+                    valid += n;
+                    i += n;
+                    continue;
+                }
+            }
 
-            temp = base64DecBuf[val];
+            unsigned char val = in[i++];
+            unsigned char temp = base64DecBuf[val];
 
             if (temp == 0x80)
                 continue;
 
+            valid++;
+
             if (val == '=')
                 pad++;
 
-            block[count] = temp;
-            count++;
+            block[count++] = temp;
             if (count == 4)
             {
-
-                setOutput(mbfs, (block[0] << 2) | (block[1] >> 4), out, &pos);
-
                 count = 0;
+                if (!putBlock(mbfs, block, pad, out, &pos))
+                    return false;
                 if (pad)
-                {
-                    if (pad == 1)
-                        setOutput(mbfs, (block[1] << 4) | (block[2] >> 2), out, &pos);
-                    else if (pad > 2)
-                        goto skip;
-
                     break;
-                }
-                else
-                {
-                    setOutput(mbfs, (block[1] << 4) | (block[2] >> 2), out, &pos);
-                    setOutput(mbfs, (block[2] << 6) | block[3], out, &pos);
-                }
             }
         }
 
+        if (valid == 0)
+            return false;
+
+        // the missing paddings
+        if (count > 0)
+        {
+            pad += 4 - count;
+            while (count < 4)
+                block[count++] = 0;
+            if (!putBlock(mbfs, block, pad, out, &pos))
+                return false;
+        }
+
         // write remaining
         if (out.bufWrite > 0 && !writeOutput(mbfs, out))
-            goto skip;
+            return false;
 
-        ret = true;
+        return true;
+    }
 
-    skip:
-        mbfs->delP(&block);
-        return ret;
+    template <typename T>
+    bool putBlock(MB_FS *mbfs, const unsigned char *block, int pad, firebase_base64_io_t<T> &out, T **pos)
+    {
+        if (pad > 2)
+            return false;
+
+        if (!setOutput(mbfs, (block[0] << 2) | (block[1] >> 4), out, pos))
+            return false;
+        if (pad < 2 && !setOutput(mbfs, (block[1] << 4) | (block[2] >> 2), out, pos))
+            return false;
+        if (pad < 1 && !setOutput(mbfs, (block[2] << 6) | block[3], out, pos))
+            return false;
+        return true;
+    }
+
+    // Encode the complete 3-byte groups of src to dst, returns the number of characters written.
+    size_t encodeBlock(const unsigned char *base64EncBuf, const uint8_t *src, size_t len, uint8_t *dst)
+    {
+        uint8_t *p = dst;
+        const uint8_t *end = src + len - len % 3;
+        while (src < end)
+        {
+            uint32_t v = ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
+            p[0] = base64EncBuf[v >> 18];
+            p[1] = base64EncBuf[(v >> 12) & 0x3f];
+            p[2] = base64EncBuf[(v >> 6) & 0x3f];
+            p[3] = base64EncBuf[v & 0x3f];
+            p += 4;
+            src += 3;
+        }
+        return p - dst;
     }
 
     template <typename T>
-    bool encodeLast(MB_FS *mbfs, unsigned char *base64EncBuf, const unsigned char *in, size_t len,
+    bool encodeLast(MB_FS *mbfs, const unsigned char *base64EncBuf, const unsigned char *in, size_t len,
                     firebase_base64_io_t<T> &out, T **pos)
     {
         if (len > 2)
@@ -1494,15 +1756,44 @@ public:
     }
 
     template <typename T>
-    bool encode(MB_FS *mbfs, unsigned char *base64EncBuf, uint8_t *src, size_t len,
+    bool encode(MB_FS *mbfs, const unsigned char *base64EncBuf, uint8_t *src, size_t len,
                 firebase_base64_io_t<T> &out, bool writeAllRemaining = true)
     {
         const unsigned char *end, *in;
 
         T *pos = out.outT ? (T *)&out.outT[0] : nullptr;
+        bool buffered = out.ota || out.outC || out.filetype != mb_fs_mem_storage_type_undefined;
         in = src;
         end = src + len;
 
+        // the complete groups are encoded straight to the output buffer
+        if (out.outT && sizeof(T) == 1)
+        {
+            if (!buffered)
+            {
+                size_t n = encodeBlock(base64EncBuf, in, end - in, (uint8_t *)pos);
+                pos += n;
+                in += n / 4 * 3;
+            }
+            else if (out.bufLen >= 4)
+            {
+                while (end - in >= 3)
+                {
+                    size_t room = (out.bufLen - out.bufWrite) / 4 * 3;
+                    if (room == 0)
+                    {
+                        if (!writeOutput(mbfs, out))
+                            return false;
+                        continue;
+                    }
+
+                    size_t n = (size_t)(end - in) < room ? (size_t)(end - in) : room;
+                    out.bufWrite += encodeBlock(base64EncBuf, in, n, (uint8_t *)out.outT + out.bufWrite);
+                    in += n - n % 3;
+                }
+            }
+        }
+
         while (end - in >= 3)
         {
             if (!setOutput(mbfs, base64EncBuf[in[0] >> 2], out, &pos))
@@ -1526,11 +1817,18 @@ public:
     }
     template <typename T>
     bool decodeToArray(MB_FS *mbfs, const MB_String &src, MB_VECTOR<T> &val)
+    {
+        return decodeToArray<T>(mbfs, src.c_str(), src.length(), val);
+    }
+
+    template <typename T>
+    bool decodeToArray(MB_FS *mbfs, const char *src, size_t len, MB_VECTOR<T> &val)
     {
         firebase_base64_io_t<T> out;
         out.outL = &val;
+        val.reserve(val.size() + decodedLen(src, len));
         unsigned char *base64DecBuf = creatBase64DecBuffer(mbfs);
-        bool ret = decode<T>(mbfs, base64DecBuf, src.c_str(), src.length(), out);
+        bool ret = decode<T>(mbfs, base64DecBuf, src, len, out);
         mbfs->delP(&base64DecBuf);
         return ret;
     }
@@ -1542,7 +1840,7 @@ public:
         uint8_t *buf = reinterpret_cast<uint8_t *>(mbfs->newP(out.bufLen));
         out.outT = buf;
         unsigned char *base64DecBuf = creatBase64DecBuffer(mbfs);
-        bool ret = decode<uint8_t>(mbfs, base64DecBuf, src, strlen(src), out);
+        bool ret = decode<uint8_t>(mbfs, base64DecBuf, src, len, out);
         mbfs->delP(&buf);
         mbfs->delP(&base64DecBuf);
         return ret;
@@ -1550,33 +1848,31 @@ public:
 
     void encodeUrl(MB_FS *mbfs, char *encoded, unsigned char *string, size_t len)
     {
-        size_t i;
-        char *p = encoded;
-        unsigned char *base64EncBuf = creatBase64EncBuffer(mbfs, true);
-
-        for (i = 0; i < len - 2; i += 3)
-        {
-            *p++ = base64EncBuf[(string[i] >> 2) & 0x3F];
-            *p++ = base64EncBuf[((string[i] & 0x3) << 4) | ((int)(string[i + 1] & 0xF0) >> 4)];
-            *p++ = base64EncBuf[((string[i + 1] & 0xF) << 2) | ((int)(string[i + 2] & 0xC0) >> 6)];
-            *p++ = base64EncBuf[string[i + 2] & 0x3F];
-        }
+        char *p = encoded + encodeBlock(firebase_base64_table, string, len, (uint8_t *)encoded);
+        size_t i = len - len % 3;
 
         if (i < len)
         {
-            *p++ = base64EncBuf[(string[i] >> 2) & 0x3F];
+            *p++ = firebase_base64_table[(string[i] >> 2) & 0x3F];
             if (i == (len - 1))
-                *p++ = base64EncBuf[((string[i] & 0x3) << 4)];
+                *p++ = firebase_base64_table[((string[i] & 0x3) << 4)];
             else
             {
-                *p++ = base64EncBuf[((string[i] & 0x3) << 4) | ((int)(string[i + 1] & 0xF0) >> 4)];
-                *p++ = base64EncBuf[((string[i + 1] & 0xF) << 2)];
+                *p++ = firebase_base64_table[((string[i] & 0x3) << 4) | ((int)(string[i + 1] & 0xF0) >> 4)];
+                *p++ = firebase_base64_table[((string[i + 1] & 0xF) << 2)];
             }
         }
 
-        *p++ = '\0';
+        *p = '\0';
 
-        mbfs->delP(&base64EncBuf);
+        // the URL safe alphabet
+        for (p = encoded; *p; p++)
+        {
+            if (*p == '+')
+                *p = '-';
+            else if (*p == '/')
+                *p = '_';
+        }
     }
 
     MB_String encodeToString(MB_FS *mbfs, uint8_t *src, size_t len)
@@ -1585,11 +1881,9 @@ public:
         char *encoded = reinterpret_cast<char *>(mbfs->newP(encodedLength(len) + 1));
         firebase_base64_io_t<char> out;
         out.outT = encoded;
-        unsigned char *base64EncBuf = creatBase64EncBuffer(mbfs, false);
-        if (encode<char>(mbfs, base64EncBuf, (uint8_t *)src, len, out))
+        if (encode<char>(mbfs, firebase_base64_table, (uint8_t *)src, len, out))
             str = encoded;
         mbfs->delP(&encoded);
-        mbfs->delP(&base64EncBuf);
         return str;
     }
 
@@ -1599,10 +1893,8 @@ public:
         out.outC = client;
         uint8_t *buf = reinterpret_cast<uint8_t *>(mbfs->newP(out.bufLen));
         out.outT = buf;
-        unsigned char *base64EncBuf = creatBase64EncBuffer(mbfs, false);
-        bool ret = encode<uint8_t>(mbfs, base64EncBuf, (uint8_t *)data, len, out);
+        bool ret = encode<uint8_t>(mbfs, firebase_base64_table, (uint8_t *)data, len, out);
         mbfs->delP(&buf);
-        mbfs->delP(&base64EncBuf);
         return ret;
     }
 };
@@ -1736,9 +2028,14 @@ public:
     }
 
     bool validJS(const char *c)
+    {
+        return validJS(c, strlen(c));
+    }
+
+    bool validJS(const char *c, size_t len)
     {
         size_t ob = 0, cb = 0, os = 0, cs = 0;
-        for (size_t i = 0; i < strlen(c); i++)
+        for (size_t i = 0; i < len; i++)
         {
             if (c[i] == '{')
                 ob++;
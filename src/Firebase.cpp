@@ -133,7 +133,20 @@ bool FIREBASE_CLASS::ready()
                 fbdo->closeSession();
         }
     }
-    return Core.tokenReady();
+
+    if (Core.config)
+        Core.tcpPool.evict(&Core.config->connection_pool);
+
+    bool ret = Core.tokenReady();
+
+#if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
+    if (ret)
+        RTDB.flushDueBatches();
+
+    RTDB.readDueAsyncResponses();
+#endif
+
+    return ret;
 }
 
 bool FIREBASE_CLASS::authenticated()
@@ -346,6 +359,47 @@ int FIREBASE_CLASS::getFreeHeap()
 #endif
 }
 
+ConnectionPoolInfo FIREBASE_CLASS::connectionPoolInfo()
+{
+    return Core.tcpPool.info();
+}
+
+TLSSessionCacheInfo FIREBASE_CLASS::tlsSessionCacheInfo()
+{
+    return Core.tlsSessionCache.info();
+}
+
+TrustAnchorStoreInfo FIREBASE_CLASS::trustAnchorStoreInfo()
+{
+    return Core.trustAnchors.info();
+}
+
+TokenRefreshInfo FIREBASE_CLASS::tokenRefreshInfo()
+{
+    return Core.refreshInfo;
+}
+
+RequestArenaInfo FIREBASE_CLASS::requestArenaInfo()
+{
+    RequestArenaInfo info;
+    mbfs_arena_info_t arena = Core.mbfs.arenaInfo();
+    info.size = arena.size;
+    info.peak = arena.peak;
+    info.allocations = arena.allocations;
+    info.fallbacks = arena.fallbacks;
+    info.resets = arena.resets;
+    info.free_heap = getFreeHeap();
+#if defined(ESP8266)
+    info.max_free_block = ESP.getMaxFreeBlockSize();
+    info.heap_fragmentation = ESP.getHeapFragmentation();
+#elif defined(ESP32)
+    info.max_free_block = ESP.getMaxAllocHeap();
+    if (info.free_heap > 0)
+        info.heap_fragmentation = 100 - (uint8_t)(info.max_free_block * 100 / info.free_heap);
+#endif
+    return info;
+}
+
 const char *FIREBASE_CLASS::getToken()
 {
     return Core.getToken();
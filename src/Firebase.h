@@ -340,6 +340,75 @@ public:
    */
   int getFreeHeap();
 
+  /** Provide the usage statistics of shared connection pool.
+   *
+   * @return ConnectionPoolInfo The firebase_connection_pool_info_t structured data.
+   *
+   * @note The connection pool can be enabled by config.connection_pool.enable.
+   * Use hits property to get the number of requests that reused the pooled connection.
+   * Use misses property to get the number of requests that found no pooled connection.
+   * Use evictions property to get the number of pooled connections that were closed.
+   * Use size property to get the number of connections that currently kept in pool.
+   */
+  ConnectionPoolInfo connectionPoolInfo();
+
+  /** Provide the usage statistics of persisted TLS session cache.
+   *
+   * @return TLSSessionCacheInfo The firebase_tls_session_cache_info_t structured data.
+   *
+   * @note The session cache can be enabled by assigning the file name to config.tls_session_cache.filename.
+   * The cache file keeps the session master secret in plaintext and it is rewritten after every full SSL handshake.
+   * Use resumed property to get the number of SSL handshakes that resumed the session.
+   * Use full property to get the number of full SSL handshakes.
+   * Use restored property to get the number of sessions that were restored from cache.
+   * Use expired property to get the number of cached sessions that were removed by expiry.
+   * Use saves property to get the number of times the cache file was written.
+   * Use size property to get the number of sessions that currently kept in cache.
+   */
+  TLSSessionCacheInfo tlsSessionCacheInfo();
+
+  /** Provide the usage statistics of shared trust anchor store.
+   *
+   * @return TrustAnchorStoreInfo The firebase_trust_anchor_store_info_t structured data.
+   *
+   * @note The CA certificate (config.cert.data, config.cert.file or FirebaseData::setCert) is decoded once
+   * and its trust anchors are shared between Firebase Data objects.
+   * Assign the file name to config.cert.der_file to keep the decoded DER certificates of PEM data across reboots.
+   * Use decodes property to get the number of times the certificates were decoded.
+   * Use der_loads property to get the number of times the certificates were loaded from DER file.
+   * Use hits property to get the number of times the decoded trust anchors were shared.
+   * Use size property to get the number of certificate sources that currently kept in store.
+   * Use anchors property to get the number of trust anchors that currently kept in store.
+   */
+  TrustAnchorStoreInfo trustAnchorStoreInfo();
+
+  /** Provide the statistics of auth token background refresh and the time that requests were blocked on auth.
+   *
+   * @return TokenRefreshInfo The firebase_token_refresh_info_t structured data.
+   *
+   * @note The background refresh can be enabled by config.token_refresh.background, the token will be refreshed
+   * before expiry (config.token_refresh.lead_seconds plus random config.token_refresh.jitter_seconds)
+   * while the current token is still used by requests and streams.
+   * Use background property to get the number of tokens that were refreshed in background.
+   * Use failures property to get the number of background refresh errors.
+   * Use blocked property to get the number of times that the requests were blocked waiting for the auth token.
+   * Use blocked_ms property to get the total time in ms that the requests were blocked waiting for the auth token.
+   * Use max_blocked_ms property to get the longest time in ms that the requests were blocked.
+   * Use lead_seconds property to get the seconds before expiry of the scheduled background refresh.
+   */
+  TokenRefreshInfo tokenRefreshInfo();
+
+  /** Provide the usage statistics of request arena and the heap fragmentation.
+   *
+   * @return RequestArenaInfo The firebase_request_arena_info_t structured data.
+   *
+   * @note The request arena can be enabled by config.rtdb.request_arena_size.
+   * Use peak property to get the highest number of arena bytes that were in use.
+   * Use fallbacks property to get the number of allocations that were taken from heap because the arena was full.
+   * Use max_free_block and heap_fragmentation properties to compare the heap fragmentation with and without arena.
+   */
+  RequestArenaInfo requestArenaInfo();
+
   /** Get current timestamp.
    *
    * @return current timestamp.
@@ -1765,6 +1834,18 @@ public:
     return RTDB.getJSON(&fbdo, path, &query, target);
   }
 
+  /** Read the JSON at the defined database path with the streaming reader.
+   *
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param path Database path in which the JSON is being read.
+   * @param reader The FirebaseJsonReader object pointer that reports the JSON elements to its callback.
+   * @return Boolean type status indicates the success of the operation.
+   *
+   * @note The payload was parsed while it is received and it is not kept in the Firebase Data Object.
+   */
+  template <typename T = const char *>
+  bool getJSON(FirebaseData &fbdo, T path, FirebaseJsonReader *reader) { return RTDB.getJSON(&fbdo, path, reader); }
+
   /** Read the array data at the defined database path.
    *
    * @param fbdo Firebase Data Object to hold data and instance.
@@ -2080,6 +2161,28 @@ public:
    */
   void removeMultiPathStreamCallback(FirebaseData &fbdo) { RTDB.removeMultiPathStreamCallback(&fbdo); }
 
+  /** Add the child path to the multiple paths stream index with its own callback function.
+   *
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param childPath The child path relative to the multiple paths stream parent path.
+   * @param childCallback The Callback function that accepts MultiPathStreamData parameter.
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * @note Only the callbacks of the child paths which their data changed will be called with
+   * the [MultiPathStreamData object] properties value, dataPath, type and eventType already set.
+   */
+  template <typename T = const char *>
+  bool addMultiPathStreamChild(FirebaseData &fbdo, T childPath, FirebaseData::MultiPathStreamEventCallback childCallback)
+  {
+    return RTDB.addMultiPathStreamChild(&fbdo, childPath, childCallback);
+  }
+
+  /** Remove all child paths and their callback functions from the multiple paths stream index.
+   *
+   * @param fbdo Firebase Data Object to hold data and instance.
+   */
+  void removeMultiPathStreamChildren(FirebaseData &fbdo) { RTDB.removeMultiPathStreamChildren(&fbdo); }
+
   /** Run stream manually.
    * To manually triggering the stream callback function, this should call repeatedly in loop().
    */
@@ -2132,7 +2235,57 @@ public:
    */
   void setMaxRetry(FirebaseData &fbdo, uint8_t num) { RTDB.setMaxRetry(&fbdo, num); }
 
+  /** Set the callback function for the responses of pipelined async requests.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param callback The callback function that accept RTDB_AsyncResultInfo data.
+   *
+   * The pipelining is enabled by setting config.rtdb.async_pipeline_depth greater than 0.
+   * The async request fails with FIREBASE_ERROR_ASYNC_PIPELINE_FULL when the pipeline is full.
+   * The callback is called from Firebase.ready() and readAsyncResponses, not from inside other requests.
+   */
+  void setAsyncCallback(FirebaseData &fbdo, RTDB_AsyncResultCallback callback) { RTDB.setAsyncCallback(&fbdo, callback); }
+
+  /** Read the available responses of pipelined async requests.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param wait Optional. Set to true to wait until all responses were read or timed out.
+   * @return Boolean type status indicates the success of the operation.
+   */
+  bool readAsyncResponses(FirebaseData &fbdo, bool wait = false) { return RTDB.readAsyncResponses(&fbdo, wait); }
+
+  /** Begin the write batch at the defined node path.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param path The parent path of the child nodes to write.
+   * @return Boolean type status indicates the success of the operation.
+   *
+   * The set functions of the child nodes of this path will be sent as a single multi-path update request
+   * when commitBatch was called or the batch limits in config.rtdb.batch were reached.
+   *
+   * The set function returns true when the write was kept (buffered) in batch, not when it was written.
+   * The writes of failed commit are kept and retried, the later writes return false until the commit was succeeded.
+   * The batch is never committed on time by config.rtdb.batch.max_delay_ms unless Firebase.ready() was polled in the loop.
+   */
+  template <typename T = const char *>
+  bool beginBatch(FirebaseData &fbdo, T path) { return RTDB.beginBatch(&fbdo, path); }
+
+  /** Commit the pending writes of the write batch and end the batch.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @return Boolean type status indicates the success of the operation.
+   *
+   * @note The writes are kept when the commit was failed, call commitBatch again to retry.
+   */
+  bool commitBatch(FirebaseData &fbdo) { return RTDB.commitBatch(&fbdo); }
+
   // Generic functions
+
+  /** Set the value at the defined database path.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param path Target database path which the value will be set.
+   * @param value The value to set.
+   * @return Boolean type status indicates the success of the operation.
+   *
+   * @note When the write batch was begun by beginBatch, true means the value was kept (buffered) in batch
+   * and not yet written to the database.
+   */
   template <typename T1 = const char *, typename T2>
   bool set(FirebaseData &fbdo, T1 path, T2 value) { return RTDB.set(&fbdo, path, value); }
 
@@ -2338,13 +2491,21 @@ public:
   }
 
 #if defined(ENABLE_ERROR_QUEUE) || defined(FIREBASE_ENABLE_ERROR_QUEUE)
-  /** Set the maximum Firebase Error Queues in the collection (0 255).
+  /** Set the maximum Firebase Error Queues in the collection (0 65534).
    * Firebase read/store operation causes by network problems and buffer overflow will be added to Firebase
    * Error Queues collection.
    * @param fbdo Firebase Data Object to hold data and instance.
    * @param num The maximum Firebase Error Queues.
    */
-  void setMaxErrorQueue(FirebaseData &fbdo, uint8_t num) { RTDB.setMaxErrorQueue(&fbdo, num); }
+  void setMaxErrorQueue(FirebaseData &fbdo, uint16_t num) { RTDB.setMaxErrorQueue(&fbdo, num); }
+
+  /** Set the priority class of the Firebase Error Queues added after this call.
+   * The queues in higher class are processed first, the queues in the same class are processed in order.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param priority The priority class, firebase_queue_priority_bulk, firebase_queue_priority_normal (default)
+   * or firebase_queue_priority_control.
+   */
+  void setErrorQueuePriority(FirebaseData &fbdo, firebase_queue_priority priority) { RTDB.setErrorQueuePriority(&fbdo, priority); }
 
   /** Save Firebase Error Queues as SPIFFS file (save only database store queues).
    * Firebase read (get) operation will not be saved.
@@ -2388,22 +2549,47 @@ public:
    * @param fbdo Firebase Data Object to hold data and instance.
    * @param filename Filename to be read and count for queues.
    * @param storageType Type of storage to read file, StorageType::FLASH or StorageType::SD.
-   * @return Number (0-255) of queues store in defined SPIFFS file.
+   * @return Number of queues store in defined SPIFFS file.
    *
    * The file systems for flash and sd memory can be changed in FirebaseFS.h.
    */
   template <typename T = const char *>
-  uint8_t errorQueueCount(FirebaseData &fbdo, T filename, uint8_t storageType)
+  uint16_t errorQueueCount(FirebaseData &fbdo, T filename, uint8_t storageType)
   {
     return RTDB.errorQueueCount(&fbdo, filename, getMemStorageType(storageType));
   }
 
+  /** Keep the Firebase Error Queues in an append-only journal file.
+   *
+   * The queues found in the journal file (e.g. left from the power loss) are restored to the collection.
+   * Then every added and completed queue is appended to the file as one small record, the file
+   * is compacted when the completed records outnumber the pending ones.
+   *
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param filename The journal file name.
+   * @param storageType Type of storage to keep file, StorageType::FLASH or StorageType::SD.
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * The file systems for flash and sd memory can be changed in FirebaseFS.h.
+   */
+  template <typename T = const char *>
+  bool beginErrorQueueJournal(FirebaseData &fbdo, T filename, uint8_t storageType)
+  {
+    return RTDB.beginErrorQueueJournal(&fbdo, filename, getMemStorageType(storageType));
+  }
+
+  /** Stop writing the Firebase Error Queues to the journal file.
+   *
+   * @param fbdo Firebase Data Object to hold data and instance.
+   */
+  void endErrorQueueJournal(FirebaseData &fbdo) { RTDB.endErrorQueueJournal(&fbdo); }
+
   /** Determine number of queues in Firebase Data object Firebase Error Queues collection.
    *
    * @param fbdo Firebase Data Object to hold data and instance.
-   * @return Number (0-255) of queues in Firebase Data object queue collection.
+   * @return Number of queues in Firebase Data object queue collection.
    */
-  uint8_t errorQueueCount(FirebaseData &fbdo) { return RTDB.errorQueueCount(&fbdo); }
+  uint16_t errorQueueCount(FirebaseData &fbdo) { return RTDB.errorQueueCount(&fbdo); }
 
   /** Determine whether the  Firebase Error Queues collection was full or not.
    *
@@ -2422,6 +2608,38 @@ public:
     return RTDB.processErrorQueue(&fbdo, callback);
   }
 
+  /** Set the processing mode of the Firebase Error Queues.
+   * In batch mode, the consecutive queues of set and update of JSON are merged into the multi-path update requests,
+   * the queues of the same or overlapped paths are always applied in order.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param mode The processing mode, firebase_queue_drain_mode_sequential (default) or firebase_queue_drain_mode_batch.
+   */
+  void setErrorQueueDrainMode(FirebaseData &fbdo, firebase_queue_drain_mode mode) { RTDB.setErrorQueueDrainMode(&fbdo, mode); }
+
+  /** Add the Firebase Data Object which its connection is also used to send the write requests of the Firebase Error Queues processing.
+   * The requests are sent on the connections in turn, one request at a time (not in parallel).
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param other Other Firebase Data Object, which should not be used for stream.
+   */
+  void addErrorQueueConnection(FirebaseData &fbdo, FirebaseData &other) { RTDB.addErrorQueueConnection(&fbdo, &other); }
+
+  /** Remove the Firebase Data Object that was added by addErrorQueueConnection.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @param other Other Firebase Data Object to remove.
+   */
+  void removeErrorQueueConnection(FirebaseData &fbdo, FirebaseData &other) { RTDB.removeErrorQueueConnection(&fbdo, &other); }
+
+  /** Get the statistics of the Firebase Error Queues processing.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   * @return RTDB_QueueDrainInfo The statistics e.g. the number of sent queues and requests and the throughput.
+   */
+  RTDB_QueueDrainInfo errorQueueDrainInfo(FirebaseData &fbdo) { return RTDB.errorQueueDrainInfo(&fbdo); }
+
+  /** Reset the statistics of the Firebase Error Queues processing.
+   * @param fbdo Firebase Data Object to hold data and instance.
+   */
+  void resetErrorQueueDrainInfo(FirebaseData &fbdo) { RTDB.resetErrorQueueDrainInfo(&fbdo); }
+
   /** Return Firebase Error Queue ID of last Firebase Error.
    * Return 0 if there is no Firebase Error from the last operation.
    *
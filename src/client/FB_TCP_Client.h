@@ -39,6 +39,15 @@
 #endif
 #include "./FB_Network.h"
 
+#if !defined(ESP_SSLCLIENT_HAS_WRITEV)
+// The data buffer of gather write, for ESP_SSLClient library that has no gather write support.
+struct esp_ssl_iovec_t
+{
+  const uint8_t *data = nullptr;
+  size_t len = 0;
+};
+#endif
+
 #if defined(ESP32)
 #include "IPAddress.h"
 #include "lwip/sockets.h"
@@ -87,9 +96,615 @@ private:
   bool optional = false;
 } Firebase_StaticIP;
 
+struct firebase_tls_session_cache_item_t
+{
+  MB_String host;
+  // The time that session was saved, 0 when the device time was not set.
+  uint32_t ts = 0;
+  br_ssl_session_parameters params;
+};
+
+/**
+ * The TLS session parameters (session ID and master secret) of each host that kept in file,
+ * the session can be resumed with abbreviated handshake (no certificate verification and key exchange)
+ * after reboot.
+ *
+ * The cache file contains the "FBTS" header, version, size of session parameters and number of sessions,
+ * followed by [host length][host][saved time][session parameters] of each session and the Fletcher-16 checksum.
+ */
+class Firebase_TLS_Session_Cache
+{
+public:
+  Firebase_TLS_Session_Cache(){};
+  ~Firebase_TLS_Session_Cache(){};
+
+  /**
+   * Restore the cached session of host to the session that has no session ID.
+   * @param mbfs The pointer to MB_FS.
+   * @param host The host name.
+   * @param session The pointer to BearSSL session.
+   * @param config The pointer to TLS session cache config.
+   * @return true when the cached session was restored.
+   */
+  bool restore(MB_FS *mbfs, const char *host, BearSSL_Session *session, firebase_tls_session_cache_config_t *config)
+  {
+    if (!session || session->getSession()->session_id_len > 0 || !load(mbfs, config))
+      return false;
+
+    int index = find(host);
+    if (index < 0)
+      return false;
+
+    if (isExpired(_items[index].ts, config))
+    {
+      _items.erase(_items.begin() + index);
+      _info.expired++;
+      save(mbfs, config);
+      return false;
+    }
+
+    memcpy(session->getSession(), &_items[index].params, sizeof(br_ssl_session_parameters));
+    _info.restored++;
+    return true;
+  }
+
+  /**
+   * Count the completed SSL handshake and keep the new session of host in cache.
+   * @param mbfs The pointer to MB_FS.
+   * @param host The host name.
+   * @param session The pointer to BearSSL session after handshake.
+   * @param offeredID The session ID that was offered to server.
+   * @param offeredLen The length of offered session ID, 0 for no session offered.
+   * @param config The pointer to TLS session cache config.
+   */
+  void update(MB_FS *mbfs, const char *host, BearSSL_Session *session, const uint8_t *offeredID, uint8_t offeredLen, firebase_tls_session_cache_config_t *config)
+  {
+    if (!session || !load(mbfs, config))
+      return;
+
+    br_ssl_session_parameters *params = session->getSession();
+
+    // The server resumed the session when it accepted the offered session ID.
+    if (offeredLen > 0 && params->session_id_len == offeredLen && memcmp(params->session_id, offeredID, offeredLen) == 0)
+    {
+      _info.resumed++;
+      return;
+    }
+
+    _info.full++;
+
+    // The server does not support the session resumption.
+    if (params->session_id_len == 0)
+      return;
+
+    int index = find(host);
+    if (index >= 0)
+      _items.erase(_items.begin() + index);
+
+    // The least recently saved session is at the front
+    while (_items.size() >= MAX_TLS_SESSION_CACHE_SIZE)
+      _items.erase(_items.begin());
+
+    firebase_tls_session_cache_item_t item;
+    item.host = host;
+    item.ts = now();
+    memcpy(&item.params, params, sizeof(br_ssl_session_parameters));
+    _items.push_back(item);
+
+    save(mbfs, config);
+  }
+
+  /**
+   * Get the session cache usage statistics.
+   * @return TLSSessionCacheInfo.
+   */
+  TLSSessionCacheInfo info()
+  {
+    _info.size = _items.size();
+    return _info;
+  }
+
+private:
+  MB_VECTOR<firebase_tls_session_cache_item_t> _items;
+  TLSSessionCacheInfo _info;
+  bool _loaded = false;
+
+  int find(const char *host)
+  {
+    for (size_t i = 0; i < _items.size(); i++)
+    {
+      if (strcmp(_items[i].host.c_str(), host) == 0)
+        return i;
+    }
+    return -1;
+  }
+
+  // The current time or 0 when the device time was not set.
+  uint32_t now()
+  {
+    time_t ts = time(nullptr);
+    return ts > FIREBASE_DEFAULT_TS ? (uint32_t)ts : 0;
+  }
+
+  bool isExpired(uint32_t ts, firebase_tls_session_cache_config_t *config)
+  {
+    uint32_t current = now();
+    return config->ttl > 0 && ts > 0 && current > 0 && (current < ts || current - ts > config->ttl);
+  }
+
+  bool readBytes(MB_FS *mbfs, mbfs_file_type type, uint8_t *buf, size_t len, uint16_t &sum)
+  {
+    if (len > 0 && mbfs->read(type, buf, len) != (int)len)
+      return false;
+    sum = FBUtils::fletcher16(buf, len, sum);
+    return true;
+  }
+
+  bool writeBytes(MB_FS *mbfs, mbfs_file_type type, const uint8_t *buf, size_t len, uint16_t &sum)
+  {
+    sum = FBUtils::fletcher16(buf, len, sum);
+    return len == 0 || mbfs->write(type, const_cast<uint8_t *>(buf), len) == (int)len;
+  }
+
+  // Load the cache file once, returns false when the cache is disabled.
+  bool load(MB_FS *mbfs, firebase_tls_session_cache_config_t *config)
+  {
+    if (!mbfs || !config || config->filename.length() == 0)
+      return false;
+
+    if (_loaded)
+      return true;
+
+    _loaded = true;
+
+    mbfs_file_type type = mbfs_type config->storage_type;
+
+    if (mbfs->open(config->filename, type, mb_fs_open_mode_read) <= 0)
+      return true;
+
+    uint16_t sum = 0;
+    uint8_t header[7];
+    bool ok = readBytes(mbfs, type, header, sizeof(header), sum) &&
+              memcmp(header, "FBTS", 4) == 0 && header[4] == 1 &&
+              header[5] == sizeof(br_ssl_session_parameters) && header[6] <= MAX_TLS_SESSION_CACHE_SIZE;
+
+    MB_VECTOR<firebase_tls_session_cache_item_t> items;
+
+    for (uint8_t i = 0; ok && i < header[6]; i++)
+    {
+      firebase_tls_session_cache_item_t item;
+      uint8_t len = 0;
+      char host[256];
+      uint8_t ts[4];
+      ok = readBytes(mbfs, type, &len, 1, sum) &&
+           readBytes(mbfs, type, reinterpret_cast<uint8_t *>(host), len, sum) &&
+           readBytes(mbfs, type, ts, 4, sum) &&
+           readBytes(mbfs, type, reinterpret_cast<uint8_t *>(&item.params), sizeof(br_ssl_session_parameters), sum);
+      if (ok)
+      {
+        host[len] = '\0';
+        item.host = host;
+        item.ts = ts[0] | (ts[1] << 8) | (ts[2] << 16) | ((uint32_t)ts[3] << 24);
+        items.push_back(item);
+      }
+    }
+
+    uint8_t stored[2];
+    uint16_t expected = sum;
+    ok = ok && readBytes(mbfs, type, stored, 2, sum) && (stored[0] | (stored[1] << 8)) == expected;
+
+    mbfs->close(type);
+
+    // The corrupted or incompatible file will be replaced on next save.
+    if (ok)
+      _items = items;
+
+    return true;
+  }
+
+  void save(MB_FS *mbfs, firebase_tls_session_cache_config_t *config)
+  {
+    mbfs_file_type type = mbfs_type config->storage_type;
+
+    if (mbfs->open(config->filename, type, mb_fs_open_mode_write) < 0)
+      return;
+
+    uint16_t sum = 0;
+    uint8_t header[7] = {'F', 'B', 'T', 'S', 1, (uint8_t)sizeof(br_ssl_session_parameters), (uint8_t)_items.size()};
+    bool ok = writeBytes(mbfs, type, header, sizeof(header), sum);
+
+    for (size_t i = 0; ok && i < _items.size(); i++)
+    {
+      uint8_t len = _items[i].host.length() < 255 ? _items[i].host.length() : 255;
+      uint32_t t = _items[i].ts;
+      uint8_t ts[4] = {(uint8_t)t, (uint8_t)(t >> 8), (uint8_t)(t >> 16), (uint8_t)(t >> 24)};
+      ok = writeBytes(mbfs, type, &len, 1, sum) &&
+           writeBytes(mbfs, type, reinterpret_cast<const uint8_t *>(_items[i].host.c_str()), len, sum) &&
+           writeBytes(mbfs, type, ts, 4, sum) &&
+           writeBytes(mbfs, type, reinterpret_cast<const uint8_t *>(&_items[i].params), sizeof(br_ssl_session_parameters), sum);
+    }
+
+    uint8_t stored[2] = {(uint8_t)sum, (uint8_t)(sum >> 8)};
+    if (ok)
+      ok = writeBytes(mbfs, type, stored, 2, sum);
+
+    mbfs->close(type);
+
+    if (ok)
+      _info.saves++;
+  }
+};
+
+struct firebase_mfln_cache_item_t
+{
+  MB_String host;
+  uint16_t port = 443;
+  bool supported = false;
+  unsigned long ms = 0;
+};
+
+/**
+ * The maximum fragment length negotiation (MFLN) support of each host that learned from the handshake of connection.
+ * The server that supports MFLN sends the smaller records that fit the small receive buffer.
+ * The host that is not supported will be learned again after MFLN_PROBE_RETRY_INTERVAL.
+ */
+class Firebase_MFLN_Cache
+{
+public:
+  Firebase_MFLN_Cache(){};
+  ~Firebase_MFLN_Cache(){};
+
+  /**
+   * Set the MFLN support of host that negotiated in the handshake of connection.
+   * @param host The host name.
+   * @param port The port.
+   * @param supported true when the server accepted the MFLN extension that the client offered.
+   */
+  void update(const char *host, uint16_t port, bool supported)
+  {
+    int index = find(host, port);
+    if (index >= 0)
+    {
+      _items[index].supported = supported;
+      _items[index].ms = millis();
+      return;
+    }
+
+    firebase_mfln_cache_item_t item;
+    item.host = host;
+    item.port = port;
+    item.supported = supported;
+    item.ms = millis();
+
+    while (_items.size() >= MAX_MFLN_CACHE_SIZE)
+      _items.erase(_items.begin());
+
+    _items.push_back(item);
+  }
+
+  /**
+   * Get the cached MFLN support of host.
+   * @param host The host name.
+   * @param port The port.
+   * @return 1 for supported, 0 for not supported or -1 for unknown.
+   */
+  int status(const char *host, uint16_t port)
+  {
+    int index = find(host, port);
+    return index < 0 ? -1 : _items[index].supported;
+  }
+
+private:
+  MB_VECTOR<firebase_mfln_cache_item_t> _items;
+
+  int find(const char *host, uint16_t port)
+  {
+    for (size_t i = 0; i < _items.size(); i++)
+    {
+      if (_items[i].port == port && strcmp(_items[i].host.c_str(), host) == 0)
+      {
+        if (!_items[i].supported && millis() - _items[i].ms >= MFLN_PROBE_RETRY_INTERVAL)
+        {
+          _items.erase(_items.begin() + i);
+          return -1;
+        }
+        return i;
+      }
+    }
+    return -1;
+  }
+};
+
+#define FIREBASE_TRUST_ANCHOR_DIGEST_SIZE 32
+
+struct firebase_trust_anchor_item_t
+{
+  // The SHA-256 and length of PEM certificate data, or the certificate file with its size and last write time.
+  uint8_t digest[FIREBASE_TRUST_ANCHOR_DIGEST_SIZE];
+  size_t size = 0;
+  time_t lastWrite = 0;
+  MB_String filename;
+  mbfs_file_type storageType = mbfs_undefined;
+  X509List *list = nullptr;
+  uint16_t refs = 0;
+};
+
+/**
+ * The decoded trust anchors of each certificate source that shared between clients.
+ * The certificates are decoded once and the trust anchors are freed when the last client released it.
+ *
+ * The PEM certificate data is identified by its SHA-256 and length, the certificate file is identified by its name,
+ * size and last write time.
+ *
+ * The DER file of PEM certificate data contains the "FBTA" header, version, number of certificates, PEM data length
+ * and its SHA-256, followed by [length][DER] of each certificate and the Fletcher-16 checksum of file content.
+ */
+class Firebase_Trust_Anchor_Store
+{
+public:
+  Firebase_Trust_Anchor_Store(){};
+  ~Firebase_Trust_Anchor_Store()
+  {
+    for (size_t i = 0; i < _items.size(); i++)
+      delete _items[i].list;
+  };
+
+  /**
+   * Get the trust anchors of PEM certificate data.
+   * @param mbfs The pointer to MB_FS.
+   * @param pem The PEM certificate data.
+   * @param derFile The file that keeps the decoded DER certificates or empty string for no file.
+   * @param derStorageType The storage type of DER file.
+   * @return The pointer to X509List that should be released when it is no longer used.
+   */
+  X509List *acquire(MB_FS *mbfs, const char *pem, const MB_String &derFile, mbfs_file_type derStorageType)
+  {
+    firebase_trust_anchor_item_t item;
+    item.size = digest(item.digest, pem);
+
+    int index = find(item);
+    if (index >= 0)
+      return share(index);
+
+    X509List *list = nullptr;
+    bool useFile = mbfs && derFile.length() > 0;
+
+    if (useFile)
+    {
+      list = loadDER(mbfs, derFile, derStorageType, item);
+      if (list)
+        _info.der_loads++;
+    }
+
+    if (!list)
+    {
+      list = new X509List(pem);
+      _info.decodes++;
+      if (useFile && list->getCount() > 0 && list->getCount() < 256)
+        saveDER(mbfs, derFile, derStorageType, item, list);
+    }
+
+    return add(item, list);
+  }
+
+  /**
+   * Get the trust anchors of certificate file.
+   * @param mbfs The pointer to MB_FS.
+   * @param filename The certificate file.
+   * @param storageType The storage type of certificate file.
+   * @return The pointer to X509List that should be released when it is no longer used or nullptr when file could not open.
+   */
+  X509List *acquireFile(MB_FS *mbfs, const MB_String &filename, mbfs_file_type storageType)
+  {
+    int len = mbfs->open(filename, storageType, mb_fs_open_mode_read);
+    if (len < 0)
+      return nullptr;
+
+    // the file that was changed after decoding is decoded again
+    firebase_trust_anchor_item_t item;
+    item.size = len;
+    item.lastWrite = mbfs->lastWrite(storageType);
+    item.filename = filename;
+    item.storageType = storageType;
+
+    int index = find(item);
+    if (index >= 0)
+    {
+      mbfs->close(storageType);
+      return share(index);
+    }
+
+    uint8_t *der = (uint8_t *)mbfs->newP(len);
+    if (mbfs->available(storageType))
+      mbfs->read(storageType, der, len);
+    mbfs->close(storageType);
+
+    X509List *list = new X509List(der, len);
+    mbfs->delP(&der);
+    _info.decodes++;
+
+    return add(item, list);
+  }
+
+  /**
+   * Release the trust anchors, the trust anchors will be freed when no client uses it.
+   * @param list The pointer to X509List that was acquired.
+   */
+  void release(X509List *list)
+  {
+    for (size_t i = 0; i < _items.size(); i++)
+    {
+      if (_items[i].list == list)
+      {
+        if (--_items[i].refs == 0)
+        {
+          delete _items[i].list;
+          _items.erase(_items.begin() + i);
+        }
+        return;
+      }
+    }
+  }
+
+  /**
+   * Get the store usage statistics.
+   * @return TrustAnchorStoreInfo.
+   */
+  TrustAnchorStoreInfo info()
+  {
+    _info.size = _items.size();
+    _info.anchors = 0;
+    for (size_t i = 0; i < _items.size(); i++)
+      _info.anchors += _items[i].list->getCount();
+    return _info;
+  }
+
+private:
+  MB_VECTOR<firebase_trust_anchor_item_t> _items;
+  TrustAnchorStoreInfo _info;
+
+  int find(const firebase_trust_anchor_item_t &item)
+  {
+    for (size_t i = 0; i < _items.size(); i++)
+    {
+      if (_items[i].size != item.size || _items[i].storageType != item.storageType)
+        continue;
+
+      if (item.storageType == mbfs_undefined ? memcmp(_items[i].digest, item.digest, sizeof(item.digest)) == 0
+                                             : (_items[i].lastWrite == item.lastWrite && strcmp(_items[i].filename.c_str(), item.filename.c_str()) == 0))
+        return i;
+    }
+    return -1;
+  }
+
+  X509List *share(int index)
+  {
+    _items[index].refs++;
+    _info.hits++;
+    return _items[index].list;
+  }
+
+  X509List *add(firebase_trust_anchor_item_t &item, X509List *list)
+  {
+    item.list = list;
+    item.refs = 1;
+    _items.push_back(item);
+    return list;
+  }
+
+  // The SHA-256 of PEM data that may be stored in flash (PROGMEM), returns the data length.
+  size_t digest(uint8_t *out, const char *pem)
+  {
+    size_t len = strlen_P(pem);
+    uint8_t buf[64];
+    br_sha256_context ctx;
+    br_sha256_init(&ctx);
+    for (size_t i = 0; i < len; i += sizeof(buf))
+    {
+      size_t n = len - i < sizeof(buf) ? len - i : sizeof(buf);
+      memcpy_P(buf, pem + i, n);
+      br_sha256_update(&ctx, buf, n);
+    }
+    br_sha256_out(&ctx, out);
+    return len;
+  }
+
+  // The header of DER file, "FBTA", version, number of certificates, PEM data length (4 bytes) and its SHA-256.
+  void setHeader(uint8_t *header, const firebase_trust_anchor_item_t &pem, uint8_t count)
+  {
+    memcpy(header, "FBTA", 4);
+    header[4] = 2;
+    header[5] = count;
+    for (int i = 0; i < 4; i++)
+      header[6 + i] = (uint8_t)(pem.size >> (8 * i));
+    memcpy(header + 10, pem.digest, FIREBASE_TRUST_ANCHOR_DIGEST_SIZE);
+  }
+
+  X509List *loadDER(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type, const firebase_trust_anchor_item_t &pem)
+  {
+    if (mbfs->open(filename, type, mb_fs_open_mode_read) <= 0)
+      return nullptr;
+
+    uint16_t sum = 0;
+    uint8_t header[10 + FIREBASE_TRUST_ANCHOR_DIGEST_SIZE] = {0}, expected[sizeof(header)];
+    bool ok = mbfs->read(type, header, sizeof(header)) == (int)sizeof(header);
+
+    // the count of expected header is taken from file, other fields should be matched
+    setHeader(expected, pem, header[5]);
+    ok = ok && header[5] > 0 && memcmp(header, expected, sizeof(header)) == 0;
+
+    if (ok)
+      sum = FBUtils::fletcher16(header, sizeof(header), sum);
+
+    X509List *list = ok ? new X509List() : nullptr;
+
+    for (uint8_t i = 0; ok && i < header[5]; i++)
+    {
+      uint8_t len[2];
+      ok = mbfs->read(type, len, 2) == 2;
+      if (!ok)
+        break;
+
+      sum = FBUtils::fletcher16(len, 2, sum);
+      size_t derLen = len[0] | (len[1] << 8);
+      uint8_t *der = (uint8_t *)mbfs->newP(derLen);
+      ok = der && mbfs->read(type, der, derLen) == (int)derLen;
+      if (ok)
+      {
+        sum = FBUtils::fletcher16(der, derLen, sum);
+        ok = list->append(der, derLen);
+      }
+      mbfs->delP(&der);
+    }
+
+    uint8_t stored[2];
+    ok = ok && mbfs->read(type, stored, 2) == 2 && (stored[0] | (stored[1] << 8)) == sum;
+
+    mbfs->close(type);
+
+    // The corrupted or outdated file will be replaced after decoding the PEM data.
+    if (!ok && list)
+    {
+      delete list;
+      list = nullptr;
+    }
+
+    return list;
+  }
+
+  void saveDER(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type, const firebase_trust_anchor_item_t &pem, X509List *list)
+  {
+    if (mbfs->open(filename, type, mb_fs_open_mode_write) < 0)
+      return;
+
+    uint16_t sum = 0;
+    uint8_t header[10 + FIREBASE_TRUST_ANCHOR_DIGEST_SIZE];
+    setHeader(header, pem, list->getCount());
+    sum = FBUtils::fletcher16(header, sizeof(header), sum);
+    bool ok = mbfs->write(type, header, sizeof(header)) == (int)sizeof(header);
+
+    const br_x509_certificate *certs = list->getX509Certs();
+    for (size_t i = 0; ok && i < list->getCount(); i++)
+    {
+      uint8_t len[2] = {(uint8_t)certs[i].data_len, (uint8_t)(certs[i].data_len >> 8)};
+      sum = FBUtils::fletcher16(len, 2, sum);
+      sum = FBUtils::fletcher16(certs[i].data, certs[i].data_len, sum);
+      ok = mbfs->write(type, len, 2) == 2 &&
+           mbfs->write(type, certs[i].data, certs[i].data_len) == (int)certs[i].data_len;
+    }
+
+    uint8_t stored[2] = {(uint8_t)sum, (uint8_t)(sum >> 8)};
+    if (ok)
+      mbfs->write(type, stored, 2);
+
+    mbfs->close(type);
+  }
+};
+
 class Firebase_TCP_Client : public Client
 {
   friend class FirebaseCore;
+  friend class Firebase_TCP_Client_Pool;
 
 public:
   Firebase_TCP_Client()
@@ -100,6 +715,8 @@ public:
   virtual ~Firebase_TCP_Client()
   {
     clear();
+    clearReadBuffer(true);
+    freeTrustAnchors();
     if (_tcp_client)
       delete (ESP_SSLClient *)_tcp_client;
     _tcp_client = nullptr;
@@ -166,15 +783,31 @@ public:
   /**
    * Set Root CA certificate to verify.
    * @param caCert The certificate.
+   * @param store The optional pointer to trust anchor store that shares the decoded certificate between clients.
    */
-  void setCACert(const char *caCert)
+  void setCACert(const char *caCert, Firebase_Trust_Anchor_Store *store = nullptr)
   {
     if (caCert)
     {
-      if (_x509)
-        delete _x509;
+      X509List *x509 = nullptr;
+      if (store)
+      {
+        MB_String derFile;
+        mbfs_file_type derStorageType = mbfs_undefined;
+        if (_config)
+        {
+          derFile = _config->cert.der_file;
+          derStorageType = mbfs_type _config->cert.der_file_storage;
+        }
+        x509 = store->acquire(_mbfs, caCert, derFile, derStorageType);
+      }
+      else
+        x509 = new X509List(caCert);
 
-      _x509 = new X509List(caCert);
+      // Release after acquiring, the trust anchors of the same certificate will not be decoded again.
+      freeTrustAnchors();
+      _x509 = x509;
+      _ta_store = store;
       _tcp_client->setTrustAnchors(_x509);
 
       setCertType(firebase_cert_type_data);
@@ -183,6 +816,7 @@ public:
     {
       setCertType(firebase_cert_type_none);
       setInSecure();
+      freeTrustAnchors();
     }
   }
 
@@ -190,9 +824,10 @@ public:
    * Set Root CA certificate to verify.
    * @param certFile The certificate file path.
    * @param storageType The storage type mb_fs_mem_storage_type_flash or mb_fs_mem_storage_type_sd.
+   * @param store The optional pointer to trust anchor store that shares the decoded certificate between clients.
    * @return true when certificate loaded successfully.
    */
-  bool setCertFile(const char *certFile, mb_fs_mem_storage_type storageType)
+  bool setCertFile(const char *certFile, mb_fs_mem_storage_type storageType, Firebase_Trust_Anchor_Store *store = nullptr)
   {
     if (!_mbfs)
       return false;
@@ -206,6 +841,20 @@ public:
           filename.prepend('/');
       }
 
+      if (store)
+      {
+        X509List *x509 = store->acquireFile(_mbfs, filename, storageType);
+        if (x509)
+        {
+          freeTrustAnchors();
+          _x509 = x509;
+          _ta_store = store;
+          _tcp_client->setTrustAnchors(_x509);
+          setCertType(firebase_cert_type_file);
+        }
+        return getCertType() == firebase_cert_type_file;
+      }
+
       int len = _mbfs->open(filename, storageType, mb_fs_open_mode_read);
       if (len > -1)
       {
@@ -214,8 +863,7 @@ public:
           _mbfs->read(storageType, der, len);
         _mbfs->close(storageType);
 
-        if (_x509)
-          delete _x509;
+        freeTrustAnchors();
 
         _x509 = new X509List(der, len);
         _tcp_client->setTrustAnchors(_x509);
@@ -537,6 +1185,55 @@ public:
     _tx_size = tx;
   }
 
+  /**
+   * Set the workload of next request for adaptive SSL I/O buffer sizing (config.bssl_buffer.adaptive).
+   * @param profile The firebase_bssl_buffer_profile enum.
+   * @param cache The pointer to MFLN support cache.
+   */
+  void setBufferProfile(firebase_bssl_buffer_profile profile, Firebase_MFLN_Cache *cache)
+  {
+    _buffer_profile = profile;
+    _mfln_cache = cache;
+  }
+
+  /**
+   * Get the SSL I/O buffer sizes that the new connection will use.
+   * @param rx The receive buffer size.
+   * @param tx The transmit buffer size.
+   */
+  void getBufferSizes(int &rx, int &tx)
+  {
+    getBufferSizes(_host.c_str(), _port, rx, tx);
+  }
+
+  /**
+   * Check whether the current connection buffers can't hold the records of the workload of next request.
+   * @return true when the connection should be closed to use the new buffer sizes.
+   *
+   * @note The open connection is kept when its buffers are larger or smaller than the workload requires,
+   * as long as it can receive the records, to avoid the full SSL handshake of new connection.
+   */
+  bool isBufferResizeRequired()
+  {
+    return connected() && !isBufferFitted(this);
+  }
+
+  /**
+   * Check whether the connection of other client can hold the records of the workload of next request.
+   * @param other The pointer to other client e.g. the pooled client.
+   * @return true when the connection buffers fit.
+   */
+  bool isBufferFitted(Firebase_TCP_Client *other)
+  {
+    // The server that supports MFLN sends the records that fit the receive buffer of connection.
+    if (!isAdaptiveBuffer() || _mfln_cache->status(other->_host.c_str(), other->_port) == 1)
+      return true;
+
+    int rx = 0, tx = 0;
+    getBufferSizes(other->_host.c_str(), other->_port, rx, tx);
+    return other->_conn_rx_size >= rx;
+  }
+
   operator bool()
   {
     return connected();
@@ -585,9 +1282,36 @@ public:
 
     _tcp_client->setClient(_basic_client);
     _tcp_client->setDebugLevel(2);
+
+    // Offer the persisted session of host when client has no session e.g. after reboot.
+    uint8_t offeredID[32];
+    uint8_t offeredLen = 0;
+    firebase_tls_session_cache_config_t *cacheConfig = _config ? &_config->tls_session_cache : nullptr;
+
+    if (_session && _session_cache)
+    {
+      _session_cache->restore(_mbfs, _host.c_str(), _session, cacheConfig);
+      offeredLen = _session->getSession()->session_id_len;
+      if (offeredLen > sizeof(offeredID))
+        offeredLen = 0;
+      memcpy(offeredID, _session->getSession()->session_id, offeredLen);
+    }
+
+    // The buffers are allocated by SSL client on connect.
+    // The host of unknown MFLN support is connected with the buffer sizes from FirebaseData::setBSSLBufferSize.
+    getBufferSizes(_conn_rx_size, _conn_tx_size);
+    _tcp_client->setBufferSizes(_conn_rx_size, _conn_tx_size);
+
     if (!_tcp_client->connect(_host.c_str(), _port))
       return setError(FIREBASE_ERROR_TCP_ERROR_CONNECTION_REFUSED);
 
+    // The MFLN extension is offered in the handshake unless both buffers can hold the maximum record with its overhead.
+    if (isAdaptiveBuffer() && (_conn_rx_size <= ADAPTIVE_BSSL_MAX_RX_SIZE || _conn_tx_size <= ADAPTIVE_BSSL_MAX_RX_SIZE))
+      _mfln_cache->update(_host.c_str(), _port, _tcp_client->getMFLNStatus() == 1);
+
+    if (_session && _session_cache)
+      _session_cache->update(_mbfs, _host.c_str(), _session, offeredID, offeredLen, cacheConfig);
+
 #if defined(FIREBASE_WIFI_IS_AVAILABLE) && (defined(ESP32) || defined(ESP8266) || defined(MB_ARDUINO_PICO))
     if (_client_type == firebase_client_type_internal_basic_client)
     {
@@ -647,6 +1371,7 @@ public:
    */
   void stop()
   {
+    clearReadBuffer(true);
     if (_tcp_client)
       _tcp_client->stop();
   }
@@ -693,6 +1418,84 @@ public:
     return size;
   }
 
+  /**
+   * The TCP data gather write function.
+   * @param iov The array of data buffers to send.
+   * @param count The number of data buffers.
+   * @return The size of data that was successfully sent or negative value for error.
+   * @note All buffers are encrypted in as few TLS records as possible.
+   */
+  int writev(const esp_ssl_iovec_t *iov, size_t count)
+  {
+    if (!_tcp_client)
+      return setError(FIREBASE_ERROR_TCP_CLIENT_NOT_INITIALIZED);
+
+    size_t size = 0;
+    for (size_t i = 0; iov && i < count; i++)
+      size += iov[i].len;
+
+    if (size == 0)
+      return setError(FIREBASE_ERROR_TCP_ERROR_SEND_REQUEST_FAILED);
+
+    if (!networkReady())
+      return setError(FIREBASE_ERROR_TCP_ERROR_NOT_CONNECTED);
+
+    if (!_tcp_client->connected() && !connect())
+      return setError(FIREBASE_ERROR_TCP_ERROR_CONNECTION_REFUSED);
+
+#if defined(ESP_SSLCLIENT_HAS_WRITEV)
+    if (_tcp_client->writev(iov, count) != size)
+      return setError(FIREBASE_ERROR_TCP_ERROR_SEND_REQUEST_FAILED);
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+      if (iov[i].len > 0 && _tcp_client->write(iov[i].data, iov[i].len) != iov[i].len)
+        return setError(FIREBASE_ERROR_TCP_ERROR_SEND_REQUEST_FAILED);
+    }
+#endif
+
+    setError(FIREBASE_ERROR_HTTP_CODE_OK);
+
+    return size;
+  }
+
+  /**
+   * Reset the statistics of sent TLS records and bytes.
+   */
+  void resetSendStats()
+  {
+#if defined(ESP_SSLCLIENT_HAS_WRITEV)
+    if (_tcp_client)
+      _tcp_client->resetSendStats();
+#endif
+  }
+
+  /**
+   * Get the number of TLS records (or TCP writes for non-secure connection) that were sent since resetSendStats.
+   * @return The number of records.
+   */
+  uint32_t sentRecords()
+  {
+#if defined(ESP_SSLCLIENT_HAS_WRITEV)
+    if (_tcp_client)
+      return _tcp_client->sentRecords();
+#endif
+    return 0;
+  }
+
+  /**
+   * Get the number of bytes that were sent on wire (including TLS handshake and record overhead) since resetSendStats.
+   * @return The number of bytes.
+   */
+  uint32_t sentBytes()
+  {
+#if defined(ESP_SSLCLIENT_HAS_WRITEV)
+    if (_tcp_client)
+      return _tcp_client->sentBytes();
+#endif
+    return 0;
+  }
+
   size_t write(uint8_t v)
   {
     uint8_t buf[1];
@@ -765,6 +1568,10 @@ public:
     if (!_tcp_client)
       return setError(FIREBASE_ERROR_TCP_CLIENT_NOT_INITIALIZED);
 
+    // The buffered data can be read without updating the SSL engine.
+    if (_rx_buf_len > _rx_buf_pos)
+      return _rx_buf_len - _rx_buf_pos;
+
     return _tcp_client->available();
   }
 
@@ -777,7 +1584,10 @@ public:
     if (!_basic_client)
       return setError(FIREBASE_ERROR_TCP_CLIENT_NOT_INITIALIZED);
 
-    return _tcp_client->read();
+    if (_rx_buf_len == _rx_buf_pos && fillReadBuffer() <= 0)
+      return -1;
+
+    return _rx_buf[_rx_buf_pos++];
   }
 
   int read(uint8_t *buf, size_t len)
@@ -796,7 +1606,37 @@ public:
     if (!_basic_client)
       return setError(FIREBASE_ERROR_TCP_CLIENT_NOT_INITIALIZED);
 
-    return _tcp_client->read(buf, len);
+    if (len <= 0)
+      return 0;
+
+    int read = 0;
+
+    while (read < len)
+    {
+      if (_rx_buf_len == _rx_buf_pos)
+      {
+        // The large block can be read from SSL client directly without copying through the receive buffer.
+        if (len - read >= DEFAULT_TCP_READ_BUFFER_SIZE)
+        {
+          int ret = _tcp_client->available() > 0 ? _tcp_client->read(buf + read, len - read) : 0;
+          if (ret > 0)
+            read += ret;
+          break;
+        }
+
+        if (fillReadBuffer() <= 0)
+          break;
+      }
+
+      int n = _rx_buf_len - _rx_buf_pos;
+      if (n > len - read)
+        n = len - read;
+      memcpy(buf + read, _rx_buf + _rx_buf_pos, n);
+      _rx_buf_pos += n;
+      read += n;
+    }
+
+    return read > 0 ? read : -1;
   }
 
   /**
@@ -815,10 +1655,66 @@ public:
    */
   void flush()
   {
+    clearReadBuffer(false);
     if (_tcp_client && _tcp_client->connected())
       _tcp_client->flush();
   }
 
+#if defined(FIREBASE_HAS_PEEK_BUFFER_API)
+
+  bool hasPeekBufferAPI() const override { return true; }
+
+  /**
+   * Get the number of bytes that can be accessed directly from peekBuffer.
+   * @return The number of bytes.
+   */
+  size_t peekAvailable() override
+  {
+    if (!_basic_client)
+      return 0;
+
+    if (_rx_buf_len > _rx_buf_pos)
+      return _rx_buf_len - _rx_buf_pos;
+
+    return _tcp_client->peekAvailable();
+  }
+
+  /**
+   * Get the pointer to the receive buffer of SSL engine, it can be nullptr when SSL was not enabled.
+   * @return The pointer to data buffer (size = peekAvailable()).
+   */
+  const char *peekBuffer() override
+  {
+    if (!_basic_client)
+      return nullptr;
+
+    if (_rx_buf_len > _rx_buf_pos)
+      return (const char *)_rx_buf + _rx_buf_pos;
+
+    return _tcp_client->peekBuffer();
+  }
+
+  /**
+   * Consume the bytes in receive buffer after accessed by peekBuffer.
+   * @param consume The number of bytes to consume.
+   */
+  void peekConsume(size_t consume) override
+  {
+    if (!_basic_client)
+      return;
+
+    if (_rx_buf_len > _rx_buf_pos)
+    {
+      size_t len = _rx_buf_len - _rx_buf_pos;
+      _rx_buf_pos += consume < len ? consume : len;
+      return;
+    }
+
+    _tcp_client->peekConsume(consume);
+  }
+
+#endif
+
   /**
    * Set the network status which should call in side the networkStatusRequestCallback function.
    * @param status The status of network.
@@ -832,6 +1728,10 @@ public:
   {
     if (!_tcp_client)
       return 0;
+
+    if (_rx_buf_len > _rx_buf_pos)
+      return _rx_buf[_rx_buf_pos];
+
     return _tcp_client->peek();
   }
 
@@ -1127,8 +2027,15 @@ public:
     _tcp_client->setInsecure();
   }
 
-  void setSession(BearSSL_Session *session)
+  /**
+   * Set the SSL session to resume.
+   * @param session The pointer to BearSSL session.
+   * @param cache The optional pointer to cache that keeps the session of each host across reboots.
+   */
+  void setSession(BearSSL_Session *session, Firebase_TLS_Session_Cache *cache = nullptr)
   {
+    _session = session;
+    _session_cache = cache;
     _tcp_client->setSession(session);
   }
 
@@ -1152,6 +2059,14 @@ private:
 
   ESP_SSLClient *_tcp_client = nullptr;
   X509List *_x509 = nullptr;
+  // The store that shares the trust anchors (_x509) or nullptr when _x509 is owned.
+  Firebase_Trust_Anchor_Store *_ta_store = nullptr;
+  BearSSL_Session *_session = nullptr;
+  Firebase_TLS_Session_Cache *_session_cache = nullptr;
+  Firebase_MFLN_Cache *_mfln_cache = nullptr;
+  firebase_bssl_buffer_profile _buffer_profile = firebase_bssl_buffer_profile_request;
+  // The SSL I/O buffer sizes of current connection.
+  int _conn_rx_size = 0, _conn_tx_size = 0;
 
   MB_String _host;
   uint16_t _port = 443;
@@ -1180,6 +2095,9 @@ private:
   int _last_error = 0;
   volatile bool _network_status = false;
   int _rx_size = 1024, _tx_size = 512;
+  // The receive buffer that the server response was read into in block.
+  uint8_t *_rx_buf = nullptr;
+  uint16_t _rx_buf_pos = 0, _rx_buf_len = 0;
   int *response_code = nullptr;
   FirebaseConfig *_config = nullptr;
   FirebaseAuth *_auth = nullptr;
@@ -1187,6 +2105,286 @@ private:
   firebase_cert_type _cert_type = firebase_cert_type_undefined;
   firebase_client_type _client_type = firebase_client_type_undefined;
   SPI_ETH_Module *eth = NULL;
+
+  // Read all available data (up to the receive buffer size) from SSL client in single call.
+  int fillReadBuffer()
+  {
+    int avail = _tcp_client->available();
+    if (avail <= 0)
+      return avail;
+
+    if (!_rx_buf)
+      _rx_buf = new uint8_t[DEFAULT_TCP_READ_BUFFER_SIZE];
+
+    if (avail > DEFAULT_TCP_READ_BUFFER_SIZE)
+      avail = DEFAULT_TCP_READ_BUFFER_SIZE;
+
+    int ret = _tcp_client->read(_rx_buf, avail);
+    _rx_buf_pos = 0;
+    _rx_buf_len = ret > 0 ? ret : 0;
+    return ret;
+  }
+
+  void freeTrustAnchors()
+  {
+    if (_x509)
+    {
+      if (_ta_store)
+        _ta_store->release(_x509);
+      else
+        delete _x509;
+    }
+    _x509 = nullptr;
+    _ta_store = nullptr;
+  }
+
+  bool isAdaptiveBuffer()
+  {
+    return _mfln_cache && _config && _config->bssl_buffer.adaptive;
+  }
+
+  // Get the SSL I/O buffer sizes of the connection to host for the workload.
+  void getBufferSizes(const char *host, uint16_t port, int &rx, int &tx)
+  {
+    rx = _rx_size;
+    tx = _tx_size;
+
+    if (!isAdaptiveBuffer())
+      return;
+
+    int mfln = _mfln_cache->status(host, port);
+
+    if (mfln == 1)
+    {
+      // The server sends the records that are not larger than the receive buffer.
+      rx = _buffer_profile == firebase_bssl_buffer_profile_stream
+               ? ADAPTIVE_BSSL_STREAM_RX_SIZE
+           : _buffer_profile == firebase_bssl_buffer_profile_request
+               ? ADAPTIVE_BSSL_REQUEST_RX_SIZE
+               : ADAPTIVE_BSSL_TRANSFER_SIZE;
+      tx = _buffer_profile == firebase_bssl_buffer_profile_upload ? ADAPTIVE_BSSL_TRANSFER_SIZE : ADAPTIVE_BSSL_TX_SIZE;
+    }
+    else if (mfln == 0)
+    {
+      // The server can send the record up to 16k.
+      if (_buffer_profile == firebase_bssl_buffer_profile_download)
+        rx = ADAPTIVE_BSSL_MAX_RX_SIZE;
+      else if (_buffer_profile == firebase_bssl_buffer_profile_upload)
+        tx = ADAPTIVE_BSSL_TRANSFER_SIZE;
+    }
+  }
+
+  // Discard the unread buffered data and free the receive buffer if required.
+  void clearReadBuffer(bool release)
+  {
+    _rx_buf_pos = 0;
+    _rx_buf_len = 0;
+    if (release && _rx_buf)
+    {
+      delete[] _rx_buf;
+      _rx_buf = nullptr;
+    }
+  }
+
+  // Exchange the SSL client and its network client (the connection), the trust anchors that the SSL client
+  // refers to and the connected host with other client.
+  void swapConnection(Firebase_TCP_Client *other)
+  {
+    // The buffered data belongs to the connection.
+    uint8_t *rx_buf = _rx_buf;
+    _rx_buf = other->_rx_buf;
+    other->_rx_buf = rx_buf;
+
+    uint16_t rx_buf_pos = _rx_buf_pos;
+    _rx_buf_pos = other->_rx_buf_pos;
+    other->_rx_buf_pos = rx_buf_pos;
+
+    uint16_t rx_buf_len = _rx_buf_len;
+    _rx_buf_len = other->_rx_buf_len;
+    other->_rx_buf_len = rx_buf_len;
+
+    ESP_SSLClient *tcp_client = _tcp_client;
+    _tcp_client = other->_tcp_client;
+    other->_tcp_client = tcp_client;
+
+    Client *basic_client = _basic_client;
+    _basic_client = other->_basic_client;
+    other->_basic_client = basic_client;
+
+    // The SSL client keeps the pointer to trust anchors, they are owned (released) by the client that holds it.
+    X509List *x509 = _x509;
+    _x509 = other->_x509;
+    other->_x509 = x509;
+
+    Firebase_Trust_Anchor_Store *ta_store = _ta_store;
+    _ta_store = other->_ta_store;
+    other->_ta_store = ta_store;
+
+    firebase_cert_type cert_type = _cert_type;
+    _cert_type = other->_cert_type;
+    other->_cert_type = cert_type;
+
+    MB_String host = _host;
+    _host = other->_host;
+    other->_host = host;
+
+    uint16_t port = _port;
+    _port = other->_port;
+    other->_port = port;
+
+    int conn_rx_size = _conn_rx_size;
+    _conn_rx_size = other->_conn_rx_size;
+    other->_conn_rx_size = conn_rx_size;
+
+    int conn_tx_size = _conn_tx_size;
+    _conn_tx_size = other->_conn_tx_size;
+    other->_conn_tx_size = conn_tx_size;
+  }
+};
+
+struct firebase_pooled_client_t
+{
+  Firebase_TCP_Client *client = nullptr;
+  unsigned long last_used_ms = 0;
+};
+
+/**
+ * The pool of idle kept-alive server connections that shared between clients.
+ * Only the connection of internal network client can be pooled.
+ */
+class Firebase_TCP_Client_Pool
+{
+public:
+  Firebase_TCP_Client_Pool(){};
+  ~Firebase_TCP_Client_Pool() { clear(); };
+
+  /**
+   * Take the pooled connection to host for client.
+   * @param client The client that takes the connection, its current connection will be closed.
+   * @param host The host name.
+   * @param port The port.
+   * @param config The pointer to connection pool config.
+   * @return true when the pooled connection was taken.
+   */
+  bool acquire(Firebase_TCP_Client *client, const char *host, uint16_t port, firebase_connection_pool_config_t *config)
+  {
+    if (!client || !config || !config->enable)
+      return false;
+
+    if (client->_client_type != firebase_client_type_internal_basic_client &&
+        client->_client_type != firebase_client_type_undefined)
+      return false;
+
+    evict(config);
+
+    for (size_t i = 0; i < _clients.size(); i++)
+    {
+      Firebase_TCP_Client *pooled = _clients[i].client;
+      if (pooled->_port == port && strcmp(pooled->_host.c_str(), host) == 0 && client->isBufferFitted(pooled))
+      {
+        // The previous connection of client will be closed with the pooled client
+        client->swapConnection(pooled);
+        client->_client_type = firebase_client_type_internal_basic_client;
+        remove(i);
+        _info.hits++;
+        return true;
+      }
+    }
+
+    _info.misses++;
+    return false;
+  }
+
+  /**
+   * Return the idle connection of client to pool.
+   * @param client The client that returns its connection.
+   * @param config The pointer to connection pool config.
+   * @return true when the connection was kept in pool.
+   *
+   * @note The client will take the new unconnected SSL client when its connection was kept in pool.
+   */
+  bool release(Firebase_TCP_Client *client, firebase_connection_pool_config_t *config)
+  {
+    if (!client || !config || !config->enable ||
+        client->_client_type != firebase_client_type_internal_basic_client ||
+        client->_host.length() == 0 || !client->connected() || client->available() > 0)
+      return false;
+
+    evict(config);
+
+    uint8_t maxSize = config->max_connections;
+    if (maxSize < 1 || maxSize > MAX_CONNECTION_POOL_SIZE)
+      maxSize = DEFAULT_CONNECTION_POOL_SIZE;
+
+    // The least recently used connection is at the front
+    while (_clients.size() >= maxSize)
+    {
+      remove(0);
+      _info.evictions++;
+    }
+
+    firebase_pooled_client_t pooled;
+    pooled.client = new Firebase_TCP_Client();
+    pooled.client->_client_type = firebase_client_type_internal_basic_client;
+    pooled.client->swapConnection(client);
+    // The session cache belongs to client
+    pooled.client->_tcp_client->setSession(nullptr);
+    pooled.last_used_ms = millis();
+    _clients.push_back(pooled);
+
+    return true;
+  }
+
+  /**
+   * Close the pooled connections that were disconnected or idle time out.
+   * @param config The pointer to connection pool config.
+   */
+  void evict(firebase_connection_pool_config_t *config)
+  {
+    unsigned long idleTimeout = config ? config->idle_timeout : 0;
+
+    for (int i = (int)_clients.size() - 1; i >= 0; i--)
+    {
+      if (!_clients[i].client->connected() || millis() - _clients[i].last_used_ms > idleTimeout)
+      {
+        remove(i);
+        _info.evictions++;
+      }
+    }
+  }
+
+  /**
+   * Close all pooled connections.
+   */
+  void clear()
+  {
+    for (int i = (int)_clients.size() - 1; i >= 0; i--)
+      remove(i);
+  }
+
+  /**
+   * Get the pool usage statistics.
+   * @return ConnectionPoolInfo.
+   */
+  ConnectionPoolInfo info()
+  {
+    _info.size = _clients.size();
+    return _info;
+  }
+
+private:
+  MB_VECTOR<firebase_pooled_client_t> _clients;
+  ConnectionPoolInfo _info;
+
+  void remove(size_t index)
+  {
+    if (_clients[index].client)
+    {
+      _clients[index].client->stop();
+      delete _clients[index].client;
+    }
+    _clients.erase(_clients.begin() + index);
+  }
 };
 
 #endif /* Firebase_TCP_Client_H */
@@ -55,6 +55,19 @@ enum esp_ssl_client_error_types
     esp_ssl_internal_error
 };
 
+// The local patch of this vendored ESP_SSLClient copy which is not in the upstream library.
+// The gather write (writev) and the send statistics (resetSendStats, sentRecords and sentBytes)
+// were added to BSSL_SSL_Client and BSSL_TCP_Client, and Firebase_TCP_Client uses them when this macro was defined.
+// This patch should be kept when the vendored sources are updated.
+#define ESP_SSLCLIENT_HAS_WRITEV
+
+// The data buffer of gather write.
+struct esp_ssl_iovec_t
+{
+    const uint8_t *data = nullptr;
+    size_t len = 0;
+};
+
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
 
 static void esp_ssl_debug_print_prefix(const char *func_name, int level)
@@ -5,6 +5,8 @@
  *
  * This work contains codes based on WiFiClientSecure from Earle F. Philhower and SSLClient from OSU OPEnS Lab.
  *
+ * This copy was patched with the gather write and send statistics, see ESP_SSLCLIENT_HAS_WRITEV.
+ *
  * Copyright (c) 2018 Earle F. Philhower, III
  *
  * Copyright 2019 OSU OPEnS Lab
@@ -303,7 +305,11 @@ size_t BSSL_SSL_Client::write(const uint8_t *buf, size_t size)
     _session_ts = millis();
 
     if (!_secure)
-        return _basic_client->write(buf, size);
+    {
+        size_t sent = _basic_client->write(buf, size);
+        mCountSent(sent);
+        return sent;
+    }
 
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
     // super debug
@@ -323,6 +329,120 @@ size_t BSSL_SSL_Client::write(const uint8_t *buf, size_t size)
 #endif
         return 0;
     }
+
+    return mWriteApp(buf, size, func_name);
+}
+
+size_t BSSL_SSL_Client::writev(const esp_ssl_iovec_t *iov, size_t count)
+{
+    if (!mIsClientInitialized(false))
+        return 0;
+
+    if (!mCheckSessionTimeout())
+        return 0;
+
+    _session_ts = millis();
+
+    if (!iov)
+        return 0;
+
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++)
+        size += iov[i].len;
+
+    if (!size)
+        return 0;
+
+    // The size of data buffers that were completely written is returned when error occurred.
+    size_t sent = 0;
+
+    if (!_secure)
+    {
+        // the buffers are written in sequence, the small writes are coalesced by the TCP stack
+        for (size_t i = 0; i < count; i++)
+        {
+            if (iov[i].len == 0)
+                continue;
+            size_t len = _basic_client->write(iov[i].data, iov[i].len);
+            mCountSent(len);
+            sent += len;
+            if (len != iov[i].len)
+                break;
+        }
+        return sent;
+    }
+
+    const char *func_name = __func__;
+    if (!mSoftConnected(func_name))
+        return 0;
+
+    // the engine was updated once, all buffers were added to the bearssl io buffer
+    // and encrypted in as few records as the buffer size allowed.
+    if (mRunUntil(BR_SSL_SENDAPP) < 0)
+    {
+#if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
+        esp_ssl_debug_print(PSTR("Failed while waiting for the engine to enter BR_SSL_SENDAPP."), _debug_level, esp_ssl_debug_error, func_name);
+#endif
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+#if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
+        // super debug
+        if (_debug_level >= esp_ssl_debug_dump)
+            ESP_SSLCLIENT_DEBUG_PORT.write(iov[i].data, iov[i].len);
+#endif
+        if (iov[i].len > 0 && mWriteApp(iov[i].data, iov[i].len, func_name) != iov[i].len)
+            return sent;
+        sent += iov[i].len;
+    }
+
+    return sent;
+}
+
+void BSSL_SSL_Client::resetSendStats()
+{
+    _sent_records = 0;
+    _sent_bytes = 0;
+}
+
+void BSSL_SSL_Client::mCountRecords(const unsigned char *buf, size_t len, size_t sent)
+{
+    // The records in the engine output buffer are complete, the record length is read
+    // from its 5-byte header when its first byte is sent.
+    size_t pos = 0;
+    while (pos < sent)
+    {
+        if (_send_rec_left == 0)
+        {
+            if (pos + 5 > len)
+                break;
+            _send_rec_left = 5 + ((buf[pos + 3] << 8) | buf[pos + 4]);
+            _sent_records++;
+        }
+
+        size_t n = sent - pos < _send_rec_left ? sent - pos : _send_rec_left;
+        _send_rec_left -= n;
+        pos += n;
+    }
+}
+
+uint32_t BSSL_SSL_Client::sentRecords() const { return _sent_records; }
+
+uint32_t BSSL_SSL_Client::sentBytes() const { return _sent_bytes; }
+
+void BSSL_SSL_Client::mCountSent(size_t len)
+{
+    if (len > 0)
+    {
+        _sent_records++;
+        _sent_bytes += len;
+    }
+}
+
+size_t BSSL_SSL_Client::mWriteApp(const uint8_t *buf, size_t size, const char *func_name)
+{
     // add to the bearssl io buffer, simply appending whatever we want to write
     size_t alen;
     unsigned char *br_buf = br_ssl_engine_sendapp_buf(_eng, &alen);
@@ -1438,6 +1558,7 @@ int BSSL_SSL_Client::mConnectBasicClient(const char *host, IPAddress ip, uint16_
 
     _secure = false;
     _write_idx = 0;
+    _send_rec_left = 0;
 #if defined(ESP_SSLCLIENT_ENABLE_DEBUG)
     esp_ssl_debug_print(PSTR("Basic client connected!"), _debug_level, esp_ssl_debug_info, __func__);
 #endif
@@ -1838,7 +1959,9 @@ unsigned BSSL_SSL_Client::mUpdateEngine()
             }
             if (wlen > 0)
             {
+                mCountRecords(buf, len, wlen);
                 br_ssl_engine_sendrec_ack(_eng, wlen);
+                _sent_bytes += wlen;
             }
             continue;
         }
@@ -5,6 +5,8 @@
  *
  * This work contains codes based on WiFiClientSecure from Earle F. Philhower and SSLClient from OSU OPEnS Lab.
  *
+ * This copy was patched with the gather write and send statistics, see ESP_SSLCLIENT_HAS_WRITEV.
+ *
  * Copyright (c) 2018 Earle F. Philhower, III
  *
  * Copyright 2019 OSU OPEnS Lab
@@ -142,6 +144,14 @@ public:
 
     size_t write(Stream &stream);
 
+    size_t writev(const esp_ssl_iovec_t *iov, size_t count);
+
+    void resetSendStats();
+
+    uint32_t sentRecords() const;
+
+    uint32_t sentBytes() const;
+
     int peek() override;
 
     size_t peekBytes(uint8_t *buffer, size_t length);
@@ -294,6 +304,12 @@ private:
 
     uint8_t *mStreamLoad(Stream &stream, size_t size);
 
+    size_t mWriteApp(const uint8_t *buf, size_t size, const char *func_name);
+
+    void mCountSent(size_t len);
+
+    void mCountRecords(const unsigned char *buf, size_t len, size_t sent);
+
     void *mallocImpl(size_t len, bool clear = true);
 
     void freeImpl(void *ptr);
@@ -310,6 +326,12 @@ private:
     //  weird timing issues
     size_t _write_idx = 0;
 
+    // the number of records (or TCP writes in plain mode) and bytes that were sent since resetSendStats
+    uint32_t _sent_records = 0;
+    uint32_t _sent_bytes = 0;
+    // the bytes of the current outgoing record that were not sent
+    size_t _send_rec_left = 0;
+
     // store the last BearSSL state so we can print changes to the console
     unsigned int _bssl_last_state = 0;
 
@@ -3,6 +3,8 @@
  *
  * Created December 5, 2024
  *
+ * This copy was patched with the gather write and send statistics, see ESP_SSLCLIENT_HAS_WRITEV.
+ *
  * The MIT License (MIT)
  * Copyright (c) 2023 K. Suwatchai (Mobizt)
  *
@@ -231,6 +233,19 @@ size_t BSSL_TCP_Client::write(const char *buf) { return write(reinterpret_cast<c
 
 size_t BSSL_TCP_Client::write(Stream &stream) { return _ssl_client.write(stream); }
 
+size_t BSSL_TCP_Client::writev(const esp_ssl_iovec_t *iov, size_t count)
+{
+    if (!_ssl_client.connected())
+        return 0;
+    return _ssl_client.writev(iov, count);
+}
+
+void BSSL_TCP_Client::resetSendStats() { _ssl_client.resetSendStats(); }
+
+uint32_t BSSL_TCP_Client::sentRecords() const { return _ssl_client.sentRecords(); }
+
+uint32_t BSSL_TCP_Client::sentBytes() const { return _ssl_client.sentBytes(); }
+
 int BSSL_TCP_Client::peek()
 {
     return _ssl_client.peek();
@@ -3,6 +3,8 @@
  *
  * Created December 5, 2024
  *
+ * This copy was patched with the gather write and send statistics, see ESP_SSLCLIENT_HAS_WRITEV.
+ *
  * The MIT License (MIT)
  * Copyright (c) 2023 K. Suwatchai (Mobizt)
  *
@@ -260,6 +262,32 @@ public:
      */
     size_t write(Stream &stream);
 
+    /**
+     * The TCP data gather write function.
+     * @param iov The array of data buffers to write.
+     * @param count The number of data buffers.
+     * @return The size of data that was successfully written or 0 for error.
+     * @note All buffers are encrypted in as few TLS records as possible for secure mode.
+     */
+    size_t writev(const esp_ssl_iovec_t *iov, size_t count);
+
+    /**
+     * Reset the statistics of sent TLS records (or TCP writes for non-secure mode) and bytes.
+     */
+    void resetSendStats();
+
+    /**
+     * Get the number of TLS records (or TCP writes for non-secure mode) that were sent since resetSendStats.
+     * @return The number of records.
+     */
+    uint32_t sentRecords() const;
+
+    /**
+     * Get the number of bytes that were sent on wire since resetSendStats.
+     * @return The number of bytes.
+     */
+    uint32_t sentBytes() const;
+
     /**
      * Read one byte from Stream with time out.
      * @return The byte of data that was successfully read or -1 for timed out.
@@ -0,0 +1,323 @@
+
+/**
+ * Google's Firebase JWT RSA Signer class, FB_RSA_Signer.cpp version 1.0.0
+ *
+ * Created October 17, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2023 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FB_RSA_SIGNER_CPP
+#define FB_RSA_SIGNER_CPP
+
+#include <Arduino.h>
+#include "./mbfs/MB_MCU.h"
+#include "FB_RSA_Signer.h"
+
+// The BearSSL i15 big integer functions (inner.h) which are used by br_rsa_i15_private.
+extern "C"
+{
+    uint16_t br_i15_ninv15(uint16_t x);
+    uint32_t br_i15_add(uint16_t *a, const uint16_t *b, uint32_t ctl);
+    uint32_t br_i15_sub(uint16_t *a, const uint16_t *b, uint32_t ctl);
+    void br_i15_montymul(uint16_t *d, const uint16_t *x, const uint16_t *y, const uint16_t *m, uint16_t m0i);
+    void br_i15_to_monty(uint16_t *x, const uint16_t *m);
+    void br_i15_encode(void *dst, size_t len, const uint16_t *x);
+    void br_i15_decode(uint16_t *x, const void *src, size_t len);
+    void br_i15_decode_reduce(uint16_t *x, const void *src, size_t len, const uint16_t *m);
+    void br_i15_reduce(uint16_t *x, const uint16_t *a, const uint16_t *m);
+    void br_i15_mulacc(uint16_t *d, const uint16_t *a, const uint16_t *b);
+}
+
+// DER encoded DigestInfo prefix of SHA-256 (RFC 8017 section 9.2)
+static const uint8_t fb_rsa_signer_sha256_prefix[] = {0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+                                                      0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20};
+
+static void fb_rsa_signer_zero(uint16_t *v, uint16_t bitLen)
+{
+    *v++ = bitLen;
+    memset(v, 0, ((bitLen + 15) >> 4) * sizeof(*v));
+}
+
+// Constant-time conditional copy of len bytes (ctl is 0 or 1)
+static void fb_rsa_signer_ccopy(uint32_t ctl, uint16_t *dst, const uint16_t *src, size_t len)
+{
+    uint16_t mask = (uint16_t)-ctl;
+    for (size_t i = 0; i < len / sizeof(*dst); i++)
+        dst[i] ^= mask & (dst[i] ^ src[i]);
+}
+
+static const unsigned char *fb_rsa_signer_trim(const unsigned char *v, size_t &len)
+{
+    while (len > 0 && *v == 0)
+    {
+        v++;
+        len--;
+    }
+    return v;
+}
+
+FB_RSA_Signer::FB_RSA_Signer()
+{
+}
+
+FB_RSA_Signer::~FB_RSA_Signer()
+{
+    clear();
+}
+
+bool FB_RSA_Signer::setKey(const char *pem)
+{
+    clear();
+
+    if (!pem)
+        return false;
+
+    pk = new PrivateKey(pem);
+
+    if (!pk->isRSA())
+    {
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+void FB_RSA_Signer::clear()
+{
+    end();
+
+    if (pk)
+        delete pk;
+    pk = nullptr;
+}
+
+void FB_RSA_Signer::end()
+{
+    // the buffers hold the private key derived values
+    if (buf)
+    {
+        memset(buf, 0, (6 * fwlen + 1) * sizeof(*buf));
+        delete[] buf;
+    }
+
+    if (x)
+    {
+        memset(x, 0, xlen);
+        delete[] x;
+    }
+
+    buf = nullptr;
+    x = nullptr;
+    mq = mp = s1 = s2 = nullptr;
+    xlen = 0;
+    fwlen = 0;
+    bit = 0;
+    step = fb_rsa_signer_step_idle;
+}
+
+bool FB_RSA_Signer::pad(const uint8_t *hash)
+{
+    size_t prefixLen = sizeof(fb_rsa_signer_sha256_prefix);
+
+    // EM = 0x00 || 0x01 || PS (at least 8 bytes of 0xff) || 0x00 || DigestInfo || hash
+    if (xlen < prefixLen + FB_RSA_SIGNER_HASH_SIZE + 11)
+        return false;
+
+    size_t n = xlen - prefixLen - FB_RSA_SIGNER_HASH_SIZE;
+    x[0] = 0x00;
+    x[1] = 0x01;
+    memset(x + 2, 0xff, n - 3);
+    x[n - 1] = 0x00;
+    memcpy(x + n, fb_rsa_signer_sha256_prefix, prefixLen);
+    memcpy(x + n + prefixLen, hash, FB_RSA_SIGNER_HASH_SIZE);
+    return true;
+}
+
+bool FB_RSA_Signer::begin(const uint8_t *hash)
+{
+    if (!pk || !hash)
+        return false;
+
+    end();
+
+    const br_rsa_private_key *sk = pk->getRSA();
+
+    size_t plen = sk->plen, qlen = sk->qlen;
+    const unsigned char *p = fb_rsa_signer_trim(sk->p, plen);
+    const unsigned char *q = fb_rsa_signer_trim(sk->q, qlen);
+
+    if (plen == 0 || qlen == 0)
+        return false;
+
+    // The maximum factor length in 15-bit words (rounded up to even number)
+    long z = (long)(plen > qlen ? plen : qlen) << 3;
+    fwlen = 1;
+    while (z > 0)
+    {
+        z -= 15;
+        fwlen++;
+    }
+    fwlen += (fwlen & 1);
+
+    xlen = (sk->n_bitlen + 7) >> 3;
+
+    // Six values (mq, s2, mp, s1, t1, t2) of fwlen words, plus one word for 32-bit alignment
+    buf = new uint16_t[6 * fwlen + 1];
+    x = new uint8_t[xlen];
+
+    if (!buf || !x || !pad(hash))
+    {
+        end();
+        return false;
+    }
+
+    mq = buf;
+    if (((uintptr_t)mq & 2) == 0)
+        mq++;
+
+    br_i15_decode(mq, q, qlen);
+
+    uint16_t *t1 = mq + fwlen;
+    br_i15_decode(t1, p, plen);
+
+    // Check the message range (less than the modulus) with the carry of subtracting the modulus
+    uint16_t *t2 = mq + 2 * fwlen;
+    fb_rsa_signer_zero(t2, mq[0]);
+    br_i15_mulacc(t2, mq, t1);
+
+    uint8_t *t3 = reinterpret_cast<uint8_t *>(mq + 4 * fwlen);
+    br_i15_encode(t3, xlen, t2);
+    r = 0;
+    for (size_t u = xlen; u > 0; u--)
+        r = (((uint32_t)x[u - 1] - ((uint32_t)t3[u - 1] + r)) >> 8) & 1;
+
+    mp = mq + 2 * fwlen;
+    memmove(mp, t1, fwlen * sizeof(*t1));
+
+    q0i = br_i15_ninv15(mq[1]);
+    p0i = br_i15_ninv15(mp[1]);
+
+    s2 = mq + fwlen;
+    s1 = mq + 3 * fwlen;
+
+    // s2 = x^dq mod q
+    br_i15_decode_reduce(s2, x, xlen, mq);
+    initModpow(s2, mq);
+    step = fb_rsa_signer_step_modpow_q;
+
+    return true;
+}
+
+void FB_RSA_Signer::initModpow(uint16_t *v, const uint16_t *m)
+{
+    uint16_t *t1 = mq + 4 * fwlen;
+    size_t mlen = ((m[0] + 31) >> 4) * sizeof(m[0]);
+
+    memcpy(t1, v, mlen);
+    br_i15_to_monty(t1, m);
+    fb_rsa_signer_zero(v, m[0]);
+    v[1] = 1;
+    bit = 0;
+}
+
+bool FB_RSA_Signer::modpowStep(uint16_t *v, const unsigned char *e, size_t elen, const uint16_t *m, uint16_t m0i)
+{
+    // One iteration of br_i15_modpow, processes the exponent bit from the least significant bit.
+    uint16_t *t1 = mq + 4 * fwlen;
+    uint16_t *t2 = mq + 5 * fwlen;
+    size_t mlen = ((m[0] + 31) >> 4) * sizeof(m[0]);
+
+    uint32_t ctl = (e[elen - 1 - (bit >> 3)] >> (bit & 7)) & 1;
+    br_i15_montymul(t2, v, t1, m, m0i);
+    fb_rsa_signer_ccopy(ctl, v, t2, mlen);
+    br_i15_montymul(t2, t1, t1, m, m0i);
+    memcpy(t1, t2, mlen);
+    bit++;
+
+    return bit >= (elen << 3);
+}
+
+void FB_RSA_Signer::combine()
+{
+    const br_rsa_private_key *sk = pk->getRSA();
+
+    // h = (s1 - s2) * (1/q) mod p
+    uint16_t *t1 = mq + 4 * fwlen;
+    uint16_t *t2 = mq + 5 * fwlen;
+    br_i15_reduce(t2, s2, mp);
+    br_i15_add(s1, mp, br_i15_sub(s1, t2, 1));
+    br_i15_to_monty(s1, mp);
+    br_i15_decode_reduce(t1, sk->iq, sk->iqlen, mp);
+    br_i15_montymul(t2, s1, t1, mp, p0i);
+
+    // s = s2 + q * h, s2 and the unused mp slots are the destination
+    br_i15_mulacc(s2, mq, t2);
+    br_i15_encode(x, xlen, s2);
+}
+
+int FB_RSA_Signer::run(unsigned long timeSlice)
+{
+    if (step == fb_rsa_signer_step_done)
+        return 1;
+
+    if (!isSigning() || !pk)
+        return -1;
+
+    const br_rsa_private_key *sk = pk->getRSA();
+    unsigned long ms = millis();
+
+    do
+    {
+        if (step == fb_rsa_signer_step_modpow_q)
+        {
+            if (sk->dqlen == 0 || modpowStep(s2, sk->dq, sk->dqlen, mq, q0i))
+            {
+                // s1 = x^dp mod p
+                br_i15_decode_reduce(s1, x, xlen, mp);
+                initModpow(s1, mp);
+                step = fb_rsa_signer_step_modpow_p;
+            }
+        }
+        else if (sk->dplen == 0 || modpowStep(s1, sk->dp, sk->dplen, mp, p0i))
+        {
+            combine();
+
+            // The remaining errors are the message range and the invalid (even) factors
+            if ((p0i & q0i & r) == 0)
+            {
+                end();
+                step = fb_rsa_signer_step_error;
+                return -1;
+            }
+
+            step = fb_rsa_signer_step_done;
+            return 1;
+        }
+
+    } while (timeSlice == 0 || millis() - ms < timeSlice);
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,132 @@
+
+/**
+ * Google's Firebase JWT RSA Signer class, FB_RSA_Signer.h version 1.0.0
+ *
+ * Created October 17, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2023 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FB_RSA_SIGNER_H
+#define FB_RSA_SIGNER_H
+
+#include <Arduino.h>
+#include "./mbfs/MB_MCU.h"
+#include "./FB_Const.h"
+#include "./client/FB_TCP_Client.h"
+
+#define FB_RSA_SIGNER_HASH_SIZE 32
+
+typedef enum
+{
+    fb_rsa_signer_step_idle,
+    fb_rsa_signer_step_modpow_q,
+    fb_rsa_signer_step_modpow_p,
+    fb_rsa_signer_step_done,
+    fb_rsa_signer_step_error
+} fb_rsa_signer_step;
+
+/**
+ * The RSA PKCS#1 v1.5 (RS256) signer for JWT token.
+ *
+ * The decoded private key is kept between signings and the RSA-CRT private key operation
+ * is processed a few exponent bits per run() call, so that signing does not block the loop.
+ * The result is the same as br_rsa_i15_pkcs1_sign.
+ */
+class FB_RSA_Signer
+{
+public:
+    FB_RSA_Signer();
+    ~FB_RSA_Signer();
+
+    /**
+     * Decode and keep the RSA private key.
+     *
+     * @param pem The PEM (PKCS#1 or PKCS#8) encoded private key, can be flash string (PROGMEM).
+     * @return Boolean type status indicates the RSA private key was decoded.
+     */
+    bool setKey(const char *pem);
+
+    /**
+     * Check whether the decoded private key is available.
+     */
+    bool hasKey() { return pk != nullptr; }
+
+    /**
+     * Free the decoded private key and the signing buffers.
+     */
+    void clear();
+
+    /**
+     * Free the signing buffers and the signature, the decoded private key is kept.
+     */
+    void end();
+
+    /**
+     * Start signing the SHA-256 hash.
+     *
+     * @param hash The 32 bytes SHA-256 message digest.
+     * @return Boolean type status indicates the signing was started.
+     */
+    bool begin(const uint8_t *hash);
+
+    /**
+     * Check whether the signing was started and not finished.
+     */
+    bool isSigning() { return step == fb_rsa_signer_step_modpow_q || step == fb_rsa_signer_step_modpow_p; }
+
+    /**
+     * Continue the signing.
+     *
+     * @param timeSlice The maximum time in ms to process, 0 for processing until finished.
+     * @return The signing status, 1 when signature is ready, 0 when signing is in progress or -1 for error.
+     */
+    int run(unsigned long timeSlice);
+
+    /**
+     * Get the signature after run() returned 1.
+     */
+    const uint8_t *signature() { return step == fb_rsa_signer_step_done ? x : nullptr; }
+
+    /**
+     * Get the signature length in bytes.
+     */
+    size_t signatureLength() { return xlen; }
+
+private:
+    PrivateKey *pk = nullptr;
+    uint16_t *buf = nullptr;
+    uint16_t *mq = nullptr, *mp = nullptr, *s1 = nullptr, *s2 = nullptr;
+    // The padded message digest which will be replaced by the signature.
+    uint8_t *x = nullptr;
+    size_t xlen = 0, fwlen = 0, bit = 0;
+    uint16_t p0i = 0, q0i = 0;
+    uint32_t r = 0;
+    fb_rsa_signer_step step = fb_rsa_signer_step_idle;
+
+    bool pad(const uint8_t *hash);
+    void initModpow(uint16_t *v, const uint16_t *m);
+    bool modpowStep(uint16_t *v, const unsigned char *e, size_t elen, const uint16_t *m, uint16_t m0i);
+    void combine();
+};
+
+#endif
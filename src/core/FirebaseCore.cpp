@@ -46,6 +46,16 @@ void FirebaseCore::begin(FirebaseConfig *cfg, FirebaseAuth *authen)
 {
     this->config = cfg;
     this->auth = authen;
+
+    // the private key and JWT header will be decoded and encoded again for the new config
+    rsaSigner.clear();
+    if (config)
+        config->signer.encHeader.clear();
+
+    bgRefresh = false;
+    refreshLead = 0;
+    tokenLifetime = 0;
+    refreshInfo.lead_seconds = 0;
 }
 
 void FirebaseCore::end()
@@ -60,6 +70,7 @@ void FirebaseCore::end()
     multi = nullptr;
 #endif
     freeClient(&tcpClient);
+    tcpPool.clear();
 }
 
 bool FirebaseCore::parseSAFile()
@@ -304,6 +315,87 @@ void FirebaseCore::adjustTime(time_t &now)
         config->signer.preRefreshSeconds = 60;
 }
 
+bool FirebaseCore::isRefreshDue()
+{
+    if (!config || !auth || !config->token_refresh.background || config->signer.test_mode || !isAuthToken(true))
+        return false;
+
+    // the user assigned tokens without refresh token can't be refreshed before expiry
+    if (config->signer.customTokenCustomSet || config->signer.accessTokenCustomSet ||
+        (config->signer.idTokenCustomSet && internal.refresh_token.length() == 0))
+        return false;
+
+    if (bgRefresh)
+        return true;
+
+    // start the refresh in idle time only
+    if (config->signer.tokens.status != token_status_ready || config->signer.tokens.expires == 0 ||
+        refreshLead == 0 || internal.fb_processing)
+        return false;
+
+    // the token age is counted in ms of millis() since it was received, not from the system time
+    // which can be set or synced after the token was received, refreshLead is less than its lifetime
+    return millis() - config->signer.tokens.last_millis >= (tokenLifetime - refreshLead) * 1000;
+}
+
+void FirebaseCore::scheduleRefresh(unsigned long lifetime)
+{
+    refreshLead = 0;
+    tokenLifetime = lifetime;
+
+    if (config && config->token_refresh.background)
+    {
+        unsigned long lead = config->token_refresh.lead_seconds;
+
+        // the random jitter spreads the refresh of devices that were started at the same time
+        if (config->token_refresh.jitter_seconds > 0)
+            lead += FBUtils::random32() % (config->token_refresh.jitter_seconds + 1);
+
+        // the new token should be used for at least half of its lifetime
+        if (lead > lifetime / 2)
+            lead = lifetime / 2;
+
+        // no time to refresh before the pre-refresh (expiry) time
+        if (lead > config->signer.preRefreshSeconds)
+            refreshLead = lead;
+    }
+
+    refreshInfo.lead_seconds = refreshLead;
+}
+
+bool FirebaseCore::isTokenUsable()
+{
+    if (config->signer.tokens.status == token_status_ready)
+        return true;
+
+    // the current token is kept in use until the new token was received or it was expired
+    return bgRefresh && internal.auth_token.length() > 0 && !isExpired();
+}
+
+void FirebaseCore::updateAuthBlocked(bool ready)
+{
+    if (!ready && !authBlocked && isAuthToken(true))
+    {
+        authBlocked = true;
+        authBlockedMillis = millis();
+        refreshInfo.blocked++;
+
+        // the token was expired before this check, count the blocked time from its expiry,
+        // which is in ms of millis() since the token was received as the token age
+        unsigned long valid = tokenLifetime > config->signer.preRefreshSeconds ? (tokenLifetime - config->signer.preRefreshSeconds) * 1000 : 0;
+        if (config->signer.tokens.expires > 0 && tokenLifetime > 0 && authBlockedMillis - config->signer.tokens.last_millis > valid)
+            authBlockedMillis = config->signer.tokens.last_millis + valid;
+    }
+    else if (ready && authBlocked)
+    {
+        authBlocked = false;
+        unsigned long ms = millis() - authBlockedMillis;
+        refreshInfo.blocked_ms += ms;
+        if (ms > refreshInfo.max_blocked_ms)
+            refreshInfo.max_blocked_ms = ms;
+    }
+}
+
 bool FirebaseCore::readyToRequest()
 {
     bool ret = false;
@@ -383,6 +475,16 @@ bool FirebaseCore::handleToken()
     // time is up or expiey time reset or unset
     bool exp = isExpired();
 
+    // the refresh after expiry blocks the requests until the new token was received
+    if (exp)
+        bgRefresh = false;
+    // refresh the token in background before expiry while the current token is still in use
+    else if (isRefreshDue())
+    {
+        bgRefresh = true;
+        exp = true;
+    }
+
     // Handle user assigned tokens (custom and access tokens)
 
     // if custom token was set
@@ -477,13 +579,17 @@ bool FirebaseCore::handleToken()
                     if (config->signer.step == firebase_jwt_generation_step_begin)
                     {
                         // if service account key json file assigned and no private key parsing data
-                        if (config->service_account.json.path.length() > 0 && config->signer.pk.length() == 0)
+                        if (config->service_account.json.path.length() > 0 && config->signer.pk.length() == 0 && !rsaSigner.hasKey())
                         {
                             // if fail to parse the private key from service account json file, reset the token status
                             if (!parseSAFile())
                                 config->signer.tokens.status = token_status_uninitialized;
                         }
 
+                        // decode the private key once, it is kept for the next token signing
+                        if (!rsaSigner.hasKey() && serviceAccountCredsReady())
+                            initSigner();
+
                         // if no token status set, set the states
                         if (config->signer.tokens.status != token_status_on_initialize)
                         {
@@ -657,7 +763,8 @@ void FirebaseCore::tokenProcessingTask()
     // All sessions should be closed
     freeClient(&tcpClient);
 
-    for (size_t i = 0; i < Core.internal.sessions.size(); i++)
+    // except for the background refresh that keeps the sessions and streams open (opted in by user)
+    for (size_t i = 0; i < Core.internal.sessions.size() && !bgRefresh; i++)
     {
         if (Core.internal.sessions[i].status)
             return;
@@ -669,13 +776,17 @@ void FirebaseCore::tokenProcessingTask()
 
     bool ret = false;
 
+    // the JWT token step that has to wait (signing slice, step interval or request throttle)
+    // continues in the next call instead of blocking the loop here
+    bool pending = false;
+
     config->signer.tokenTaskRunning = true;
 
     timeBegin();
 
     time_t now = getTime();
 
-    while (!ret && config->signer.tokens.status != token_status_ready)
+    while (!ret && !pending && config->signer.tokens.status != token_status_ready)
     {
 
         FBUtils::idle();
@@ -762,8 +873,11 @@ void FirebaseCore::tokenProcessingTask()
             // sign the JWT token
             else if (config->signer.step == firebase_jwt_generation_step_sign)
             {
+                // signing is in progress or failed
                 if (createJWT())
                     config->signer.step = firebase_jwt_generation_step_exchange;
+                else
+                    pending = true;
             }
             // sending JWT token requst for auth token
             else if (config->signer.step == firebase_jwt_generation_step_exchange)
@@ -779,7 +893,12 @@ void FirebaseCore::tokenProcessingTask()
                     if (!reconnect() && isErrorCBTimeOut())
                         handleTaskError(FIREBASE_ERROR_TCP_ERROR_CONNECTION_LOST);
                 }
+                else
+                    pending = true;
             }
+            // waiting for the begin step interval
+            else
+                pending = true;
         }
     }
 
@@ -953,6 +1072,9 @@ void FirebaseCore::freeClient(Firebase_TCP_Client **client)
 
 void FirebaseCore::setTokenError(int code)
 {
+    if (code != 0 && bgRefresh)
+        refreshInfo.failures++;
+
     if (code != 0)
         config->signer.tokens.status = token_status_error;
     else
@@ -1026,6 +1148,7 @@ bool FirebaseCore::handleTaskError(int code, int httpCode)
         config->signer.tokens.status = token_status_ready;
         config->signer.step = firebase_jwt_generation_step_begin;
         internal.fb_last_jwt_generation_error_cb_millis = 0;
+        updateAuthBlocked(true);
         if (code == FIREBASE_ERROR_TOKEN_COMPLETE_NOTIFY)
             sendTokenStatusCB();
 
@@ -1101,8 +1224,7 @@ bool FirebaseCore::handleTokenResponse(int &httpCode)
                 // Read the avilable data
                 // chunk transfer encoding?
                 if (response.isChunkedEnc)
-                    tcpHandler.bufferAvailable = hh.readChunkedData(&sh, &mbfs, tcpClient,
-                                                                    pChunk, nullptr, tcpHandler);
+                    tcpHandler.bufferAvailable = hh.readChunkedData(tcpClient, pChunk, tcpHandler.chunkBufSize, tcpHandler);
                 else
                     tcpHandler.bufferAvailable = hh.readLine(tcpClient,
                                                              pChunk, tcpHandler.chunkBufSize);
@@ -1130,7 +1252,8 @@ bool FirebaseCore::handleTokenResponse(int &httpCode)
 
     mbfs.delP(&pChunk);
 
-    if (tcpClient->connected())
+    // Keep the idle connection in the shared pool when the response was completely read
+    if (tcpClient->connected() && (!complete || !tcpPool.release(tcpClient, &config->connection_pool)))
         tcpClient->stop();
 
     httpCode = response.httpCode;
@@ -1173,22 +1296,24 @@ bool FirebaseCore::createJWT()
 
         config->signer.tokens.jwt.clear();
 
-        // header
+        // header, it never changes and is encoded once
         // {"alg":"RS256","typ":"JWT"}
-        jsonPtr->add(pgm2Str(firebase_auth_pgm_str_17 /* "alg" */), pgm2Str(firebase_auth_pgm_str_29 /* "RS256" */));
-        jsonPtr->add(pgm2Str(firebase_auth_pgm_str_18 /* "typ" */), pgm2Str(firebase_auth_pgm_str_28 /* "JWT" */));
-
-        size_t len = bh.encodedLength(strlen(jsonPtr->raw()));
-        char *buf = reinterpret_cast<char *>(mbfs.newP(len));
-        bh.encodeUrl(&mbfs, buf, (unsigned char *)jsonPtr->raw(), strlen(jsonPtr->raw()));
-        config->signer.encHeader = buf;
-        mbfs.delP(&buf);
-        config->signer.encHeadPayload = config->signer.encHeader;
+        if (config->signer.encHeader.length() == 0)
+        {
+            jsonPtr->add(pgm2Str(firebase_auth_pgm_str_17 /* "alg" */), pgm2Str(firebase_auth_pgm_str_29 /* "RS256" */));
+            jsonPtr->add(pgm2Str(firebase_auth_pgm_str_18 /* "typ" */), pgm2Str(firebase_auth_pgm_str_28 /* "JWT" */));
+
+            size_t len = bh.encodedLength(strlen(jsonPtr->raw()));
+            char *buf = reinterpret_cast<char *>(mbfs.newP(len));
+            bh.encodeUrl(&mbfs, buf, (unsigned char *)jsonPtr->raw(), strlen(jsonPtr->raw()));
+            config->signer.encHeader = buf;
+            mbfs.delP(&buf);
+            jsonPtr->clear();
+        }
 
         // payload
         // {"iss":"<email>","sub":"<email>","aud":"<audience>","iat":<timstamp>,"exp":<expire>,"scope":"<scope>"}
         // {"iss":"<email>","sub":"<email>","aud":"<audience>","iat":<timstamp>,"exp":<expire>,"uid":"<uid>","claims":"<claims>"}
-        jsonPtr->clear();
         jsonPtr->add(pgm2Str(firebase_auth_pgm_str_30 /* "iss" */), config->service_account.data.client_email.c_str());
         jsonPtr->add(pgm2Str(firebase_auth_pgm_str_31 /* "sub" */), config->service_account.data.client_email.c_str());
 
@@ -1273,84 +1398,72 @@ bool FirebaseCore::createJWT()
             }
         }
 
-        len = bh.encodedLength(strlen(jsonPtr->raw()));
-        buf = reinterpret_cast<char *>(mbfs.newP(len));
-        bh.encodeUrl(&mbfs, buf, (unsigned char *)jsonPtr->raw(), strlen(jsonPtr->raw()));
-        config->signer.encPayload = buf;
-        mbfs.delP(&buf);
-
-        config->signer.encHeadPayload += firebase_auth_pgm_str_4; // "."
-        config->signer.encHeadPayload += config->signer.encPayload;
-
-        config->signer.encHeader.clear();
-        config->signer.encPayload.clear();
+        // encode the payload next to the cached header in one buffer, <header>.<payload>
+        size_t hlen = config->signer.encHeader.length();
+        size_t plen = strlen(jsonPtr->raw());
+        char *buf = reinterpret_cast<char *>(mbfs.newP(hlen + 1 + bh.encodedLength(plen)));
+        memcpy(buf, config->signer.encHeader.c_str(), hlen);
+        buf[hlen] = '.';
+        bh.encodeUrl(&mbfs, buf + hlen + 1, (unsigned char *)jsonPtr->raw(), plen);
+        freeJson();
 
         // create message digest from encoded header and payload
 
-        config->signer.hash = reinterpret_cast<char *>(mbfs.newP(config->signer.hashSize));
+        if (!config->signer.hash)
+            config->signer.hash = reinterpret_cast<char *>(mbfs.newP(config->signer.hashSize));
         br_sha256_context mc;
         br_sha256_init(&mc);
-        br_sha256_update(&mc, config->signer.encHeadPayload.c_str(), config->signer.encHeadPayload.length());
+        br_sha256_update(&mc, buf, strlen(buf));
         br_sha256_out(&mc, config->signer.hash);
 
-        config->signer.tokens.jwt = config->signer.encHeadPayload;
+        config->signer.tokens.jwt = buf;
         config->signer.tokens.jwt += firebase_auth_pgm_str_4; // "."
-        config->signer.encHeadPayload.clear();
-
-        freeJson();
+        mbfs.delP(&buf);
     }
     else if (config->signer.step == firebase_jwt_generation_step_sign)
     {
         config->signer.tokens.status = token_status_on_signing;
 
-        // RSA private key
-        PrivateKey *pk = nullptr;
-        FBUtils::idle();
-        // parse priv key
-        if (config->signer.pk.length() > 0)
-            pk = new PrivateKey((const char *)config->signer.pk.c_str());
-        else if (strlen_P(config->service_account.data.private_key) > 0)
-            pk = new PrivateKey((const char *)config->service_account.data.private_key);
-
-        if (!pk)
-            return handleError(FIREBASE_ERROR_TOKEN_PARSE_PK, (const char *)FPSTR("BearSSL, PrivateKey: "));
-
-        if (!pk->isRSA())
+        if (!rsaSigner.isSigning())
         {
-            delete pk;
-            pk = nullptr;
-            return handleError(FIREBASE_ERROR_TOKEN_PARSE_PK, (const char *)FPSTR("BearSSL, isRSA: "));
-        }
+            // the private key is decoded once and kept for the next signing
+            if (!initSigner())
+                return false;
 
-        const br_rsa_private_key *br_rsa_key = pk->getRSA();
+            // generate RSA signature from private key and message digest
+            bool started = rsaSigner.begin((const uint8_t *)config->signer.hash);
+            mbfs.delP(&config->signer.hash);
 
-        // generate RSA signature from private key and message digest
-        config->signer.signature = new unsigned char[config->signer.signatureSize];
+            if (!started)
+            {
+                // create the new JWT token
+                config->signer.step = firebase_jwt_generation_step_begin;
+                return handleError(FIREBASE_ERROR_TOKEN_SIGN, (const char *)FPSTR("BearSSL, br_rsa_i15_pkcs1_sign: "));
+            }
+        }
 
+        // the signing is processed in time slices and continued in the next call
         FBUtils::idle();
-        int ret = br_rsa_i15_pkcs1_sign(BR_HASH_OID_SHA256, (const unsigned char *)config->signer.hash,
-                                        br_sha256_SIZE, br_rsa_key, config->signer.signature);
+        int ret = rsaSigner.run(config->timeout.tokenSigningSlice);
         FBUtils::idle();
-        mbfs.delP(&config->signer.hash);
 
-        size_t len = bh.encodedLength(config->signer.signatureSize);
-        char *buf = reinterpret_cast<char *>(mbfs.newP(len));
-        bh.encodeUrl(&mbfs, buf, config->signer.signature, config->signer.signatureSize);
-        config->signer.encSignature = buf;
-        mbfs.delP(&buf);
-        mbfs.delP(&config->signer.signature);
-        delete pk;
-        pk = nullptr;
+        if (ret == 0)
+            return false;
 
-        // get the signed JWT
-        if (ret > 0)
+        if (ret < 0)
         {
-            config->signer.tokens.jwt += config->signer.encSignature;
-            config->signer.pk.clear();
-            config->signer.encSignature.clear();
-        }
-        else
+            config->signer.step = firebase_jwt_generation_step_begin;
             return handleError(FIREBASE_ERROR_TOKEN_SIGN, (const char *)FPSTR("BearSSL, br_rsa_i15_pkcs1_sign: "));
+        }
+
+        // get the signed JWT
+        size_t len = bh.encodedLength(rsaSigner.signatureLength());
+        char *buf = reinterpret_cast<char *>(mbfs.newP(len));
+        bh.encodeUrl(&mbfs, buf, (unsigned char *)rsaSigner.signature(), rsaSigner.signatureLength());
+        config->signer.tokens.jwt += buf;
+        mbfs.delP(&buf);
+        rsaSigner.end();
+        config->signer.pk.clear();
     }
 
 #endif
@@ -1358,6 +1471,35 @@ bool FirebaseCore::createJWT()
     return true;
 }
 
+bool FirebaseCore::initSigner()
+{
+#if !defined(USE_LEGACY_TOKEN_ONLY) && !defined(FIREBASE_USE_LEGACY_TOKEN_ONLY)
+
+    if (rsaSigner.hasKey())
+        return true;
+
+    const char *pem = nullptr;
+
+    if (config->signer.pk.length() > 0)
+        pem = config->signer.pk.c_str();
+    else if (strlen_P(config->service_account.data.private_key) > 0)
+        pem = config->service_account.data.private_key;
+
+    if (!pem)
+        return handleError(FIREBASE_ERROR_TOKEN_PARSE_PK, (const char *)FPSTR("BearSSL, PrivateKey: "));
+
+    FBUtils::idle();
+
+    if (!rsaSigner.setKey(pem))
+        return handleError(FIREBASE_ERROR_TOKEN_PARSE_PK, (const char *)FPSTR("BearSSL, isRSA: "));
+
+    return true;
+
+#endif
+
+    return false;
+}
+
 bool FirebaseCore::getIdToken(bool createUser, MB_StringPtr email, MB_StringPtr password)
 {
 #if !defined(USE_LEGACY_TOKEN_ONLY) && !defined(FIREBASE_USE_LEGACY_TOKEN_ONLY)
@@ -1758,8 +1900,14 @@ bool FirebaseCore::initClient(PGM_P subDomain, firebase_auth_token_status status
     if (!tcpClient)
         newClient(&tcpClient);
 
-    // Stop TCP session
-    tcpClient->stop();
+    MB_String host;
+    hh.addGAPIsHost(host, subDomain);
+
+    tcpClient->setBufferProfile(firebase_bssl_buffer_profile_request, &mflnCache);
+
+    // Take the pooled connection to host or stop TCP session
+    if (!tcpPool.acquire(tcpClient, host.c_str(), 443, &config->connection_pool))
+        tcpClient->stop();
 
     tcpClient->setCACert(nullptr);
 
@@ -1773,11 +1921,8 @@ bool FirebaseCore::initClient(PGM_P subDomain, firebase_auth_token_status status
 
     initJson();
 
-    MB_String host;
-    hh.addGAPIsHost(host, subDomain);
-
     FBUtils::idle();
-    tcpClient->setSession(&bsslSession);
+    tcpClient->setSession(&bsslSession, &tlsSessionCache);
     tcpClient->begin(host.c_str(), 443, &response_code);
 
     return true;
@@ -1954,6 +2099,15 @@ void FirebaseCore::getExpiration(const char *exp)
     unsigned long ms = millis();
     config->signer.tokens.expires = now + atoi(exp);
     config->signer.tokens.last_millis = ms;
+
+    // the new token was swapped in
+    if (bgRefresh)
+    {
+        bgRefresh = false;
+        refreshInfo.background++;
+    }
+
+    scheduleRefresh(atoi(exp));
 }
 
 bool FirebaseCore::handleEmailSending(MB_StringPtr payload, firebase_user_email_sending_type type)
@@ -2053,10 +2207,17 @@ bool FirebaseCore::checkToken()
     if (!config || !auth)
         return false;
 
-    if (isAuthToken(true) && isExpired())
+    if (isAuthToken(true) && (isExpired() || isRefreshDue()))
+    {
+        // the token processing may block in this call
+        updateAuthBlocked(isTokenUsable());
         handleToken();
+    }
 
-    return config->signer.tokens.status == token_status_ready;
+    bool ready = isTokenUsable();
+    updateAuthBlocked(ready);
+
+    return ready;
 }
 
 bool FirebaseCore::tokenReady()
@@ -2070,7 +2231,7 @@ bool FirebaseCore::tokenReady()
     if (!reconnect())
         return false;
 
-    return config->signer.tokens.status == token_status_ready;
+    return isTokenUsable();
 };
 
 void FirebaseCore::errorToString(int httpCode, MB_String &buff)
@@ -2323,6 +2484,9 @@ void FirebaseCore::errorToString(int httpCode, MB_String &buff)
     case FIREBASE_ERROR_USER_PAUSE:
         buff += firebase_rtdb_err_pgm_str_5; // "the FirebaseData object was paused"
         break;
+    case FIREBASE_ERROR_ASYNC_PIPELINE_FULL:
+        buff += firebase_rtdb_err_pgm_str_6; // "the async pipeline is full"
+        return;
 
     case FIREBASE_ERROR_NO_FCM_ID_TOKEN_PROVIDED:
         buff += firebase_fcm_err_pgm_str_1; // "no ID token or registration token provided"
@@ -35,6 +35,7 @@
 #include "./client/FB_TCP_Client.h"
 #include "./FirebaseFS.h"
 #include "./mbfs/MB_FS.h"
+#include "./core/FB_RSA_Signer.h"
 
 using namespace mb_string;
 
@@ -87,6 +88,20 @@ private:
     struct token_info_t tokenInfo;
     bool authenticated = false;
     Firebase_TCP_Client *tcpClient = nullptr;
+    Firebase_TCP_Client_Pool tcpPool;
+    Firebase_TLS_Session_Cache tlsSessionCache;
+    Firebase_MFLN_Cache mflnCache;
+    Firebase_Trust_Anchor_Store trustAnchors;
+    FB_RSA_Signer rsaSigner;
+    TokenRefreshInfo refreshInfo;
+    // The token is being refreshed in background while the current token is still in use.
+    bool bgRefresh = false;
+    // The seconds before the token expiry time to start the background refresh.
+    unsigned long refreshLead = 0;
+    // The lifetime in seconds of the current token which was received at config->signer.tokens.last_millis.
+    unsigned long tokenLifetime = 0;
+    bool authBlocked = false;
+    unsigned long authBlockedMillis = 0;
     FirebaseJson *jsonPtr = nullptr;
     FirebaseJsonData *resultPtr = nullptr;
     int response_code = 0;
@@ -119,6 +134,14 @@ private:
     bool isAuthToken(bool oauth);
     /* check for time is up or expiry time was reset or unset? */
     bool isExpired();
+    /* check for the time to refresh the token in background or the background refresh is in progress */
+    bool isRefreshDue();
+    /* schedule the next background refresh with random jitter */
+    void scheduleRefresh(unsigned long lifetime);
+    /* the token is ready or the current token is still used while refreshing in background */
+    bool isTokenUsable();
+    /* update the time that requests were blocked waiting for the auth token */
+    void updateAuthBlocked(bool ready);
     /* Adjust the expiry time if system time synched or set. Adjust pre-refresh seconds to not exceed */
     void adjustTime(time_t &now);
     /* auth token was never been request or the last request was timed out */
@@ -163,6 +186,8 @@ private:
     bool handleError(int code, const char *descr, int errNum = 0);
     /* encode and sign the JWT token */
     bool createJWT();
+    /* decode and keep the RSA private key for JWT token signing */
+    bool initSigner();
     /* verifying the user with email/passwod to get id token */
     bool getIdToken(bool createUser, MB_StringPtr email, MB_StringPtr password);
     /* delete id token */
@@ -41,9 +41,214 @@
 
 #include "FirebaseJson.h"
 
+// The hooks are installed on first use, the static object in this file can be initialized
+// after the global FirebaseJson objects of other translation units were constructed
+static void fb_js_install_hooks()
+{
+    static bool installed = false;
+    if (!installed)
+    {
+        MB_JSON_InitHooks(&MB_JSON_hooks);
+        installed = true;
+    }
+}
+
+FirebaseJsonPool *FirebaseJsonPool::pools = nullptr;
+
+FirebaseJsonPool::FirebaseJsonPool(size_t slabSize)
+{
+    fb_js_install_hooks();
+    this->slabSize = slabSize;
+    memset(freeList, 0, sizeof(freeList));
+    allocator.allocate_fn = allocate;
+    allocator.context = this;
+    nextPool = pools;
+    pools = this;
+}
+
+FirebaseJsonPool::~FirebaseJsonPool()
+{
+    reset();
+
+    FirebaseJsonPool **p = &pools;
+    while (*p && *p != this)
+        p = &(*p)->nextPool;
+    if (*p)
+        *p = nextPool;
+}
+
+void *FirebaseJsonPool::allocate(void *context, size_t len)
+{
+    return reinterpret_cast<FirebaseJsonPool *>(context)->alloc(len);
+}
+
+FirebaseJsonPool::slab_t *FirebaseJsonPool::newSlab(size_t cap)
+{
+    slab_t *slab = reinterpret_cast<slab_t *>(fb_js_heap_alloc(sizeof(slab_t) + cap));
+    if (!slab)
+        return nullptr;
+
+    slab->size = cap;
+    slab->used = 0;
+    slabTotal += sizeof(slab_t) + cap;
+
+    uint8_t *begin = reinterpret_cast<uint8_t *>(slab + 1);
+    if (!rangeBegin || begin < rangeBegin)
+        rangeBegin = begin;
+    if (begin + cap > rangeEnd)
+        rangeEnd = begin + cap;
+
+    return slab;
+}
+
+void *FirebaseJsonPool::alloc(size_t len)
+{
+    // the block is prefixed with its size which the lowest bit is set for the MB_JSON node
+    const size_t unit = sizeof(size_t);
+    size_t size = len > 0 ? (len + unit - 1) / unit * unit : unit;
+    size_t need = size + unit;
+    size_t *block = nullptr;
+
+    if (size / unit <= FIREBASEJSON_POOL_FREE_LISTS && freeList[size / unit - 1])
+    {
+        void *p = freeList[size / unit - 1];
+        freeList[size / unit - 1] = *reinterpret_cast<void **>(p);
+        block = reinterpret_cast<size_t *>(p) - 1;
+    }
+    else if (size / unit > FIREBASEJSON_POOL_FREE_LISTS)
+    {
+        // the large block has its own slab which is returned to heap on release,
+        // it should not replace the current slab
+        slab_t *slab = newSlab(need);
+        if (!slab)
+            return nullptr;
+
+        if (slabs)
+        {
+            slab->next = slabs->next;
+            slabs->next = slab;
+        }
+        else
+        {
+            slab->next = nullptr;
+            slabs = slab;
+        }
+
+        block = reinterpret_cast<size_t *>(slab + 1);
+        slab->used = need;
+    }
+    else
+    {
+        if (!slabs || slabs->size - slabs->used < need)
+        {
+            slab_t *slab = newSlab(slabSize > need ? slabSize : need);
+            if (!slab)
+                return nullptr;
+            slab->next = slabs;
+            slabs = slab;
+        }
+
+        block = reinterpret_cast<size_t *>(reinterpret_cast<uint8_t *>(slabs + 1) + slabs->used);
+        slabs->used += need;
+    }
+
+    block[0] = size | (len == sizeof(MB_JSON) ? 1 : 0);
+
+    byteCount += size;
+    if (byteCount > bytePeak)
+        bytePeak = byteCount;
+
+    if (len == sizeof(MB_JSON))
+    {
+        nodeCount++;
+        if (nodeCount > nodePeak)
+            nodePeak = nodeCount;
+    }
+
+    return block + 1;
+}
+
+void FirebaseJsonPool::releaseBlock(void *ptr)
+{
+    size_t hdr = *(reinterpret_cast<size_t *>(ptr) - 1);
+    size_t size = hdr & ~(size_t)1;
+
+    byteCount -= size;
+    if (hdr & 1)
+        nodeCount--;
+
+    // the small blocks are reused, the slab of large block is freed
+    if (size / sizeof(size_t) <= FIREBASEJSON_POOL_FREE_LISTS)
+    {
+        *reinterpret_cast<void **>(ptr) = freeList[size / sizeof(size_t) - 1];
+        freeList[size / sizeof(size_t) - 1] = ptr;
+        return;
+    }
+
+    slab_t *slab = reinterpret_cast<slab_t *>(reinterpret_cast<size_t *>(ptr) - 1) - 1;
+    slab_t **p = &slabs;
+    while (*p && *p != slab)
+        p = &(*p)->next;
+
+    if (*p)
+    {
+        *p = slab->next;
+        slabTotal -= sizeof(slab_t) + slab->size;
+        free(slab);
+    }
+}
+
+FirebaseJsonPool *FirebaseJsonPool::owner(void *ptr)
+{
+    uint8_t *p = reinterpret_cast<uint8_t *>(ptr);
+    for (FirebaseJsonPool *pool = pools; pool; pool = pool->nextPool)
+    {
+        if (p < pool->rangeBegin || p >= pool->rangeEnd)
+            continue;
+
+        for (slab_t *slab = pool->slabs; slab; slab = slab->next)
+        {
+            uint8_t *begin = reinterpret_cast<uint8_t *>(slab + 1);
+            if (p > begin && p < begin + slab->used)
+                return pool;
+        }
+    }
+    return nullptr;
+}
+
+bool FirebaseJsonPool::release(void *ptr)
+{
+    FirebaseJsonPool *pool = owner(ptr);
+    if (pool)
+        pool->releaseBlock(ptr);
+    return pool != nullptr;
+}
+
+size_t FirebaseJsonPool::blockSize(void *ptr)
+{
+    return owner(ptr) ? *(reinterpret_cast<size_t *>(ptr) - 1) & ~(size_t)1 : 0;
+}
+
+void FirebaseJsonPool::reset()
+{
+    while (slabs)
+    {
+        slab_t *next = slabs->next;
+        free(slabs);
+        slabs = next;
+    }
+
+    memset(freeList, 0, sizeof(freeList));
+    rangeBegin = nullptr;
+    rangeEnd = nullptr;
+    slabTotal = 0;
+    nodeCount = 0;
+    byteCount = 0;
+}
+
 FirebaseJsonBase::FirebaseJsonBase()
 {
-    MB_JSON_InitHooks(&MB_JSON_hooks);
+    fb_js_install_hooks();
 }
 
 FirebaseJsonBase::~FirebaseJsonBase()
@@ -51,12 +256,13 @@ FirebaseJsonBase::~FirebaseJsonBase()
     mClear();
 }
 
+uint32_t FirebaseJsonBase::generations = 0;
+
 FirebaseJsonBase &FirebaseJsonBase::mClear()
 {
     mIteratorEnd();
-    if (root != NULL)
-        MB_JSON_Delete(root);
-    root = NULL;
+    mDeleteRoot();
+    mTouch();
     buf.clear();
     errorPos = -1;
     return *this;
@@ -90,6 +296,7 @@ bool FirebaseJsonBase::setRaw(const char *raw)
         {
             this->root_type = (raw[i] == '{') ? Root_Type_JSON : Root_Type_JSONArray;
             root = parse(raw);
+            mTouch(true);
         }
         else
         {
@@ -104,7 +311,7 @@ bool FirebaseJsonBase::setRaw(const char *raw)
 MB_JSON *FirebaseJsonBase::parse(const char *raw)
 {
     const char *s = NULL;
-    MB_JSON *e = MB_JSON_ParseWithOpts(raw, &s, 1);
+    MB_JSON *e = pool ? MB_JSON_ParseWithAllocator(raw, &s, 1, &pool->allocator) : MB_JSON_ParseWithOpts(raw, &s, 1);
     errorPos = (s - raw != (int)strlen(raw)) ? s - raw : -1;
     return e;
 }
@@ -117,16 +324,47 @@ void FirebaseJsonBase::prepareRoot()
             root = MB_JSON_CreateArray();
         else
             root = MB_JSON_CreateObject();
+        mTouch();
     }
 }
 
-void FirebaseJsonBase::searchElements(MB_VECTOR<MB_String> &keys, MB_JSON *parent, struct search_result_t &r)
+void FirebaseJsonBase::mTouch(bool pooledRoot)
+{
+    // the generations are unique among all objects, the compiled path cached node can't be
+    // taken as valid by other object that was created at the same address
+    generation = ++generations;
+    pooled = pooledRoot && pool != NULL;
+}
+
+void FirebaseJsonBase::mDeleteRoot()
+{
+    // the parsed root that was not modified contains only the pool blocks
+    // and it is released at once with the pool, except for the heap allocated member indexes
+    if (root != NULL && !pooled)
+        MB_JSON_Delete(root);
+    else if (root != NULL)
+        MB_JSON_DeleteIndexes(root);
+    root = NULL;
+    pooled = false;
+
+    if (pool)
+        pool->reset();
+}
+
+void FirebaseJsonBase::mSetPool(FirebaseJsonPool *pool)
+{
+    mClear();
+    this->pool = pool;
+}
+
+void FirebaseJsonBase::searchElements(MB_VECTOR<MB_String> &keys, MB_JSON *parent, struct search_result_t &r, MB_VECTOR<int> *indexes)
 {
     MB_JSON *e = parent;
     for (size_t i = 0; i < keys.size(); i++)
     {
         r.status = key_status_not_existed;
-        e = getElement(parent, keys[i].c_str(), r);
+        int index = indexes ? (*indexes)[i] : (isArrayKey(keys[i].c_str()) ? getArrIndex(keys[i].c_str()) : -1);
+        e = getElement(parent, keys[i].c_str(), index, r);
         r.stopIndex = i;
         if (r.status != key_status_existed)
         {
@@ -135,16 +373,16 @@ void FirebaseJsonBase::searchElements(MB_VECTOR<MB_String> &keys, MB_JSON *paren
             break;
         }
         r.parent = parent;
+        r.found = e;
         r.foundIndex = i;
         parent = e;
     }
 }
 
-MB_JSON *FirebaseJsonBase::getElement(MB_JSON *parent, const char *key, struct search_result_t &r)
+MB_JSON *FirebaseJsonBase::getElement(MB_JSON *parent, const char *key, int index, struct search_result_t &r)
 {
     MB_JSON *e = NULL;
-    bool isArrKey = isArrayKey(key);
-    int index = isArrKey ? getArrIndex(key) : -1;
+    bool isArrKey = index > -1;
     if ((isArray(parent) && !isArrKey) || (isObject(parent) && isArrKey))
         r.status = key_status_mistype;
     else if (isArray(parent) && isArrKey)
@@ -353,21 +591,21 @@ size_t FirebaseJsonBase::mIteratorBegin(MB_JSON *parent)
     MB_JSON_free(p);
     iterator_data.buf_size = buf.length();
     int index = -1;
-    mIterate(parent, index);
+    // the elements offsets are collected while walking the tree and the serialized buffer together
+    if (isArray(parent) || isObject(parent))
+        mIterate(parent, index, 0);
     return iterator_data.result.size();
 }
 
 size_t FirebaseJsonBase::mIteratorBegin(MB_JSON *parent, MB_VECTOR<MB_String> *keys)
 {
-    mIteratorEnd();
-
     if (keys == NULL)
+    {
+        mIteratorEnd();
         return 0;
+    }
 
-    int index = -1;
-    mIterate(parent, index);
-
-    return iterator_data.result.size();
+    return mIteratorBegin(parent);
 }
 
 void FirebaseJsonBase::mIteratorEnd(bool clearBuf)
@@ -385,50 +623,83 @@ void FirebaseJsonBase::mIteratorEnd(bool clearBuf)
     iterator_data.parentArr = NULL;
 }
 
-void FirebaseJsonBase::mIterate(MB_JSON *parent, int &arrIndex)
+size_t FirebaseJsonBase::mIterate(MB_JSON *parent, int &arrIndex, size_t pos)
 {
-    if (!parent)
-        return;
-
+    // pos is the offset of the parent's opening bracket in the unformatted buffer
     bool isAr = isArray(parent);
 
     if (isAr)
         arrIndex = 0;
 
+    pos++;
+
     MB_JSON *e = parent->child;
     if (e)
     {
         iterator_data.depth++;
         while (e)
         {
+            pos = mSkipIterator(pos, ',');
+
+            size_t keyOfs = 0, keyLen = 0;
+
+            if (e->string)
+            {
+                keyOfs = pos + 1;
+                pos = mSkipIteratorValue(pos);
+                keyLen = pos - keyOfs - 1;
+                pos = mSkipIterator(pos, ':');
+            }
+
+            size_t valOfs = pos;
+            int index = -1;
 
             if (isArray(e) || isObject(e))
-                mCollectIterator(e, e->string ? JSON_OBJECT : JSON_ARRAY, arrIndex);
+            {
+                index = iterator_data.result.size();
+                mCollectIterator(e, e->string ? JSON_OBJECT : JSON_ARRAY, keyOfs, keyLen, valOfs, 0);
+            }
 
             if (isArray(e))
             {
                 MB_JSON *item = e->child;
                 int _arrIndex = 0;
 
+                pos++;
+
                 if (e->child)
                 {
                     iterator_data.depth++;
                     while (item)
                     {
+                        pos = mSkipIterator(pos, ',');
 
                         if (isArray(item) || isObject(item))
-                            mIterate(item, _arrIndex);
+                            pos = mIterate(item, _arrIndex, pos);
                         else
-                            mCollectIterator(item, item->string ? JSON_OBJECT : JSON_ARRAY, _arrIndex);
+                        {
+                            size_t ofs = pos;
+                            pos = mSkipIteratorValue(pos);
+                            mCollectIterator(item, item->string ? JSON_OBJECT : JSON_ARRAY, 0, 0, ofs, pos - ofs);
+                        }
                         item = item->next;
                         _arrIndex++;
                     }
                 }
+
+                pos++;
             }
             else if (isObject(e))
-                mIterate(e, arrIndex);
+                pos = mIterate(e, arrIndex, pos);
             else
-                mCollectIterator(e, e->string ? JSON_OBJECT : JSON_ARRAY, arrIndex);
+            {
+                pos = mSkipIteratorValue(pos);
+                mCollectIterator(e, e->string ? JSON_OBJECT : JSON_ARRAY, keyOfs, keyLen, valOfs, pos - valOfs);
+            }
+
+            // the container length is known after its children were walked
+            if (index > -1)
+                iterator_data.result[index].len2 = pos - valOfs;
 
             e = e->next;
 
@@ -436,39 +707,54 @@ void FirebaseJsonBase::mIterate(MB_JSON *parent, int &arrIndex)
                 arrIndex++;
         }
     }
+
+    return pos + 1;
 }
 
-void FirebaseJsonBase::mCollectIterator(MB_JSON *e, int type, int &arrIndex)
+size_t FirebaseJsonBase::mSkipIterator(size_t pos, char c)
 {
-    struct iterator_result_t result;
+    if (pos < buf.length() && buf[pos] == c)
+        pos++;
+    return pos;
+}
+
+size_t FirebaseJsonBase::mSkipIteratorValue(size_t pos)
+{
+    // skip the string or primitive value (the containers were walked by mIterate)
+    size_t len = buf.length();
 
-    if (e->string)
+    if (pos < len && buf[pos] == '"')
     {
-        size_t pos = buf.find((const char *)e->string, iterator_data.buf_offset);
-        if (pos != MB_String::npos)
+        pos++;
+        while (pos < len && buf[pos] != '"')
         {
-            result.ofs1 = pos;
-            result.len1 = strlen(e->string);
-            iterator_data.buf_offset = (e->type != MB_JSON_Object && e->type != MB_JSON_Array) ? pos + result.len1 : pos;
+            if (buf[pos] == '\\')
+                pos++;
+            pos++;
         }
+        return pos + 1;
     }
 
-    char *p = MB_JSON_PrintUnformatted(e);
-    if (p)
-    {
-        if (result.ofs1 == 0)
-            result.ofs1 = iterator_data.buf_offset;
+    while (pos < len && buf[pos] != ',' && buf[pos] != '}' && buf[pos] != ']')
+        pos++;
 
-        int i = iterator_data.buf_offset;
-        size_t pos = buf.find(p, i);
-        if (pos != MB_String::npos)
-        {
-            result.ofs2 = pos - result.ofs1 - result.len1;
-            result.len2 = strlen(p);
-            MB_JSON_free(p);
-            iterator_data.buf_offset = (e->type != MB_JSON_Object && e->type != MB_JSON_Array) ? pos + result.len2 : pos;
-        }
+    return pos;
+}
+
+void FirebaseJsonBase::mCollectIterator(MB_JSON *e, int type, size_t keyOfs, size_t keyLen, size_t valOfs, size_t valLen)
+{
+    struct iterator_result_t result;
+
+    if (keyLen > 0)
+    {
+        result.ofs1 = keyOfs;
+        result.len1 = keyLen;
+        result.ofs2 = valOfs - keyOfs - keyLen;
     }
+    else
+        result.ofs1 = valOfs;
+
+    result.len2 = valLen;
     result.type = type;
     result.depth = iterator_data.depth;
     iterator_data.result.push_back(result);
@@ -549,9 +835,9 @@ bool FirebaseJsonBase::mReadClient(Client *client)
     buf.clear();
     if (readClient(client, buf))
     {
-        if (root != NULL)
-            MB_JSON_Delete(root);
+        mDeleteRoot();
         root = parse(buf.c_str());
+        mTouch(true);
         buf.clear();
         return root != NULL;
     }
@@ -563,9 +849,9 @@ bool FirebaseJsonBase::mReadStream(Stream *s, int timeoutMS)
     // non-blocking read
     if (readStream(s, serData, buf, true, timeoutMS))
     {
-        if (root != NULL)
-            MB_JSON_Delete(root);
+        mDeleteRoot();
         root = parse(buf.c_str());
+        mTouch(true);
         buf.clear();
         return root != NULL;
     }
@@ -578,9 +864,9 @@ bool FirebaseJsonBase::mReadSdFat(SD_FAT_FILE &file, int timeoutMS)
     // non-blocking read
     if (readSdFatFile(file, serData, buf, true, timeoutMS))
     {
-        if (root != NULL)
-            MB_JSON_Delete(root);
+        mDeleteRoot();
         root = parse(buf.c_str());
+        mTouch(true);
         buf.clear();
         return root != NULL;
     }
@@ -596,29 +882,39 @@ const char *FirebaseJsonBase::mRaw()
 
 bool FirebaseJsonBase::mRemove(const char *path)
 {
-    bool ret = false;
-    prepareRoot();
     MB_VECTOR<MB_String> keys = MB_VECTOR<MB_String>();
     makeList(path, keys, '/');
+    bool ret = mRemove(keys, NULL);
+    clearList(keys);
+    return ret;
+}
+
+bool FirebaseJsonBase::mRemove(FirebaseJsonPath &path)
+{
+    return mRemove(path.keys, &path.indexes);
+}
+
+bool FirebaseJsonBase::mRemove(MB_VECTOR<MB_String> &keys, MB_VECTOR<int> *indexes)
+{
+    bool ret = false;
+    prepareRoot();
 
     if (keys.size() > 0)
     {
-        if (isArrayKey(keys[0].c_str()) && root_type == Root_Type_JSON)
-        {
-            clearList(keys);
+        if ((indexes ? (*indexes)[0] > -1 : isArrayKey(keys[0].c_str())) && root_type == Root_Type_JSON)
             return false;
-        }
     }
 
     MB_JSON *parent = root;
 
     struct search_result_t r;
-    searchElements(keys, parent, r);
+    searchElements(keys, parent, r, indexes);
     parent = r.parent;
 
     if (r.status == key_status_existed)
     {
         ret = true;
+        mTouch();
         if (isArray(parent))
             MB_JSON_DeleteItemFromArray(parent, getArrIndex(keys[r.stopIndex].c_str()));
         else
@@ -633,7 +929,6 @@ bool FirebaseJsonBase::mRemove(const char *path)
         }
     }
 
-    clearList(keys);
     return ret;
 }
 
@@ -690,39 +985,69 @@ bool FirebaseJsonBase::mGet(MB_JSON *parent, FirebaseJsonData *result, const cha
         }
     }
 
-    MB_JSON *_parent = parent;
     struct search_result_t r;
     searchElements(keys, parent, r);
-    _parent = r.parent;
 
-    if (r.status == key_status_existed)
+    if (r.status == key_status_existed && r.found != NULL)
     {
-        MB_JSON *data = NULL;
-        if (isArray(_parent))
-            data = MB_JSON_GetArrayItem(_parent, getArrIndex(keys[r.stopIndex].c_str()));
-        else
-            data = MB_JSON_GetObjectItemCaseSensitive(_parent, keys[r.stopIndex].c_str());
-
-        if (data != NULL)
-        {
-            if (result != NULL)
-            {
-                result->clear();
-                char *p = prettify ? MB_JSON_Print(data) : MB_JSON_PrintUnformatted(data);
-                result->stringValue = p;
-                MB_JSON_free(p);
-                result->type_num = data->type;
-                result->success = true;
-                mSetElementType(result);
-            }
-            ret = true;
-        }
+        mSetResult(result, r.found, prettify);
+        ret = true;
     }
 
     clearList(keys);
     return ret;
 }
 
+bool FirebaseJsonBase::mGet(FirebaseJsonData *result, FirebaseJsonPath &path, bool prettify)
+{
+    prepareRoot();
+
+    // resolve the node once for this tree generation
+    if (path.owner != this || path.generation != generation)
+    {
+        path.owner = this;
+        path.generation = generation;
+        path.node = NULL;
+
+        if (path.keys.size() > 0 && path.indexes[0] > -1 && root_type == Root_Type_JSON)
+            return false;
+
+        struct search_result_t r;
+        searchElements(path.keys, root, r, &path.indexes);
+
+        if (r.status == key_status_existed)
+            path.node = r.found;
+    }
+
+    if (path.node == NULL)
+        return false;
+
+    mSetResult(result, path.node, prettify);
+    return true;
+}
+
+void FirebaseJsonBase::mSetResult(FirebaseJsonData *result, MB_JSON *data, bool prettify)
+{
+    if (result == NULL)
+        return;
+
+    result->clear();
+    char *p = prettify ? MB_JSON_Print(data) : MB_JSON_PrintUnformatted(data);
+    result->stringValue = p;
+    MB_JSON_free(p);
+    result->type_num = data->type;
+    result->success = true;
+    mSetElementType(result);
+}
+
+void FirebaseJsonBase::mCompilePath(FirebaseJsonPath &path, const char *str)
+{
+    path.clear();
+    makeList(str, path.keys, '/');
+    for (size_t i = 0; i < path.keys.size(); i++)
+        path.indexes.push_back(isArrayKey(path.keys[i].c_str()) ? getArrIndex(path.keys[i].c_str()) : -1);
+}
+
 void FirebaseJsonBase::mSetResInt(FirebaseJsonData *data, const char *value)
 {
     if (strlen(value) > 0)
@@ -746,7 +1071,7 @@ void FirebaseJsonBase::mSetResFloat(FirebaseJsonData *data, const char *value)
     if (strlen(value) > 0)
     {
         char *pEnd;
-        data->fVal.setd(strtod(value, &pEnd));
+        data->fVal.setd(MB_JSON_StrToDouble(value, &pEnd));
     }
     else
         data->fVal.setd(0);
@@ -815,8 +1140,7 @@ void FirebaseJsonBase::mSetElementType(FirebaseJsonData *result)
 
         if (strpos(result->stringValue.c_str(), (const char *)MBSTRING_FLASH_MCR("."), 0) > -1)
         {
-            double d = atof(result->stringValue.c_str());
-            if (d > 0x7fffffff)
+            if (result->doubleValue > 0x7fffffff)
             {
                 strcpy(buf, (const char *)MBSTRING_FLASH_MCR("double"));
                 result->typeNum = JSON_DOUBLE;
@@ -840,23 +1164,35 @@ void FirebaseJsonBase::mSetElementType(FirebaseJsonData *result)
 
 void FirebaseJsonBase::mSet(const char *path, MB_JSON *value)
 {
-    prepareRoot();
     MB_VECTOR<MB_String> keys = MB_VECTOR<MB_String>();
     makeList(path, keys, '/');
+    mSet(keys, NULL, value);
+    clearList(keys);
+}
+
+void FirebaseJsonBase::mSet(FirebaseJsonPath &path, MB_JSON *value)
+{
+    mSet(path.keys, &path.indexes, value);
+}
+
+void FirebaseJsonBase::mSet(MB_VECTOR<MB_String> &keys, MB_VECTOR<int> *indexes, MB_JSON *value)
+{
+    prepareRoot();
+    mTouch();
 
     if (keys.size() > 0)
     {
-        if ((isArrayKey(keys[0].c_str()) && root_type == Root_Type_JSON) || (!isArrayKey(keys[0].c_str()) && root_type == Root_Type_JSONArray))
+        bool isArrKey = indexes ? (*indexes)[0] > -1 : isArrayKey(keys[0].c_str());
+        if ((isArrKey && root_type == Root_Type_JSON) || (!isArrKey && root_type == Root_Type_JSONArray))
         {
             MB_JSON_Delete(value);
-            clearList(keys);
             return;
         }
     }
 
     MB_JSON *parent = root;
     struct search_result_t r;
-    searchElements(keys, parent, r);
+    searchElements(keys, parent, r, indexes);
     parent = r.parent;
 
     if (value == NULL)
@@ -870,8 +1206,6 @@ void FirebaseJsonBase::mSet(const char *path, MB_JSON *value)
         replace(keys, r, parent, value);
     else
         MB_JSON_Delete(value);
-
-    clearList(keys);
 }
 
 #if defined(__AVR__)
@@ -918,7 +1252,10 @@ FirebaseJson &FirebaseJson::nAdd(const char *key, MB_JSON *value)
     if (keys.size() > 0)
     {
         if (!isArrayKey(keys[0].c_str()) || root_type == Root_Type_JSONArray)
+        {
+            mTouch();
             mAdd(keys, &root, 0, value);
+        }
     }
 
     clearList(keys);
@@ -962,6 +1299,7 @@ FirebaseJsonArray &FirebaseJsonArray::nAdd(MB_JSON *value)
     if (value == NULL)
         value = MB_JSON_CreateNull();
 
+    mTouch();
     MB_JSON_AddItemToArray(root, value);
 
     return *this;
@@ -999,6 +1337,7 @@ bool FirebaseJsonArray::mSetIdx(int index, MB_JSON *value)
     root_type = Root_Type_JSONArray;
 
     prepareRoot();
+    mTouch();
 
     int size = MB_JSON_GetArraySize(root);
     if (index < size)
@@ -1020,6 +1359,7 @@ bool FirebaseJsonArray::mRemoveIdx(int index)
     int size = MB_JSON_GetArraySize(root);
     if (index < size)
     {
+        mTouch();
         MB_JSON_DeleteItemFromArray(root, index);
         return size != MB_JSON_GetArraySize(root);
     }
@@ -1065,10 +1405,9 @@ bool FirebaseJsonData::getArray(FirebaseJsonArray &jsonArray)
 bool FirebaseJsonData::mGetArray(const char *source, FirebaseJsonArray &jsonArray)
 {
 
-    if (jsonArray.root != NULL)
-        MB_JSON_Delete(jsonArray.root);
-
+    jsonArray.mDeleteRoot();
     jsonArray.root = jsonArray.parse(source);
+    jsonArray.mTouch(true);
 
     return jsonArray.root != NULL;
 }
@@ -1082,10 +1421,9 @@ bool FirebaseJsonData::getJSON(FirebaseJson &json)
 
 bool FirebaseJsonData::mGetJSON(const char *source, FirebaseJson &json)
 {
-    if (json.root != NULL)
-        MB_JSON_Delete(json.root);
-
+    json.mDeleteRoot();
     json.root = json.parse(source);
+    json.mTouch(true);
 
     return json.root != NULL;
 }
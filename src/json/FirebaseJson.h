@@ -203,6 +203,113 @@ static const char fb_json_str_9[] PROGMEM = "Location: ";
 class FirebaseJson;
 class FirebaseJsonArray;
 class FirebaseJsonData;
+class FirebaseJsonPath;
+
+#if !defined(FIREBASEJSON_POOL_SLAB_SIZE)
+#define FIREBASEJSON_POOL_SLAB_SIZE 1024
+#endif
+
+// the number of free lists of the released blocks (for block size up to 16 alignment units)
+#define FIREBASEJSON_POOL_FREE_LISTS 16
+
+/**
+ * The slab allocator of the MB_JSON nodes and their key and value strings which parsed by FirebaseJson or FirebaseJsonArray object.
+ *
+ * Set the pool to FirebaseJson or FirebaseJsonArray object with setPool, the parsed document will be allocated
+ * from the large slabs instead of many small heap allocations and the whole document will be released at once
+ * when the object was cleared or parsed again.
+ *
+ * The pool should be used by only one object and it should not be destroyed before the object that uses it.
+ * The large blocks (more than FIREBASEJSON_POOL_FREE_LISTS alignment units) are allocated in their own slabs
+ * which are returned to heap when the blocks were released.
+ */
+class FirebaseJsonPool
+{
+    friend class FirebaseJsonBase;
+
+public:
+    FirebaseJsonPool(size_t slabSize = FIREBASEJSON_POOL_SLAB_SIZE);
+    ~FirebaseJsonPool();
+
+    /**
+     * Get the number of nodes currently allocated from the pool.
+     * @return number of nodes.
+     */
+    size_t nodes() { return nodeCount; }
+
+    /**
+     * Get the maximum number of nodes that were allocated from the pool at the same time.
+     * @return number of nodes.
+     */
+    size_t peakNodes() { return nodePeak; }
+
+    /**
+     * Get the size of blocks currently allocated from the pool.
+     * @return size in bytes.
+     */
+    size_t bytes() { return byteCount; }
+
+    /**
+     * Get the maximum size of blocks that were allocated from the pool at the same time.
+     * @return size in bytes.
+     */
+    size_t peakBytes() { return bytePeak; }
+
+    /**
+     * Get the size of heap memory held by the pool slabs.
+     * @return size in bytes.
+     */
+    size_t slabBytes() { return slabTotal; }
+
+    /**
+     * Reset the peak nodes and bytes counters to the current values.
+     */
+    void resetPeak()
+    {
+        nodePeak = nodeCount;
+        bytePeak = byteCount;
+    }
+
+    // The MB_JSON_Allocator function
+    static void *allocate(void *context, size_t len);
+
+    // Return the block to the pool that owns it, return false for the heap block
+    static bool release(void *ptr);
+
+    // Get the size of block that owned by the pool or 0 for the heap block
+    static size_t blockSize(void *ptr);
+
+    // Get the pool which its slabs contain the block or NULL for the heap block
+    static FirebaseJsonPool *owner(void *ptr);
+
+private:
+    struct slab_t
+    {
+        slab_t *next;
+        size_t size;
+        size_t used;
+    };
+
+    // the list of all pools, the pool block is told apart from heap block by the address of its slabs
+    static FirebaseJsonPool *pools;
+    FirebaseJsonPool *nextPool = nullptr;
+    slab_t *slabs = nullptr;
+    uint8_t *rangeBegin = nullptr;
+    uint8_t *rangeEnd = nullptr;
+    void *freeList[FIREBASEJSON_POOL_FREE_LISTS];
+    size_t slabSize = FIREBASEJSON_POOL_SLAB_SIZE;
+    size_t slabTotal = 0;
+    size_t nodeCount = 0;
+    size_t nodePeak = 0;
+    size_t byteCount = 0;
+    size_t bytePeak = 0;
+    MB_JSON_Allocator allocator;
+
+    void *alloc(size_t len);
+    slab_t *newSlab(size_t cap);
+    void releaseBlock(void *ptr);
+    void reset();
+};
 
 static size_t getReservedLen(size_t len)
 {
@@ -216,10 +323,9 @@ static size_t getReservedLen(size_t len)
     return (size_t)newlen;
 }
 
-static void *fb_js_malloc(size_t len)
+static void *fb_js_heap_alloc(size_t newLen)
 {
     void *p;
-    size_t newLen = getReservedLen(len);
 
 #if defined(BOARD_HAS_PSRAM) && defined(MB_STRING_USE_PSRAM)
     if (ESP.getPsramSize() > 0)
@@ -247,14 +353,33 @@ static void *fb_js_malloc(size_t len)
     return p;
 }
 
+static void *fb_js_malloc(size_t len)
+{
+    return fb_js_heap_alloc(getReservedLen(len));
+}
+
 static void fb_js_free(void *ptr)
 {
-    if (ptr)
+    // the block of pool is returned to its pool
+    if (ptr && !FirebaseJsonPool::release(ptr))
         free(ptr);
 }
 
 static void *fb_js_realloc(void *ptr, size_t sz)
 {
+    // the block of pool is moved to heap
+    size_t blockLen = ptr ? FirebaseJsonPool::blockSize(ptr) : 0;
+    if (blockLen > 0)
+    {
+        void *p = fb_js_malloc(sz);
+        if (p)
+        {
+            memcpy(p, ptr, blockLen < sz ? blockLen : sz);
+            FirebaseJsonPool::release(ptr);
+        }
+        return p;
+    }
+
     size_t newLen = getReservedLen(sz);
 #if defined(BOARD_HAS_PSRAM) && defined(MB_STRING_USE_PSRAM)
     if (ESP.getPsramSize() > 0)
@@ -274,9 +399,6 @@ static void *fb_js_realloc(void *ptr, size_t sz)
 #endif
 
 #endif
-    if (!ptr)
-        return NULL;
-
     return ptr;
 }
 
@@ -552,8 +674,56 @@ private:
     }
 };
 
+/**
+ * The compiled relative path to the node in FirebaseJson object which returned from FirebaseJson::compilePath.
+ *
+ * The path segments are split and the array indexes are parsed once, the resolved node is cached
+ * until the FirebaseJson object that it was resolved from was modified.
+ */
+class FirebaseJsonPath
+{
+    friend class FirebaseJsonBase;
+    friend class FirebaseJson;
+
+public:
+    FirebaseJsonPath(){};
+    ~FirebaseJsonPath() { clear(); };
+
+    /**
+     * Get the number of path segments (node names and array indexes).
+     *
+     * @return number of path segments.
+     */
+    size_t size() { return keys.size(); }
+
+    /**
+     * Clear the compiled path and its cached node.
+     */
+    void clear()
+    {
+        keys.clear();
+        indexes.clear();
+        node = NULL;
+        owner = NULL;
+        generation = 0;
+    }
+
+private:
+    MB_VECTOR<MB_String> keys;
+    // the array index of the path segment or -1 for node name
+    MB_VECTOR<int> indexes;
+    // the resolved node (NULL for not existed) and the object and its generation that it was resolved from
+    MB_JSON *node = NULL;
+    const void *owner = NULL;
+    uint32_t generation = 0;
+};
+
+class FB_RTDB;
+
 class FirebaseJsonBase
 {
+    // The error queue processing reads the parsed tree of the queued object.
+    friend class FB_RTDB;
     friend class FirebaseJson;
     friend class FirebaseJsonArray;
     friend class FirebaseJsonData;
@@ -577,6 +747,7 @@ private:
     struct search_result_t
     {
         MB_JSON *parent = NULL;
+        MB_JSON *found = NULL;
         key_status status = key_status_not_existed;
         int foundIndex = -1;
         int stopIndex = 0;
@@ -617,8 +788,8 @@ private:
     bool setRaw(const char *raw);
     void prepareRoot();
     MB_JSON *parse(const char *raw);
-    void searchElements(MB_VECTOR<MB_String> &keys, MB_JSON *parent, struct search_result_t &r);
-    MB_JSON *getElement(MB_JSON *parent, const char *key, struct search_result_t &r);
+    void searchElements(MB_VECTOR<MB_String> &keys, MB_JSON *parent, struct search_result_t &r, MB_VECTOR<int> *indexes = NULL);
+    MB_JSON *getElement(MB_JSON *parent, const char *key, int index, struct search_result_t &r);
     void mAdd(MB_VECTOR<MB_String> keys, MB_JSON **parent, int beginIndex, MB_JSON *value);
     void makeList(const MB_String &str, MB_VECTOR<MB_String> &keys, char delim);
     void pushLish(const MB_String &str, MB_VECTOR<MB_String> &keys);
@@ -631,8 +802,10 @@ private:
     void replace(MB_VECTOR<MB_String> &keys, struct search_result_t &r, MB_JSON *parent, MB_JSON *item);
     size_t mIteratorBegin(MB_JSON *parent);
     size_t mIteratorBegin(MB_JSON *parent, MB_VECTOR<MB_String> *keys);
-    void mCollectIterator(MB_JSON *e, int type, int &arrIndex);
-    void mIterate(MB_JSON *parent, int &arrIndex);
+    void mCollectIterator(MB_JSON *e, int type, size_t keyOfs, size_t keyLen, size_t valOfs, size_t valLen);
+    size_t mIterate(MB_JSON *parent, int &arrIndex, size_t pos);
+    size_t mSkipIterator(size_t pos, char c);
+    size_t mSkipIteratorValue(size_t pos);
     int mIteratorGet(size_t index, int &type, String &key, String &value);
     struct fb_js_iterator_value_t mValueAt(size_t index);
     void toBuf(fb_json_serialize_mode mode);
@@ -643,16 +816,26 @@ private:
 #endif
     const char *mRaw();
     bool mRemove(const char *path);
+    bool mRemove(MB_VECTOR<MB_String> &keys, MB_VECTOR<int> *indexes);
+    bool mRemove(FirebaseJsonPath &path);
     void mGetPath(MB_String &path, MB_VECTOR<MB_String> paths, int begin = 0, int end = -1);
     size_t mGetSerializedBufferLength(bool prettify);
     void mSetFloatDigits(uint8_t digits);
     void mSetDoubleDigits(uint8_t digits);
     int mResponseCode();
     bool mGet(MB_JSON *parent, FirebaseJsonData *result, const char *path, bool prettify = false);
+    bool mGet(FirebaseJsonData *result, FirebaseJsonPath &path, bool prettify = false);
+    void mSetResult(FirebaseJsonData *result, MB_JSON *data, bool prettify);
     void mSetResInt(FirebaseJsonData *data, const char *value);
     void mSetResFloat(FirebaseJsonData *data, const char *value);
     void mSetElementType(FirebaseJsonData *result);
     void mSet(const char *path, MB_JSON *value);
+    void mSet(MB_VECTOR<MB_String> &keys, MB_VECTOR<int> *indexes, MB_JSON *value);
+    void mSet(FirebaseJsonPath &path, MB_JSON *value);
+    void mCompilePath(FirebaseJsonPath &path, const char *str);
+    void mTouch(bool pooledRoot = false);
+    void mDeleteRoot();
+    void mSetPool(FirebaseJsonPool *pool);
     void mCopy(FirebaseJsonBase &other);
 #if defined(__AVR__)
     unsigned long long strtoull_alt(const char *s);
@@ -701,7 +884,13 @@ protected:
     fb_json_root_type root_type = Root_Type_JSON;
     struct iterator_data_t iterator_data;
     MB_JSON *root = NULL;
+    // changed whenever the tree was modified, the compiled paths cached nodes are valid for this generation only
+    uint32_t generation = 0;
+    static uint32_t generations;
     MB_JSON_Hooks *hooks = NULL;
+    // the pool of the parsed document and the flag that root was parsed into the pool and not modified
+    FirebaseJsonPool *pool = NULL;
+    bool pooled = false;
     MB_String buf;
 
     template <typename T>
@@ -2001,6 +2190,15 @@ public:
      */
     void setDoubleDigits(uint8_t digits) { mSetDoubleDigits(digits); }
 
+    /**
+     * Set the memory pool of the parsed JSON Array object.
+     * @param pool The pointer to FirebaseJsonPool object or NULL to use heap.
+     *
+     * @note The current data will be cleared.
+     * The parsed array that was not modified will be released at once when it was cleared or parsed again.
+     */
+    void setPool(FirebaseJsonPool *pool) { mSetPool(pool); }
+
     /**
      * Get http response code of reading JSON data from WiFi/Ethernet Client.
      * @return the response code of reading JSON data from WiFi/Ethernet Client
@@ -2595,6 +2793,71 @@ public:
         return ret;
     }
 
+    /**
+     * Compile the relative path for the repeated get, set, remove and isMember calls.
+     *
+     * @param path The relative path to the specific node in FirebaseJson object.
+     * @return FirebaseJsonPath object that holds the split path segments and the parsed array indexes.
+     *
+     * @note The compiled path can be used with any FirebaseJson object, the resolved node is
+     * cached in the compiled path and reused until the FirebaseJson object was modified.
+     */
+    template <typename T>
+    FirebaseJsonPath compilePath(T path)
+    {
+        FirebaseJsonPath compiled;
+        uint32_t addr = 0;
+        mCompilePath(compiled, getStr(path, addr));
+        delAddr(addr);
+        return compiled;
+    }
+
+    /**
+     * Get the FirebaseJson object data at the compiled path.
+     *
+     * @param result The reference of FirebaseJsonData that holds the result.
+     * @param path The compiled path from compilePath.
+     * @param prettify The text indentation and new line serialization option.
+     * @return boolean status of the operation.
+     */
+    bool get(FirebaseJsonData &result, FirebaseJsonPath &path, bool prettify = false) { return mGet(&result, path, prettify); }
+
+    /**
+     * Check whether the element at the compiled path existed in FirebaseJson object or not.
+     *
+     * @param path The compiled path from compilePath.
+     * @return boolean status indicated the existence of element.
+     */
+    bool isMember(FirebaseJsonPath &path) { return mGet(NULL, path); }
+
+    /**
+     * Set null to FirebaseJson object at the compiled path.
+     *
+     * @param path The compiled path from compilePath.
+     */
+    void set(FirebaseJsonPath &path) { mSet(path, NULL); }
+
+    /**
+     * Set value to FirebaseJson object at the compiled path.
+     *
+     * @param path The compiled path from compilePath.
+     * @param value The value to set.
+     */
+    template <typename T>
+    FirebaseJson &set(FirebaseJsonPath &path, T value) { return pathSetHandler(path, toItem(value)); }
+
+    FirebaseJson &set(FirebaseJsonPath &path, FirebaseJson &value) { return pathSetHandler(path, toItem(value)); }
+
+    FirebaseJson &set(FirebaseJsonPath &path, FirebaseJsonArray &value) { return pathSetHandler(path, toItem(value)); }
+
+    /**
+     * Remove the node and its content at the compiled path.
+     *
+     * @param path The compiled path from compilePath.
+     * @return bool value represents the success operation.
+     */
+    bool remove(FirebaseJsonPath &path) { return mRemove(path); }
+
     /**
      * Get raw JSON
      * @return raw JSON string
@@ -2626,6 +2889,15 @@ public:
      */
     void setDoubleDigits(uint8_t digits) { mSetDoubleDigits(digits); }
 
+    /**
+     * Set the memory pool of the parsed JSON object.
+     * @param pool The pointer to FirebaseJsonPool object or NULL to use heap.
+     *
+     * @note The current data will be cleared.
+     * The parsed object that was not modified will be released at once when it was cleared or parsed again.
+     */
+    void setPool(FirebaseJsonPool *pool) { mSetPool(pool); }
+
     /**
      * Get http response code of reading JSON data from WiFi/Ethernet Client.
      * @return the response code of reading JSON data from WiFi/Ethernet Client
@@ -2758,6 +3030,54 @@ private:
         return *this;
     }
 
+    FirebaseJson &pathSetHandler(FirebaseJsonPath &path, MB_JSON *e)
+    {
+        if (root_type != Root_Type_JSON)
+            mClear();
+
+        root_type = Root_Type_JSON;
+
+        mSet(path, e);
+        return *this;
+    }
+
+    template <typename T>
+    auto toItem(T value) -> typename std::enable_if<is_bool<T>::value, MB_JSON *>::type
+    {
+        return MB_JSON_CreateBool(value);
+    }
+
+    template <typename T>
+    auto toItem(T value) -> typename std::enable_if<is_num_int<T>::value, MB_JSON *>::type
+    {
+        return MB_JSON_CreateRaw(num2Str(value, -1));
+    }
+
+    template <typename T>
+    auto toItem(T value) -> typename std::enable_if<std::is_same<T, float>::value, MB_JSON *>::type
+    {
+        return MB_JSON_CreateRaw(num2Str(value, floatDigits));
+    }
+
+    template <typename T>
+    auto toItem(T value) -> typename std::enable_if<std::is_same<T, double>::value || std::is_same<T, long double>::value, MB_JSON *>::type
+    {
+        return MB_JSON_CreateRaw(num2Str(value, doubleDigits));
+    }
+
+    template <typename T>
+    auto toItem(T value) -> typename std::enable_if<is_string<T>::value, MB_JSON *>::type
+    {
+        uint32_t addr = 0;
+        MB_JSON *e = MB_JSON_CreateString(getStr(value, addr));
+        delAddr(addr);
+        return e;
+    }
+
+    MB_JSON *toItem(FirebaseJson &json) { return MB_JSON_Duplicate(json.root, true); }
+
+    MB_JSON *toItem(FirebaseJsonArray &arr) { return MB_JSON_Duplicate(arr.root, true); }
+
     void delAddr(uint32_t addr)
     {
         if (addr > 0)
@@ -0,0 +1,489 @@
+/*
+ * FirebaseJsonReader, version 1.0.0
+ *
+ * The streaming JSON reader that parses the JSON text chunk by chunk and reports every element
+ * as (path, type, value) event without building the JSON tree.
+ *
+ * Created October 17, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2023 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FirebaseJsonReader_CPP
+#define FirebaseJsonReader_CPP
+
+#include "FirebaseJsonReader.h"
+
+FirebaseJsonReader::FirebaseJsonReader()
+{
+    reset();
+}
+
+FirebaseJsonReader::~FirebaseJsonReader()
+{
+    if (buf)
+        delete[] buf;
+    buf = nullptr;
+}
+
+void FirebaseJsonReader::begin(FirebaseJsonReaderCallback callback, size_t valueSize)
+{
+    cb = callback;
+
+    if (valueSize < FIREBASE_JSON_READER_MIN_VALUE_SIZE)
+        valueSize = FIREBASE_JSON_READER_MIN_VALUE_SIZE;
+
+    if (valueSize != bufSize)
+    {
+        if (buf)
+            delete[] buf;
+        buf = new char[valueSize + 1];
+        bufSize = valueSize;
+    }
+
+    reset();
+}
+
+void FirebaseJsonReader::reset()
+{
+    state = reader_state_value;
+    inKey = false;
+    depth = 0;
+    containers[0] = 0;
+    indexes[0] = 0;
+    pathLens[0] = 0;
+    path.clear();
+    bufLen = 0;
+    codePoint = 0;
+    highSurrogate = 0;
+    hexCount = 0;
+    pos = 0;
+    errorPos = -1;
+}
+
+bool FirebaseJsonReader::parse(const char *data, size_t len)
+{
+    if (state == reader_state_error)
+        return false;
+
+    if (!buf)
+        begin(cb);
+
+    for (size_t i = 0; i < len; i++)
+    {
+        if (!step(data[i]))
+        {
+            state = reader_state_error;
+            errorPos = pos;
+            return false;
+        }
+        pos++;
+    }
+
+    return true;
+}
+
+bool FirebaseJsonReader::end()
+{
+    // the number or literal at the root has no terminating character
+    if (state == reader_state_literal && depth == 0)
+    {
+        if (endLiteral())
+            state = reader_state_done;
+        else
+        {
+            state = reader_state_error;
+            errorPos = pos;
+        }
+    }
+
+    return state == reader_state_done;
+}
+
+bool FirebaseJsonReader::step(char c)
+{
+    switch (state)
+    {
+    case reader_state_value:
+        return isSpace(c) || beginValue(c);
+
+    case reader_state_value_or_end:
+        if (isSpace(c))
+            return true;
+        return c == ']' ? afterValue(c) : beginValue(c);
+
+    case reader_state_key_or_end:
+        if (c == '}')
+            return afterValue(c);
+        // fall through
+
+    case reader_state_key:
+        if (isSpace(c))
+            return true;
+        if (c != '"')
+            return false;
+        // the key is unescaped to the path directly
+        path.erase(pathLens[depth], path.length() - pathLens[depth]);
+        path += '/';
+        inKey = true;
+        state = reader_state_string;
+        return true;
+
+    case reader_state_colon:
+        if (isSpace(c))
+            return true;
+        if (c != ':')
+            return false;
+        state = reader_state_value;
+        return true;
+
+    case reader_state_after_value:
+        return isSpace(c) || afterValue(c);
+
+    case reader_state_string:
+        if (c == '\\')
+        {
+            state = reader_state_escape;
+            return true;
+        }
+
+        endSurrogate();
+
+        if (c == '"')
+        {
+            if (inKey)
+            {
+                inKey = false;
+                state = reader_state_colon;
+            }
+            else
+            {
+                emit(FirebaseJson::JSON_STRING);
+                state = depth == 0 ? reader_state_done : reader_state_after_value;
+            }
+        }
+        else if ((uint8_t)c < 0x20)
+            return false;
+        else
+            appendChar(c);
+        return true;
+
+    case reader_state_escape:
+        state = reader_state_string;
+        if (c != 'u')
+            endSurrogate();
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            appendChar(c);
+            return true;
+        case 'b':
+            appendChar('\b');
+            return true;
+        case 'f':
+            appendChar('\f');
+            return true;
+        case 'n':
+            appendChar('\n');
+            return true;
+        case 'r':
+            appendChar('\r');
+            return true;
+        case 't':
+            appendChar('\t');
+            return true;
+        case 'u':
+            codePoint = 0;
+            hexCount = 0;
+            state = reader_state_unicode;
+            return true;
+        default:
+            return false;
+        }
+
+    case reader_state_unicode:
+        if (c >= '0' && c <= '9')
+            codePoint = (codePoint << 4) | (c - '0');
+        else if (c >= 'a' && c <= 'f')
+            codePoint = (codePoint << 4) | (c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            codePoint = (codePoint << 4) | (c - 'A' + 10);
+        else
+            return false;
+
+        if (++hexCount == 4)
+        {
+            state = reader_state_string;
+
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                endSurrogate();
+                highSurrogate = codePoint; // wait for the low surrogate
+            }
+            else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+            {
+                // the lone low surrogate is replaced with U+FFFD
+                codePoint = highSurrogate ? 0x10000 + ((highSurrogate - 0xD800) << 10) + (codePoint - 0xDC00) : 0xFFFD;
+                highSurrogate = 0;
+                appendCodePoint(codePoint);
+            }
+            else
+            {
+                endSurrogate();
+                appendCodePoint(codePoint);
+            }
+        }
+        return true;
+
+    case reader_state_literal:
+        if (isalnum(c) || c == '.' || c == '+' || c == '-')
+        {
+            if (bufLen >= bufSize)
+                return false;
+            buf[bufLen++] = c;
+            return true;
+        }
+
+        if (!endLiteral())
+            return false;
+
+        state = depth == 0 ? reader_state_done : reader_state_after_value;
+        return step(c);
+
+    case reader_state_done:
+        return isSpace(c);
+
+    default:
+        return false;
+    }
+}
+
+bool FirebaseJsonReader::beginValue(char c)
+{
+    beginElement();
+    bufLen = 0;
+
+    if (c == '{' || c == '[')
+    {
+        if (depth == FIREBASE_JSON_READER_MAX_DEPTH)
+            return false;
+
+        emit(c == '{' ? FirebaseJson::JSON_OBJECT : FirebaseJson::JSON_ARRAY);
+
+        depth++;
+        containers[depth] = c;
+        indexes[depth] = 0;
+        pathLens[depth] = path.length();
+        state = c == '{' ? reader_state_key_or_end : reader_state_value_or_end;
+        return true;
+    }
+
+    if (c == '"')
+    {
+        inKey = false;
+        state = reader_state_string;
+        return true;
+    }
+
+    if (c == '-' || isdigit(c) || c == 't' || c == 'f' || c == 'n')
+    {
+        buf[bufLen++] = c;
+        state = reader_state_literal;
+        return true;
+    }
+
+    return false;
+}
+
+bool FirebaseJsonReader::afterValue(char c)
+{
+    if (c == ',')
+    {
+        state = containers[depth] == '{' ? reader_state_key : reader_state_value;
+        return true;
+    }
+
+    if ((c == '}' && containers[depth] == '{') || (c == ']' && containers[depth] == '['))
+    {
+        depth--;
+        state = depth == 0 ? reader_state_done : reader_state_after_value;
+        return true;
+    }
+
+    return false;
+}
+
+void FirebaseJsonReader::beginElement()
+{
+    if (depth == 0)
+        path.clear();
+    else if (containers[depth] == '[')
+    {
+        // array element path e.g. /a/[2]
+        path.erase(pathLens[depth], path.length() - pathLens[depth]);
+        path += '/';
+        path += '[';
+        path += (int)indexes[depth]++;
+        path += ']';
+    }
+    // the object member path was set while parsing its key
+}
+
+void FirebaseJsonReader::appendChar(char c)
+{
+    if (inKey)
+    {
+        // the path separator and escape character in key are escaped
+        if (c == '/' || c == '\\')
+            path += '\\';
+        path += c;
+        return;
+    }
+
+    // the large string is reported in parts
+    if (bufLen == bufSize)
+    {
+        emit(FirebaseJson::JSON_STRING, true);
+        bufLen = 0;
+    }
+
+    buf[bufLen++] = c;
+}
+
+void FirebaseJsonReader::appendCodePoint(uint32_t cp)
+{
+    if (cp < 0x80)
+        appendChar(cp);
+    else if (cp < 0x800)
+    {
+        appendChar(0xC0 | (cp >> 6));
+        appendChar(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+        appendChar(0xE0 | (cp >> 12));
+        appendChar(0x80 | ((cp >> 6) & 0x3F));
+        appendChar(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+        appendChar(0xF0 | (cp >> 18));
+        appendChar(0x80 | ((cp >> 12) & 0x3F));
+        appendChar(0x80 | ((cp >> 6) & 0x3F));
+        appendChar(0x80 | (cp & 0x3F));
+    }
+}
+
+void FirebaseJsonReader::endSurrogate()
+{
+    // the high surrogate that is not followed by the low surrogate is replaced with U+FFFD
+    if (highSurrogate)
+    {
+        highSurrogate = 0;
+        appendCodePoint(0xFFFD);
+    }
+}
+
+bool FirebaseJsonReader::endLiteral()
+{
+    buf[bufLen] = 0;
+
+    if (strcmp(buf, "true") == 0 || strcmp(buf, "false") == 0)
+    {
+        emit(FirebaseJson::JSON_BOOL);
+        return true;
+    }
+
+    if (strcmp(buf, "null") == 0)
+    {
+        emit(FirebaseJson::JSON_NULL);
+        return true;
+    }
+
+    // number, -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    bool real = false;
+    size_t i = buf[0] == '-' ? 1 : 0;
+
+    // the leading zero e.g. 01 is not allowed
+    if (!isdigit(buf[i]) || (buf[i] == '0' && isdigit(buf[i + 1])))
+        return false;
+
+    while (isdigit(buf[i]))
+        i++;
+
+    if (buf[i] == '.')
+    {
+        real = true;
+        if (!isdigit(buf[++i]))
+            return false;
+        while (isdigit(buf[i]))
+            i++;
+    }
+
+    if (buf[i] == 'e' || buf[i] == 'E')
+    {
+        real = true;
+        if (buf[++i] == '+' || buf[i] == '-')
+            i++;
+        if (!isdigit(buf[i]))
+            return false;
+        while (isdigit(buf[i]))
+            i++;
+    }
+
+    if (i != bufLen)
+        return false;
+
+    char *pEnd = nullptr;
+    double d = MB_JSON_StrToDouble(buf, &pEnd);
+    if (!pEnd || *pEnd != 0)
+        return false;
+
+    if (real)
+        emit(d > 0x7fffffff ? FirebaseJson::JSON_DOUBLE : FirebaseJson::JSON_FLOAT);
+    else
+        emit(FirebaseJson::JSON_INT);
+
+    return true;
+}
+
+void FirebaseJsonReader::emit(int type, bool partial)
+{
+    if (!cb)
+        return;
+
+    bool container = type == FirebaseJson::JSON_OBJECT || type == FirebaseJson::JSON_ARRAY;
+    buf[bufLen] = 0;
+
+    FirebaseJsonReaderEvent event;
+    event.path = path.length() > 0 ? path.c_str() : "/";
+    event.type = type;
+    event.value = container ? "" : buf;
+    event.length = container ? 0 : bufLen;
+    event.partial = partial;
+    event.depth = depth;
+    cb(event);
+}
+
+#endif
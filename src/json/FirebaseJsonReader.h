@@ -0,0 +1,170 @@
+/*
+ * FirebaseJsonReader, version 1.0.0
+ *
+ * The streaming JSON reader that parses the JSON text chunk by chunk and reports every element
+ * as (path, type, value) event without building the JSON tree.
+ *
+ * Created October 17, 2026
+ *
+ * The MIT License (MIT)
+ * Copyright (c) 2023 K. Suwatchai (Mobizt)
+ *
+ *
+ * Permission is hereby granted, free of charge, to any person returning a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FirebaseJsonReader_H
+#define FirebaseJsonReader_H
+
+#include <Arduino.h>
+#include "FirebaseJson.h"
+
+// The maximum nesting level of objects and arrays
+#ifndef FIREBASE_JSON_READER_MAX_DEPTH
+#define FIREBASE_JSON_READER_MAX_DEPTH 32
+#endif
+
+// The default and minimum size of the value buffer
+#define FIREBASE_JSON_READER_VALUE_SIZE 256
+#define FIREBASE_JSON_READER_MIN_VALUE_SIZE 32
+
+typedef struct firebase_json_reader_event_t
+{
+    // The path of element e.g. /a/b/[2]/c, the path of the root element is /.
+    // The '/' and '\' in the object key are escaped with '\' e.g. the key "a/b" is /a\/b.
+    const char *path = "";
+    // The type of element, FirebaseJson::JSON_OBJECT, JSON_ARRAY, JSON_STRING, JSON_INT,
+    // JSON_FLOAT, JSON_DOUBLE, JSON_BOOL or JSON_NULL.
+    int type = 0;
+    // The unescaped string or the number, true, false and null literal, empty for object and array.
+    const char *value = "";
+    size_t length = 0;
+    // The string value is continued in the next event (the value is larger than the value buffer).
+    bool partial = false;
+    // The nesting level of element, the root element is 0.
+    int depth = 0;
+} FirebaseJsonReaderEvent;
+
+typedef void (*FirebaseJsonReaderCallback)(FirebaseJsonReaderEvent);
+
+class FirebaseJsonReader
+{
+public:
+    FirebaseJsonReader();
+    ~FirebaseJsonReader();
+
+    /**
+     * Set the callback function and the value buffer size.
+     *
+     * @param callback The callback function that accepts FirebaseJsonReaderEvent parameter.
+     * @param valueSize The value buffer size, the string value that is larger than this size will be
+     * reported in more than one event with the partial flag set.
+     */
+    void begin(FirebaseJsonReaderCallback callback, size_t valueSize = FIREBASE_JSON_READER_VALUE_SIZE);
+
+    /**
+     * Parse the next chunk of JSON text.
+     *
+     * @param data The JSON text chunk.
+     * @param len The length of chunk.
+     * @return boolean status of the operation, false when the JSON text is not valid.
+     */
+    bool parse(const char *data, size_t len);
+
+    bool parse(const char *data) { return parse(data, strlen(data)); }
+
+    /**
+     * Finish parsing.
+     *
+     * @return boolean status, true when the complete JSON text was parsed.
+     */
+    bool end();
+
+    /**
+     * Reset the parsing state to parse the new JSON text.
+     */
+    void reset();
+
+    /**
+     * Get the parsing status.
+     *
+     * @return boolean status, true when the complete JSON text was parsed.
+     */
+    bool isComplete() { return state == reader_state_done; }
+
+    /**
+     * Get the position of the invalid character.
+     *
+     * @return position of invalid character or -1 when no error.
+     */
+    int errorPosition() { return errorPos; }
+
+    /**
+     * Get the number of parsed bytes.
+     *
+     * @return number of parsed bytes.
+     */
+    size_t parsedLength() { return pos; }
+
+private:
+    enum reader_state
+    {
+        reader_state_value,
+        reader_state_value_or_end,
+        reader_state_key,
+        reader_state_key_or_end,
+        reader_state_colon,
+        reader_state_after_value,
+        reader_state_string,
+        reader_state_escape,
+        reader_state_unicode,
+        reader_state_literal,
+        reader_state_done,
+        reader_state_error
+    };
+
+    FirebaseJsonReaderCallback cb = NULL;
+    reader_state state = reader_state_value;
+    bool inKey = false;
+    int depth = 0;
+    uint8_t containers[FIREBASE_JSON_READER_MAX_DEPTH + 1];
+    uint32_t indexes[FIREBASE_JSON_READER_MAX_DEPTH + 1];
+    size_t pathLens[FIREBASE_JSON_READER_MAX_DEPTH + 1];
+    MB_String path;
+    char *buf = nullptr;
+    size_t bufSize = 0;
+    size_t bufLen = 0;
+    uint32_t codePoint = 0;
+    uint16_t highSurrogate = 0;
+    uint8_t hexCount = 0;
+    size_t pos = 0;
+    int errorPos = -1;
+
+    bool step(char c);
+    bool beginValue(char c);
+    bool afterValue(char c);
+    void beginElement();
+    void appendChar(char c);
+    void appendCodePoint(uint32_t cp);
+    void endSurrogate();
+    bool endLiteral();
+    void emit(int type, bool partial = false);
+    bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+};
+
+#endif
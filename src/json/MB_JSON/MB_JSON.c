@@ -53,6 +53,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <stdint.h>
 #include <ctype.h>
 #include <float.h>
 
@@ -175,8 +176,13 @@ typedef struct MB_JSON_internal_hooks
     void *(MB_JSON_CDECL *allocate)(size_t size);
     void(MB_JSON_CDECL *deallocate)(void *pointer);
     void *(MB_JSON_CDECL *reallocate)(void *pointer, size_t size);
+    /* the allocator with context that takes precedence over allocate */
+    void *(MB_JSON_CDECL *allocate_with)(void *context, size_t size);
+    void *context;
 } MB_JSON_internal_hooks;
 
+#define MB_JSON_hooks_allocate(hooks, size) (((hooks)->allocate_with != NULL) ? (hooks)->allocate_with((hooks)->context, (size)) : (hooks)->allocate(size))
+
 #if defined(_MSC_VER)
 /* work around MSVC error C2322: '...' address of dllimport '...' is not static */
 static void *MB_JSON_CDECL internal_malloc(size_t size)
@@ -200,7 +206,7 @@ static void *MB_JSON_CDECL internal_realloc(void *pointer, size_t size)
 /* strlen of character literals resolved at compile time */
 #define MB_JSON_static_strlen(string_literal) (sizeof(string_literal) - sizeof(""))
 
-static MB_JSON_internal_hooks MB_JSON_global_hooks = {MB_JSON_internal_malloc, MB_JSON_internal_free, MB_JSON_internal_realloc};
+static MB_JSON_internal_hooks MB_JSON_global_hooks = {MB_JSON_internal_malloc, MB_JSON_internal_free, MB_JSON_internal_realloc, NULL, NULL};
 
 static unsigned char *MB_JSON_strdup(const unsigned char *string, const MB_JSON_internal_hooks *const hooks)
 {
@@ -255,10 +261,116 @@ MB_JSON_InitHooks(MB_JSON_Hooks *hooks)
     }
 }
 
+#if MB_JSON_INDEX_THRESHOLD > 0
+
+/* Open addressing table of the object members, built in the member list order
+ * and it is never updated but dropped on the member list changes. */
+typedef struct MB_JSON_index
+{
+    size_t mask;
+    MB_JSON **slots;
+} MB_JSON_index;
+
+/* FNV-1a hash of the case folded key, then the case insensitive lookup can use the same index. */
+static size_t MB_JSON_index_hash(const unsigned char *key)
+{
+    unsigned long hash = 2166136261UL;
+    for (; *key != '\0'; key++)
+    {
+        hash ^= (unsigned char)tolower(*key);
+        hash *= 16777619UL;
+    }
+    return (size_t)hash;
+}
+
+/* The number of the allocated indexes, the pooled document walk for its indexes is skipped when there is none. */
+static size_t MB_JSON_index_count = 0;
+
+static void MB_JSON_index_drop(MB_JSON *object)
+{
+    if (object->index != NULL)
+    {
+        MB_JSON_global_hooks.deallocate(object->index);
+        object->index = NULL;
+        MB_JSON_index_count--;
+    }
+}
+
+static void MB_JSON_index_build(MB_JSON *object)
+{
+    MB_JSON *item = NULL;
+    MB_JSON_index *index = NULL;
+    size_t count = 0;
+    size_t size = 8;
+    size_t pos = 0;
+
+    for (item = object->child; item != NULL; item = item->next)
+    {
+        count++;
+    }
+
+    /* keep the load factor below 0.75 */
+    while (size * 3 <= count * 4)
+    {
+        size <<= 1;
+    }
+
+    index = (MB_JSON_index *)MB_JSON_global_hooks.allocate(sizeof(MB_JSON_index) + size * sizeof(MB_JSON *));
+    if (index == NULL)
+    {
+        return;
+    }
+
+    index->mask = size - 1;
+    index->slots = (MB_JSON **)(index + 1);
+    memset(index->slots, 0, size * sizeof(MB_JSON *));
+
+    /* With linear probing, the first one of the duplicate keys is always found first as in the list walk. */
+    for (item = object->child; item != NULL; item = item->next)
+    {
+        if (item->string == NULL)
+        {
+            continue;
+        }
+
+        pos = MB_JSON_index_hash((const unsigned char *)item->string) & index->mask;
+        while (index->slots[pos] != NULL)
+        {
+            pos = (pos + 1) & index->mask;
+        }
+        index->slots[pos] = item;
+    }
+
+    object->index = index;
+    MB_JSON_index_count++;
+}
+
+static MB_JSON *MB_JSON_index_find(const MB_JSON_index *const index, const char *const name, const MB_JSON_bool case_sensitive)
+{
+    MB_JSON *item = NULL;
+    size_t pos = MB_JSON_index_hash((const unsigned char *)name) & index->mask;
+
+    while ((item = index->slots[pos]) != NULL)
+    {
+        if (case_sensitive ? (strcmp(name, item->string) == 0) : (MB_JSON_case_insensitive_strcmp((const unsigned char *)name, (const unsigned char *)item->string) == 0))
+        {
+            return item;
+        }
+        pos = (pos + 1) & index->mask;
+    }
+
+    return NULL;
+}
+
+#else
+#define MB_JSON_index_drop(object)
+#define MB_JSON_index_count 0
+#endif
+
 /* Internal constructor. */
 static MB_JSON *MB_JSON_New_Item(const MB_JSON_internal_hooks *const hooks)
 {
-    MB_JSON *node = (MB_JSON *)hooks->allocate(sizeof(MB_JSON));
+    MB_JSON *node = (MB_JSON *)MB_JSON_hooks_allocate(hooks, sizeof(MB_JSON));
     if (node)
     {
         memset(node, '\0', sizeof(MB_JSON));
@@ -267,6 +379,21 @@ static MB_JSON *MB_JSON_New_Item(const MB_JSON_internal_hooks *const hooks)
     return node;
 }
 
+/* Delete the member indexes of a MB_JSON structure which its nodes are released at once e.g. by the memory pool. */
+MB_JSON_PUBLIC(void)
+MB_JSON_DeleteIndexes(MB_JSON *item)
+{
+    while (item != NULL && MB_JSON_index_count > 0)
+    {
+        if (!(item->type & MB_JSON_IsReference) && (item->child != NULL))
+        {
+            MB_JSON_DeleteIndexes(item->child);
+        }
+        MB_JSON_index_drop(item);
+        item = item->next;
+    }
+}
+
 /* Delete a MB_JSON structure. */
 MB_JSON_PUBLIC(void)
 MB_JSON_Delete(MB_JSON *item)
@@ -287,6 +414,7 @@ MB_JSON_Delete(MB_JSON *item)
         {
             MB_JSON_global_hooks.deallocate(item->string);
         }
+        MB_JSON_index_drop(item);
         MB_JSON_global_hooks.deallocate(item);
         item = next;
     }
@@ -320,6 +448,161 @@ typedef struct
 /* get a pointer to the buffer at the position */
 #define MB_JSON_buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
+/* Decimal to double conversion fast path (Clinger): when the significand fits in 53 bits and
+ * the decimal exponent is within the exactly representable powers of ten, one multiplication
+ * or division gives the correctly rounded result. Anything else is left to strtod. */
+static const double MB_JSON_exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static MB_JSON_bool MB_JSON_parse_double_fast(const unsigned char *const string, unsigned char decimal_point, double *const number, size_t *const length)
+{
+    const unsigned char *p = string;
+    uint64_t significand = 0;
+    int digits = 0;
+    int fraction_digits = 0;
+    int exponent = 0;
+    MB_JSON_bool negative = false;
+    MB_JSON_bool any = false;
+    double value = 0.0;
+
+    if (*p == '-')
+    {
+        negative = true;
+        p++;
+    }
+    else if (*p == '+')
+    {
+        p++;
+    }
+
+    for (; (*p >= '0') && (*p <= '9'); p++)
+    {
+        any = true;
+        if ((significand != 0) || (*p != '0'))
+        {
+            if (++digits > 19)
+            {
+                return false;
+            }
+            significand = significand * 10 + (uint64_t)(*p - '0');
+        }
+    }
+
+    if (*p == decimal_point)
+    {
+        p++;
+        if ((*p < '0') || (*p > '9'))
+        {
+            return false;
+        }
+        for (; (*p >= '0') && (*p <= '9'); p++)
+        {
+            any = true;
+            fraction_digits++;
+            if ((significand != 0) || (*p != '0'))
+            {
+                if (++digits > 19)
+                {
+                    return false;
+                }
+                significand = significand * 10 + (uint64_t)(*p - '0');
+            }
+        }
+    }
+
+    if (!any)
+    {
+        return false;
+    }
+
+    if ((*p == 'e') || (*p == 'E'))
+    {
+        const unsigned char *q = p + 1;
+        MB_JSON_bool exponent_negative = false;
+        if (*q == '-')
+        {
+            exponent_negative = true;
+            q++;
+        }
+        else if (*q == '+')
+        {
+            q++;
+        }
+        if ((*q < '0') || (*q > '9'))
+        {
+            return false;
+        }
+        for (; (*q >= '0') && (*q <= '9'); q++)
+        {
+            if (exponent < 10000)
+            {
+                exponent = exponent * 10 + (*q - '0');
+            }
+        }
+        if (exponent_negative)
+        {
+            exponent = -exponent;
+        }
+        p = q;
+    }
+
+    exponent -= fraction_digits;
+
+    if (significand != 0)
+    {
+        if ((significand > ((uint64_t)1 << 53)) || (exponent < -22) || (exponent > 22))
+        {
+            return false;
+        }
+        value = (double)significand;
+        if (exponent < 0)
+        {
+            value /= MB_JSON_exact_pow10[-exponent];
+        }
+        else
+        {
+            value *= MB_JSON_exact_pow10[exponent];
+        }
+    }
+
+    *number = negative ? -value : value;
+    *length = (size_t)(p - string);
+    return true;
+}
+
+MB_JSON_PUBLIC(double)
+MB_JSON_StrToDouble(const char *string, char **end)
+{
+    double number = 0.0;
+    size_t length = 0;
+
+    if (string == NULL)
+    {
+        if (end != NULL)
+        {
+            *end = NULL;
+        }
+        return 0.0;
+    }
+
+    while ((*string == ' ') || (*string == '\t') || (*string == '\r') || (*string == '\n'))
+    {
+        string++;
+    }
+
+    if (MB_JSON_parse_double_fast((const unsigned char *)string, '.', &number, &length))
+    {
+        if (end != NULL)
+        {
+            *end = (char *)string + length;
+        }
+        return number;
+    }
+
+    return strtod(string, end);
+}
+
 /* Parse the input text to generate a number, and populate the result into item. */
 static MB_JSON_bool MB_JSON_parse_number(MB_JSON *const item, MB_JSON_parse_buffer *const input_buffer)
 {
@@ -328,6 +611,7 @@ static MB_JSON_bool MB_JSON_parse_number(MB_JSON *const item, MB_JSON_parse_buff
     unsigned char number_c_string[64];
     unsigned char decimal_point = MB_JSON_get_decimal_point();
     size_t i = 0;
+    MB_JSON_bool decimal = false;
 
     if ((input_buffer == NULL) || (input_buffer->content == NULL))
     {
@@ -353,13 +637,18 @@ static MB_JSON_bool MB_JSON_parse_number(MB_JSON *const item, MB_JSON_parse_buff
         case '9':
         case '+':
         case '-':
+            number_c_string[i] = MB_JSON_buffer_at_offset(input_buffer)[i];
+            break;
+
         case 'e':
         case 'E':
             number_c_string[i] = MB_JSON_buffer_at_offset(input_buffer)[i];
+            decimal = true;
             break;
 
         case '.':
             number_c_string[i] = decimal_point;
+            decimal = true;
             break;
 
         default:
@@ -369,10 +658,17 @@ static MB_JSON_bool MB_JSON_parse_number(MB_JSON *const item, MB_JSON_parse_buff
 loop_end:
     number_c_string[i] = '\0';
 
-    number = strtod((const char *)number_c_string, (char **)&after_end);
-    if (number_c_string == after_end)
+    if (MB_JSON_parse_double_fast(number_c_string, decimal_point, &number, &i))
     {
-        return false; /* parse_error */
+        after_end = number_c_string + i;
+    }
+    else
+    {
+        number = strtod((const char *)number_c_string, (char **)&after_end);
+        if (number_c_string == after_end)
+        {
+            return false; /* parse_error */
+        }
     }
 
     item->valuedouble = number;
@@ -391,7 +687,7 @@ loop_end:
         item->valueint = (int)number;
     }
 
-    item->type = MB_JSON_Number;
+    item->type = MB_JSON_Number | (decimal ? MB_JSON_NumberIsDecimal : 0);
 
     input_buffer->offset += (size_t)(after_end - number_c_string);
     return true;
@@ -570,6 +866,307 @@ static MB_JSON_bool MB_JSON_compare_double(double a, double b)
     return (fabs(a - b) <= maxVal * DBL_EPSILON);
 }
 
+/* Double to shortest decimal digits (Grisu2, F. Loitsch, "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers"). The digits always read back to the same double and
+ * are the shortest in all but a tiny fraction of inputs, without any floating-point arithmetic. */
+typedef struct
+{
+    uint64_t f;
+    int e;
+} MB_JSON_diy_fp;
+
+/* normalized 10^k for k = -348, -340, ..., 340 */
+static const uint64_t MB_JSON_cached_powers_f[] = {
+    0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL,
+    0xCF42894A5DCE35EAULL, 0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL,
+    0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL, 0xBE5691EF416BD60CULL,
+    0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+    0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL,
+    0xC21094364DFB5637ULL, 0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL,
+    0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL, 0xB23867FB2A35B28EULL,
+    0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+    0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL,
+    0xB5B5ADA8AAFF80B8ULL, 0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL,
+    0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL, 0xA6DFBD9FB8E5B88FULL,
+    0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+    0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL,
+    0xAA242499697392D3ULL, 0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL,
+    0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL, 0x9C40000000000000ULL,
+    0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+    0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL,
+    0x9F4F2726179A2245ULL, 0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL,
+    0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL, 0x924D692CA61BE758ULL,
+    0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+    0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL,
+    0x952AB45CFA97A0B3ULL, 0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL,
+    0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL, 0x88FCF317F22241E2ULL,
+    0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+    0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL,
+    0x8BAB8EEFB6409C1AULL, 0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL,
+    0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL, 0x80444B5E7AA7CF85ULL,
+    0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+    0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL};
+
+static const int16_t MB_JSON_cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066};
+
+static const uint32_t MB_JSON_pow10_u32[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+static MB_JSON_diy_fp MB_JSON_diy_fp_multiply(MB_JSON_diy_fp x, MB_JSON_diy_fp y)
+{
+    const uint64_t mask = 0xFFFFFFFFULL;
+    uint64_t a = x.f >> 32, b = x.f & mask, c = y.f >> 32, d = y.f & mask;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask) + (1ULL << 31);
+    MB_JSON_diy_fp r;
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+static void MB_JSON_grisu_round(char *buffer, int length, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+    while ((rest < wp_w) && (delta - rest >= ten_kappa) &&
+           ((rest + ten_kappa < wp_w) || (wp_w - rest > rest + ten_kappa - wp_w)))
+    {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static int MB_JSON_grisu_digits(MB_JSON_diy_fp w, MB_JSON_diy_fp mp, uint64_t delta, char *buffer, int *k)
+{
+    const int shift = -mp.e;
+    const uint64_t one = 1ULL << shift;
+    const uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> shift);
+    uint64_t p2 = mp.f & (one - 1);
+    uint64_t scale = 1;
+    int kappa = 1;
+    int length = 0;
+
+    while ((kappa < 10) && (p1 >= MB_JSON_pow10_u32[kappa]))
+    {
+        kappa++;
+    }
+
+    while (kappa > 0)
+    {
+        uint64_t rest = 0;
+        uint32_t d = p1 / MB_JSON_pow10_u32[kappa - 1];
+        p1 %= MB_JSON_pow10_u32[kappa - 1];
+        if ((d != 0) || (length != 0))
+        {
+            buffer[length++] = (char)('0' + d);
+        }
+        kappa--;
+        rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta)
+        {
+            *k += kappa;
+            MB_JSON_grisu_round(buffer, length, delta, rest, (uint64_t)MB_JSON_pow10_u32[kappa] << shift, wp_w);
+            return length;
+        }
+    }
+
+    for (;;)
+    {
+        char d = 0;
+        p2 *= 10;
+        delta *= 10;
+        d = (char)(p2 >> shift);
+        if ((d != 0) || (length != 0))
+        {
+            buffer[length++] = (char)('0' + d);
+        }
+        p2 &= one - 1;
+        kappa--;
+        scale = (kappa > -20) ? scale * 10 : 0;
+        if (p2 < delta)
+        {
+            *k += kappa;
+            MB_JSON_grisu_round(buffer, length, delta, p2, one, wp_w * scale);
+            return length;
+        }
+    }
+}
+
+/* writes the significant digits of a finite positive double, value = digits * 10^k */
+static int MB_JSON_grisu2(double value, char *buffer, int *k)
+{
+    uint64_t bits = 0;
+    int biased_exponent = 0;
+    double dk = 0.0;
+    int ik = 0;
+    unsigned index = 0;
+    MB_JSON_diy_fp v, w_plus, w_minus, c_mk, w;
+
+    memcpy(&bits, &value, sizeof(bits));
+    biased_exponent = (int)((bits >> 52) & 0x7FF);
+    v.f = bits & 0x000FFFFFFFFFFFFFULL;
+    if (biased_exponent != 0)
+    {
+        v.f += 0x0010000000000000ULL;
+        v.e = biased_exponent - 1075;
+    }
+    else
+    {
+        v.e = -1074;
+    }
+
+    /* boundaries m+ and m-, m- sharing the exponent of the normalized m+ */
+    w_plus.f = (v.f << 1) + 1;
+    w_plus.e = v.e - 1;
+    while (!(w_plus.f & 0x0020000000000000ULL))
+    {
+        w_plus.f <<= 1;
+        w_plus.e--;
+    }
+    w_plus.f <<= 10;
+    w_plus.e -= 10;
+
+    if (v.f == 0x0010000000000000ULL)
+    {
+        w_minus.f = (v.f << 2) - 1;
+        w_minus.e = v.e - 2;
+    }
+    else
+    {
+        w_minus.f = (v.f << 1) - 1;
+        w_minus.e = v.e - 1;
+    }
+    w_minus.f <<= w_minus.e - w_plus.e;
+    w_minus.e = w_plus.e;
+
+    w = v;
+    while (!(w.f & 0x8000000000000000ULL))
+    {
+        w.f <<= 1;
+        w.e--;
+    }
+
+    /* cached power bringing the exponent into [-60, -32] */
+    dk = (-61 - w_plus.e) * 0.30102999566398114 + 347;
+    ik = (int)dk;
+    if (dk - ik > 0.0)
+    {
+        ik++;
+    }
+    index = (unsigned)((ik >> 3) + 1);
+    *k = -(-348 + (int)(index << 3));
+    c_mk.f = MB_JSON_cached_powers_f[index];
+    c_mk.e = MB_JSON_cached_powers_e[index];
+
+    w = MB_JSON_diy_fp_multiply(w, c_mk);
+    w_plus = MB_JSON_diy_fp_multiply(w_plus, c_mk);
+    w_minus = MB_JSON_diy_fp_multiply(w_minus, c_mk);
+    w_minus.f++;
+    w_plus.f--;
+
+    return MB_JSON_grisu_digits(w, w_plus, w_plus.f - w_minus.f, buffer, k);
+}
+
+/* Print a finite double the way "%1.15g" / "%1.17g" would, but with the shortest round-trip digits. */
+static int MB_JSON_print_double(double d, unsigned char *output, unsigned char decimal_point)
+{
+    char digits[20];
+    int length = 0;
+    int k = 0;
+    int exponent = 0;
+    int pos = 0;
+    int i = 0;
+
+    if (signbit(d))
+    {
+        output[pos++] = '-';
+        d = -d;
+    }
+
+    if (d == 0.0)
+    {
+        output[pos++] = '0';
+        output[pos] = '\0';
+        return pos;
+    }
+
+    length = MB_JSON_grisu2(d, digits, &k);
+    while ((length > 1) && (digits[length - 1] == '0'))
+    {
+        length--;
+        k++;
+    }
+    exponent = length + k - 1;
+
+    if ((exponent < -4) || (exponent >= (length <= 15 ? 15 : 17)))
+    {
+        output[pos++] = (unsigned char)digits[0];
+        if (length > 1)
+        {
+            output[pos++] = decimal_point;
+            for (i = 1; i < length; i++)
+            {
+                output[pos++] = (unsigned char)digits[i];
+            }
+        }
+        output[pos++] = 'e';
+        if (exponent < 0)
+        {
+            output[pos++] = '-';
+            exponent = -exponent;
+        }
+        else
+        {
+            output[pos++] = '+';
+        }
+        if (exponent >= 100)
+        {
+            output[pos++] = (unsigned char)('0' + exponent / 100);
+            exponent %= 100;
+        }
+        output[pos++] = (unsigned char)('0' + exponent / 10);
+        output[pos++] = (unsigned char)('0' + exponent % 10);
+    }
+    else if (exponent >= 0)
+    {
+        for (i = 0; i <= exponent; i++)
+        {
+            output[pos++] = (unsigned char)(i < length ? digits[i] : '0');
+        }
+        if (length > exponent + 1)
+        {
+            output[pos++] = decimal_point;
+            for (i = exponent + 1; i < length; i++)
+            {
+                output[pos++] = (unsigned char)digits[i];
+            }
+        }
+    }
+    else
+    {
+        output[pos++] = '0';
+        output[pos++] = decimal_point;
+        for (i = -1; i > exponent; i--)
+        {
+            output[pos++] = '0';
+        }
+        for (i = 0; i < length; i++)
+        {
+            output[pos++] = (unsigned char)digits[i];
+        }
+    }
+
+    output[pos] = '\0';
+    return pos;
+}
+
 /* Render the number nicely from the given item into a string. */
 static MB_JSON_bool MB_JSON_print_number(const MB_JSON *const item, MB_JSON_printbuffer *const output_buffer)
 {
@@ -579,7 +1176,6 @@ static MB_JSON_bool MB_JSON_print_number(const MB_JSON *const item, MB_JSON_prin
     size_t i = 0;
     unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
     unsigned char decimal_point = MB_JSON_get_decimal_point();
-    double test = 0.0;
 
     if (output_buffer == NULL)
     {
@@ -593,15 +1189,8 @@ static MB_JSON_bool MB_JSON_print_number(const MB_JSON *const item, MB_JSON_prin
     }
     else
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char *)number_buffer, "%1.15g", d);
-
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char *)number_buffer, "%lg", &test) != 1) || !MB_JSON_compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char *)number_buffer, "%1.17g", d);
-        }
+        /* shortest digits that read back to the same double */
+        length = MB_JSON_print_double(d, number_buffer, decimal_point);
     }
 
     /* sprintf failed or buffer overrun occurred */
@@ -833,7 +1422,7 @@ static MB_JSON_bool MB_JSON_parse_string(MB_JSON *const item, MB_JSON_parse_buff
 
         /* This is at most how much we need for the output */
         allocation_length = (size_t)(input_end - MB_JSON_buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char *)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        output = (unsigned char *)MB_JSON_hooks_allocate(&input_buffer->hooks, allocation_length + sizeof(""));
         if (output == NULL)
         {
             goto fail; /* allocation failure */
@@ -1102,6 +1691,7 @@ static MB_JSON_bool MB_JSON_print_string(const MB_JSON *const item, MB_JSON_prin
 
 /* Predeclare these prototypes. */
 static MB_JSON_bool MB_JSON_parse_value(MB_JSON *const item, MB_JSON_parse_buffer *const input_buffer);
+static MB_JSON *MB_JSON_parse_with_hooks(const char *value, size_t buffer_length, const char **return_parse_end, MB_JSON_bool require_null_terminated, const MB_JSON_internal_hooks *const hooks);
 static MB_JSON_bool MB_JSON_print_value(const MB_JSON *const item, MB_JSON_printbuffer *const output_buffer);
 static MB_JSON_bool MB_JSON_parse_array(MB_JSON *const item, MB_JSON_parse_buffer *const input_buffer);
 static MB_JSON_bool MB_JSON_print_array(const MB_JSON *const item, MB_JSON_printbuffer *const output_buffer);
@@ -1170,11 +1760,36 @@ MB_JSON_ParseWithOpts(const char *value, const char **return_parse_end, MB_JSON_
     return MB_JSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
 }
 
-/* Parse an object - create a new root, and populate. */
+MB_JSON_PUBLIC(MB_JSON *)
+MB_JSON_ParseWithAllocator(const char *value, const char **return_parse_end, MB_JSON_bool require_null_terminated, const MB_JSON_Allocator *allocator)
+{
+    MB_JSON_internal_hooks hooks = MB_JSON_global_hooks;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    if ((allocator != NULL) && (allocator->allocate_fn != NULL))
+    {
+        hooks.allocate_with = allocator->allocate_fn;
+        hooks.context = allocator->context;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    return MB_JSON_parse_with_hooks(value, strlen(value) + sizeof(""), return_parse_end, require_null_terminated, &hooks);
+}
+
 MB_JSON_PUBLIC(MB_JSON *)
 MB_JSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, MB_JSON_bool require_null_terminated)
 {
-    MB_JSON_parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0}};
+    return MB_JSON_parse_with_hooks(value, buffer_length, return_parse_end, require_null_terminated, &MB_JSON_global_hooks);
+}
+
+/* Parse an object - create a new root, and populate. */
+static MB_JSON *MB_JSON_parse_with_hooks(const char *value, size_t buffer_length, const char **return_parse_end, MB_JSON_bool require_null_terminated, const MB_JSON_internal_hooks *const hooks)
+{
+    MB_JSON_parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0, 0, 0}};
     MB_JSON *item = NULL;
 
     /* reset error position */
@@ -1189,9 +1804,9 @@ MB_JSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char
     buffer.content = (const unsigned char *)value;
     buffer.length = buffer_length;
     buffer.offset = 0;
-    buffer.hooks = MB_JSON_global_hooks;
+    buffer.hooks = *hooks;
 
-    item = MB_JSON_New_Item(&MB_JSON_global_hooks);
+    item = MB_JSON_New_Item(hooks);
     if (item == NULL) /* memory fail */
     {
         goto fail;
@@ -1358,7 +1973,7 @@ MB_JSON_PrintUnformatted(const MB_JSON *item)
 MB_JSON_PUBLIC(char *)
 MB_JSON_PrintBuffered(const MB_JSON *item, int prebuffer, MB_JSON_bool fmt)
 {
-    MB_JSON_printbuffer p = {0, 0, 0, 0, 0, 0, {0, 0, 0}};
+    MB_JSON_printbuffer p = {0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0}};
 
     if (prebuffer < 0)
     {
@@ -1389,7 +2004,7 @@ MB_JSON_PrintBuffered(const MB_JSON *item, int prebuffer, MB_JSON_bool fmt)
 MB_JSON_PUBLIC(MB_JSON_bool)
 MB_JSON_PrintPreallocated(MB_JSON *item, char *buffer, const int length, const MB_JSON_bool format)
 {
-    MB_JSON_printbuffer p = {0, 0, 0, 0, 0, 0, {0, 0, 0}};
+    MB_JSON_printbuffer p = {0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0}};
 
     if ((length < 0) || (buffer == NULL))
     {
@@ -2204,18 +2819,27 @@ MB_JSON_GetArrayItem(const MB_JSON *array, int index)
 static MB_JSON *MB_JSON_get_object_item(const MB_JSON *const object, const char *const name, const MB_JSON_bool case_sensitive)
 {
     MB_JSON *current_element = NULL;
+    size_t walked = 0;
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
+#if MB_JSON_INDEX_THRESHOLD > 0
+    if (object->index != NULL)
+    {
+        return MB_JSON_index_find(object->index, name, case_sensitive);
+    }
+#endif
+
     current_element = object->child;
     if (case_sensitive)
     {
         while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
         {
             current_element = current_element->next;
+            walked++;
         }
     }
     else
@@ -2223,9 +2847,20 @@ static MB_JSON *MB_JSON_get_object_item(const MB_JSON *const object, const char
         while ((current_element != NULL) && (MB_JSON_case_insensitive_strcmp((const unsigned char *)name, (const unsigned char *)(current_element->string)) != 0))
         {
             current_element = current_element->next;
+            walked++;
         }
     }
 
+#if MB_JSON_INDEX_THRESHOLD > 0
+    /* the lookup was expensive, index the members for the next lookups */
+    if ((walked >= MB_JSON_INDEX_THRESHOLD) && ((object->type & 0xFF) == MB_JSON_Object) && !(object->type & MB_JSON_IsReference))
+    {
+        MB_JSON_index_build((MB_JSON *)object);
+    }
+#else
+    (void)walked;
+#endif
+
     if ((current_element == NULL) || (current_element->string == NULL))
     {
         return NULL;
@@ -2276,6 +2911,7 @@ static MB_JSON *MB_JSON_create_reference(const MB_JSON *item, const MB_JSON_inte
 
     memcpy(reference, item, sizeof(MB_JSON));
     reference->string = NULL;
+    reference->index = NULL;
     reference->type |= MB_JSON_IsReference;
     reference->next = reference->prev = NULL;
     return reference;
@@ -2290,6 +2926,8 @@ static MB_JSON_bool MB_JSON_add_item_to_array(MB_JSON *array, MB_JSON *item)
         return false;
     }
 
+    MB_JSON_index_drop(array);
+
     child = array->child;
     /*
      * To find the last item in array quickly, we use prev in array
@@ -2533,6 +3171,8 @@ MB_JSON_DetachItemViaPointer(MB_JSON *parent, MB_JSON *const item)
         return NULL;
     }
 
+    MB_JSON_index_drop(parent);
+
     if (item != parent->child)
     {
         /* not the first element */
@@ -2624,6 +3264,8 @@ MB_JSON_InsertItemInArray(MB_JSON *array, int which, MB_JSON *newitem)
         return MB_JSON_add_item_to_array(array, newitem);
     }
 
+    MB_JSON_index_drop(array);
+
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2651,6 +3293,8 @@ MB_JSON_ReplaceItemViaPointer(MB_JSON *const parent, MB_JSON *const item, MB_JSO
         return true;
     }
 
+    MB_JSON_index_drop(parent);
+
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -106,6 +106,8 @@ then using the MB_JSON_API_VISIBILITY flag to "export" the same symbols the way
 
 #define MB_JSON_IsReference 256
 #define MB_JSON_StringIsConst 512
+/* The number was parsed from the token that has the fraction or exponent part */
+#define MB_JSON_NumberIsDecimal 1024
 
 /* The MB_JSON structure: */
 typedef struct MB_JSON
@@ -128,6 +130,9 @@ typedef struct MB_JSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+    /* The lazy hash index of the object members (internal use), see MB_JSON_INDEX_THRESHOLD. */
+    struct MB_JSON_index *index;
 } MB_JSON;
 
 typedef struct MB_JSON_Hooks
@@ -138,6 +143,14 @@ typedef struct MB_JSON_Hooks
       void *(MB_JSON_CDECL *realloc_fn)(void *ptr, size_t sz);
 } MB_JSON_Hooks;
 
+/* The allocator with context for the nodes and strings of the parsed document e.g. the memory pool.
+ * The memory is freed with the free_fn of MB_JSON_Hooks which should recognize the allocator's memory. */
+typedef struct MB_JSON_Allocator
+{
+      void *(MB_JSON_CDECL *allocate_fn)(void *context, size_t sz);
+      void *context;
+} MB_JSON_Allocator;
+
 typedef int MB_JSON_bool;
 
 /* Limits how deeply nested arrays/objects can be before MB_JSON rejects to parse them.
@@ -146,6 +159,12 @@ typedef int MB_JSON_bool;
 #define MB_JSON_NESTING_LIMIT 1000
 #endif
 
+/* The object which its member lookup walked through this number of members will be hash indexed
+ * for the next lookups. The index is dropped when the object members changed. Set to 0 to disable. */
+#ifndef MB_JSON_INDEX_THRESHOLD
+#define MB_JSON_INDEX_THRESHOLD 32
+#endif
+
 /* returns the version of MB_JSON as a string */
 MB_JSON_PUBLIC(const char*) MB_JSON_Version(void);
 
@@ -163,6 +182,8 @@ MB_JSON_PUBLIC(MB_JSON *) MB_JSON_ParseWithLength(const char *value, size_t buff
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match MB_JSON_GetErrorPtr(). */
 MB_JSON_PUBLIC(MB_JSON *) MB_JSON_ParseWithOpts(const char *value, const char **return_parse_end, MB_JSON_bool require_null_terminated);
 MB_JSON_PUBLIC(MB_JSON *) MB_JSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, MB_JSON_bool require_null_terminated);
+/* Same as MB_JSON_ParseWithOpts but the nodes and strings are allocated by the allocator instead of MB_JSON_Hooks. */
+MB_JSON_PUBLIC(MB_JSON *) MB_JSON_ParseWithAllocator(const char *value, const char **return_parse_end, MB_JSON_bool require_null_terminated, const MB_JSON_Allocator *allocator);
 
 /* Render a MB_JSON entity to text for transfer/storage. */
 MB_JSON_PUBLIC(char *) MB_JSON_Print(const MB_JSON *item);
@@ -175,6 +196,8 @@ MB_JSON_PUBLIC(char *) MB_JSON_PrintBuffered(const MB_JSON *item, int prebuffer,
 MB_JSON_PUBLIC(MB_JSON_bool) MB_JSON_PrintPreallocated(MB_JSON *item, char *buffer, const int length, const MB_JSON_bool format);
 /* Delete a MB_JSON entity and all subentities. */
 MB_JSON_PUBLIC(void) MB_JSON_Delete(MB_JSON *item);
+/* Delete only the member indexes of the MB_JSON entity and all subentities, for the nodes that are released at once e.g. by the memory pool. */
+MB_JSON_PUBLIC(void) MB_JSON_DeleteIndexes(MB_JSON *item);
 
 /* Returns the number of items in an array (or object). */
 MB_JSON_PUBLIC(int) MB_JSON_GetArraySize(const MB_JSON *array);
@@ -191,6 +214,9 @@ MB_JSON_PUBLIC(const char *) MB_JSON_GetErrorPtr(void);
 MB_JSON_PUBLIC(char *) MB_JSON_GetStringValue(const MB_JSON * const item);
 MB_JSON_PUBLIC(double) MB_JSON_GetNumberValue(const MB_JSON * const item);
 
+/* strtod() replacement, exact fast path for short decimal numbers with '.' as the decimal point, strtod() otherwise */
+MB_JSON_PUBLIC(double) MB_JSON_StrToDouble(const char *string, char **end);
+
 /* These functions check the type of an item */
 MB_JSON_PUBLIC(MB_JSON_bool) MB_JSON_IsInvalid(const MB_JSON * const item);
 MB_JSON_PUBLIC(MB_JSON_bool) MB_JSON_IsFalse(const MB_JSON * const item);
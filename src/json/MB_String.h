@@ -1522,6 +1522,12 @@ private:
 
         char *t = (char *)newP(width);
 
+        if (t && type < 2 && toFixedStr(t, (double)value, precision))
+        {
+            trim(t);
+            return t;
+        }
+
         if (t)
         {
             MB_String fmt = MBSTRING_FLASH_MCR("%.");
@@ -1544,6 +1550,63 @@ private:
         return t;
     }
 
+    // Same output as sprintf "%.<precision>f" using integer arithmetic, returns false (leaving the
+    // formatting to sprintf) for large magnitudes, NaN, Inf and values too close to a rounding tie.
+    bool toFixedStr(char *t, double value, int precision)
+    {
+        static const double scales[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+        if (precision < 0 || precision > 9)
+            return false;
+
+        bool neg = value < 0 || (value == 0 && 1 / value < 0);
+        double scaled = (neg ? -value : value) * scales[precision];
+
+        if (!(scaled < 1e12))
+            return false;
+
+        unsigned long long r = (unsigned long long)scaled;
+        double frac = scaled - (double)r;
+
+        if (frac > 0.499 && frac < 0.501)
+            return false;
+
+        if (frac > 0.5)
+            r++;
+
+        unsigned long long div = (unsigned long long)scales[precision];
+        unsigned long long ip = r / div, fp = r % div;
+        char buf[16];
+        int n = 0;
+        size_t pos = 0;
+
+        do
+        {
+            buf[n++] = '0' + ip % 10;
+            ip /= 10;
+        } while (ip);
+
+        if (neg)
+            t[pos++] = '-';
+
+        while (n)
+            t[pos++] = buf[--n];
+
+        if (precision > 0)
+        {
+            t[pos++] = '.';
+            for (int i = precision - 1; i >= 0; i--)
+            {
+                t[pos + i] = '0' + fp % 10;
+                fp /= 10;
+            }
+            pos += precision;
+        }
+
+        t[pos] = '\0';
+        return true;
+    }
+
     char *nullStr()
     {
         char *t = (char *)newP(6);
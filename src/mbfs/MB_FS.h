@@ -141,6 +141,20 @@ struct mbfs_sd_config_info_t
 };
 #endif
 
+struct mbfs_arena_info_t
+{
+    // The arena size in bytes.
+    size_t size = 0;
+    // The highest number of arena bytes that were in use.
+    size_t peak = 0;
+    // The number of allocations that were served from arena.
+    uint32_t allocations = 0;
+    // The number of allocations that were served from heap because the arena was full.
+    uint32_t fallbacks = 0;
+    // The number of times the arena was reset when its outermost scope was closed.
+    uint32_t resets = 0;
+};
+
 class MB_FS
 {
 
@@ -489,6 +503,31 @@ public:
         return size;
     }
 
+    // Get the last write time of opened file or 0 when it is not available.
+    time_t lastWrite(mbfs_file_type type)
+    {
+        time_t ts = 0;
+
+#if defined(MBFS_FLASH_FS) && (defined(ESP32) || defined(ESP8266) || defined(MB_ARDUINO_PICO))
+        if (type == mbfs_flash && mb_flashFs)
+            ts = mb_flashFs.getLastWrite();
+#endif
+#if defined(MBFS_SD_FS)
+        if (type == mbfs_sd && mb_sdFs)
+        {
+#if defined(MBFS_ESP32_SDFAT_ENABLED) || defined(MBFS_SDFAT_ENABLED)
+            // the FAT date and time
+            uint16_t fdate = 0, ftime = 0;
+            if (mb_sdFs.getModifyDateTime(&fdate, &ftime))
+                ts = ((time_t)fdate << 16) | ftime;
+#elif defined(ESP32) || defined(ESP8266) || defined(MB_ARDUINO_PICO)
+            ts = mb_sdFs.getLastWrite();
+#endif
+        }
+#endif
+        return ts;
+    }
+
     // Check if file is ready to read/write.
     int available(mbfs_file_type type)
     {
@@ -745,6 +784,32 @@ public:
 #endif
         }
 
+#endif
+        return false;
+    }
+
+    // Rename the file, the existing file of new name will be replaced.
+    bool rename(const MB_String &from, const MB_String &to, mbfs_file_type type)
+    {
+        if (!checkStorageReady(type) || !existed(from, type))
+            return false;
+
+#if defined(MBFS_FLASH_FS)
+        if (type == mbfs_flash)
+        {
+            // The file system that can't rename to the existing file (e.g. SPIFFS).
+            if (MBFS_FLASH_FS.rename(from.c_str(), to.c_str()))
+                return true;
+            return remove(to, type) && MBFS_FLASH_FS.rename(from.c_str(), to.c_str());
+        }
+#endif
+#if defined(MBFS_SD_FS)
+        if (type == mbfs_sd)
+        {
+            if (MBFS_SD_FS.rename(from.c_str(), to.c_str()))
+                return true;
+            return remove(to, type) && MBFS_SD_FS.rename(from.c_str(), to.c_str());
+        }
 #endif
         return false;
     }
@@ -803,7 +868,17 @@ public:
         void **p = (void **)ptr;
         if (*p)
         {
-            free(*p);
+            // The arena memory was released when the arena reset, only the latest allocation can be returned.
+            if (inArena(*p))
+            {
+                if (arena_depth > 0 && (uint8_t *)*p - sizeof(uint32_t) == arena_buf + arena_last)
+                {
+                    arena_top = arena_last;
+                    arena_last = *(uint32_t *)(arena_buf + arena_last);
+                }
+            }
+            else
+                free(*p);
             *p = 0;
         }
     }
@@ -813,6 +888,19 @@ public:
     {
         void *p;
         size_t newLen = getReservedLen(len);
+
+        if (arena_depth > 0 && arenaOwner())
+        {
+            p = arenaAlloc(newLen);
+            if (p)
+            {
+                if (clear)
+                    memset(p, 0, newLen);
+                return p;
+            }
+            arena_info.fallbacks++;
+        }
+
 #if defined(BOARD_HAS_PSRAM) && defined(MB_STRING_USE_PSRAM)
 
         if (ESP.getPsramSize() > 0)
@@ -845,6 +933,71 @@ public:
         return p;
     }
 
+    // Open the arena scope, the memory allocated by newP in this scope will be taken from the arena
+    // (size in bytes) and released at once when the outermost scope was closed by endArena.
+    // The allocation will be taken from heap when arena is full or called from other task (ESP32).
+    bool beginArena(size_t size)
+    {
+        if (arena_depth > 0)
+        {
+            if (!arenaOwner())
+                return false;
+            arena_depth++;
+            return true;
+        }
+
+        if (arena_buf && (size == 0 || arena_info.size != size))
+            freeArena();
+
+        if (size == 0)
+            return false;
+
+        if (!arena_buf)
+        {
+            arena_buf = (uint8_t *)malloc(size);
+            if (!arena_buf)
+                return false;
+            arena_info.size = size;
+        }
+
+#if defined(ESP32)
+        arena_task = xTaskGetCurrentTaskHandle();
+#endif
+        arena_top = 0;
+        arena_last = 0;
+        arena_depth = 1;
+        return true;
+    }
+
+    // Close the arena scope that opened by beginArena.
+    void endArena()
+    {
+        if (arena_depth == 0 || !arenaOwner())
+            return;
+
+        if (--arena_depth == 0)
+        {
+            arena_top = 0;
+            arena_last = 0;
+            arena_info.resets++;
+        }
+    }
+
+    // Free the arena memory.
+    void freeArena()
+    {
+        if (arena_depth > 0)
+            return;
+
+        if (arena_buf)
+            free(arena_buf);
+        arena_buf = nullptr;
+        arena_info.size = 0;
+    }
+
+    // Get the arena usage statistics.
+    mbfs_arena_info_t arenaInfo() { return arena_info; }
+
     size_t getReservedLen(size_t len)
     {
         int blen = len + 1;
@@ -935,6 +1088,44 @@ private:
     bool flash_rdy = false;
     uint16_t loopCount = 0;
 
+    // The arena memory, each allocation was prefixed with the offset of previous allocation.
+    uint8_t *arena_buf = nullptr;
+    size_t arena_top = 0;
+    uint32_t arena_last = 0;
+    uint8_t arena_depth = 0;
+    mbfs_arena_info_t arena_info;
+#if defined(ESP32)
+    TaskHandle_t arena_task = NULL;
+#endif
+
+    bool arenaOwner()
+    {
+#if defined(ESP32)
+        return arena_task == xTaskGetCurrentTaskHandle();
+#else
+        return true;
+#endif
+    }
+
+    bool inArena(void *p)
+    {
+        return arena_buf && (uint8_t *)p >= arena_buf && (uint8_t *)p < arena_buf + arena_info.size;
+    }
+
+    void *arenaAlloc(size_t len)
+    {
+        if (!arena_buf || arena_top + sizeof(uint32_t) + len > arena_info.size)
+            return nullptr;
+
+        *(uint32_t *)(arena_buf + arena_top) = arena_last;
+        arena_last = arena_top;
+        arena_top += sizeof(uint32_t) + len;
+        arena_info.allocations++;
+        if (arena_top > arena_info.peak)
+            arena_info.peak = arena_top;
+        return arena_buf + arena_last + sizeof(uint32_t);
+    }
+
 #if defined(MBFS_FLASH_FS)
     fs::File mb_flashFs;
 #endif
@@ -159,8 +159,9 @@ void FB_CM::fcm_connect(FirebaseData *fbdo, firebase_fcm_msg_mode mode)
                              ? firebase_fcm_pgm_str_1 /* "fcm" */
                              : firebase_fcm_pgm_str_2 /* "iid" */);
 
+    fbdo->tcpClient.setBufferProfile(firebase_bssl_buffer_profile_request, &Core.mflnCache);
     rescon(fbdo, host.c_str());
-    fbdo->tcpClient.setSession(&fbdo->bsslSession);
+    fbdo->tcpClient.setSession(&fbdo->bsslSession, &Core.tlsSessionCache);
     fbdo->tcpClient.begin(host.c_str(), port, &fbdo->session.response.code);
     fbdo->session.max_payload_length = 0;
 }
@@ -935,12 +936,20 @@ void FB_CM::rescon(FirebaseData *fbdo, const char *host)
 {
     fbdo->_responseCallback = NULL;
 
+    // The connection buffers do not fit the workload of this request (adaptive buffer sizing).
+    bool resize = fbdo->tcpClient.isBufferResizeRequired();
+
     if (fbdo->session.cert_updated || millis() - fbdo->session.last_conn_ms > fbdo->session.conn_timeout ||
-        fbdo->session.con_mode != firebase_con_mode_fcm ||
+        fbdo->session.con_mode != firebase_con_mode_fcm || resize ||
         strcmp(host, fbdo->session.host.c_str()) != 0)
     {
+        // The connection that is not expired can be returned to the shared pool instead of closing
+        if (!resize && !fbdo->session.cert_updated && millis() - fbdo->session.last_conn_ms <= fbdo->session.conn_timeout)
+            fbdo->releaseConnection();
+
         fbdo->session.last_conn_ms = millis();
         fbdo->closeSession();
+        fbdo->acquireConnection(host, port);
         fbdo->setSecure();
     }
 
@@ -329,6 +329,23 @@ bool FB_RTDB::mGetShallowData(FirebaseData *fbdo, MB_StringPtr path)
     return handleRequest(fbdo, &req);
 }
 
+bool FB_RTDB::mGetJSON(FirebaseData *fbdo, MB_StringPtr path, FirebaseJsonReader *reader)
+{
+    if (!reader)
+        return false;
+
+    reader->reset();
+
+    // The response payload will be fed to the reader in handleResponse instead of buffering.
+    // The failed request is not added to error queue, the reader is not kept by the queue.
+    fbdo->session.rtdb.json_reader = reader;
+    bool ret = buildRequest(fbdo, http_get, path, toStringPtr(_NO_PAYLOAD),
+                            d_json, _NO_SUB_TYPE, _NO_REF, _NO_QUERY, _NO_PRIORITY, toStringPtr(_NO_ETAG),
+                            _NO_ASYNC, _IS_QUEUE, _NO_BLOB_SIZE, toStringPtr(_NO_FILE));
+    fbdo->session.rtdb.json_reader = nullptr;
+    return ret;
+}
+
 void FB_RTDB::enableClassicRequest(FirebaseData *fbdo, bool enable)
 {
     fbdo->session.classic_request = enable;
@@ -347,6 +364,24 @@ bool FB_RTDB::buildRequest(FirebaseData *fbdo, firebase_request_method method, M
         return false;
 #endif
 
+    if (fbdo->session.rtdb.batch.active && !fbdo->session.rtdb.batch.committing && Core.config)
+    {
+        struct firebase_rtdb_batch_t &batch = fbdo->session.rtdb.batch;
+
+        // The writes of failed commit are kept, the new write can't be kept when batch is full
+        // and still can't be committed.
+        if (batch.failed && isBatchFull(fbdo, false) && !flushBatch(fbdo))
+            return false;
+
+        // The write is kept in batch, the failed commit is retried and reported to this write.
+        if (addBatch(fbdo, method, path, payload, type, value_addr, priority_addr, etag, queue))
+            return batch.failed || isBatchFull(fbdo, true) ? flushBatch(fbdo) : true;
+
+        // The pending writes should be committed before other request
+        if (!flushBatch(fbdo))
+            return false;
+    }
+
     struct firebase_rtdb_request_info_t req;
 
     MB_String _path, tpath, pre, post;
@@ -782,6 +817,74 @@ void FB_RTDB::setMultiPathStreamCallback(FirebaseData *fbdo, FirebaseData::Multi
 #endif
 }
 
+bool FB_RTDB::mAddMultiPathStreamChild(FirebaseData *fbdo, MB_StringPtr childPath,
+                                       FirebaseData::MultiPathStreamEventCallback childCallback)
+{
+    if (!childCallback)
+        return false;
+
+    MB_VECTOR<struct firebase_mp_stream_path_node_t> &nodes = fbdo->session.rtdb.mp_stream_paths;
+
+    // node 0 is the parent path
+    if (nodes.size() == 0)
+        nodes.push_back(firebase_mp_stream_path_node_t());
+
+    MB_String path = childPath, nodePath;
+    const char *p = path.c_str();
+    int node = 0;
+
+    while (*p)
+    {
+        while (*p == '/')
+            p++;
+
+        const char *e = p;
+        while (*e && *e != '/')
+            e++;
+
+        if (e == p)
+            break;
+
+        nodePath += '/';
+        nodePath.append(p, e - p);
+
+        int child = findMultiPathNode(fbdo, node, p, e - p);
+
+        if (child < 0)
+        {
+            struct firebase_mp_stream_path_node_t n;
+            n.key.append(p, e - p);
+            n.next_sibling = nodes[node].first_child;
+            child = nodes.size();
+            nodes[node].first_child = child;
+            nodes.push_back(n);
+        }
+
+        node = child;
+        p = e;
+    }
+
+    if (node == 0)
+        return false;
+
+    if (nodes[node].callback_index < 0)
+    {
+        nodes[node].callback_index = fbdo->_multiPathChildCallbacks.size();
+        nodes[node].path = nodePath;
+        fbdo->_multiPathChildCallbacks.push_back(childCallback);
+    }
+    else
+        fbdo->_multiPathChildCallbacks[nodes[node].callback_index] = childCallback;
+
+    return true;
+}
+
+void FB_RTDB::removeMultiPathStreamChildren(FirebaseData *fbdo)
+{
+    MB_VECTOR<FirebaseData::MultiPathStreamEventCallback>().swap(fbdo->_multiPathChildCallbacks);
+    MB_VECTOR<struct firebase_mp_stream_path_node_t>().swap(fbdo->session.rtdb.mp_stream_paths);
+}
+
 void FB_RTDB::removeMultiPathStreamCallback(FirebaseData *fbdo)
 {
     if (!Core.config)
@@ -792,6 +895,7 @@ void FB_RTDB::removeMultiPathStreamCallback(FirebaseData *fbdo)
 
     fbdo->_multiPathDataCallback = NULL;
     fbdo->_timeoutCallback = NULL;
+    removeMultiPathStreamChildren(fbdo);
     fbdo->setSession(true, false);
 
 #if defined(ESP32)
@@ -869,7 +973,8 @@ void FB_RTDB::mRunStream()
 
         if (fbdo)
         {
-            if ((fbdo->_dataAvailableCallback || fbdo->_multiPathDataCallback || fbdo->_timeoutCallback))
+            if ((fbdo->_dataAvailableCallback || fbdo->_multiPathDataCallback ||
+                 fbdo->_multiPathChildCallbacks.size() > 0 || fbdo->_timeoutCallback))
             {
                 if (Core.isExpired())
                 {
@@ -892,6 +997,262 @@ void FB_RTDB::setMaxRetry(FirebaseData *fbdo, uint8_t num)
     fbdo->session.rtdb.max_retry = num;
 }
 
+void FB_RTDB::setAsyncCallback(FirebaseData *fbdo, RTDB_AsyncResultCallback callback)
+{
+    fbdo->session.rtdb.async_cb = callback;
+}
+
+bool FB_RTDB::readAsyncResponses(FirebaseData *fbdo, bool wait)
+{
+    if (!Core.config)
+        return false;
+
+    bool ret = readPipelinedResponses(fbdo, wait);
+    deliverAsyncResults(fbdo);
+    return ret;
+}
+
+size_t FB_RTDB::asyncPendingCount(FirebaseData *fbdo)
+{
+    return fbdo->session.rtdb.async_pending.size();
+}
+
+bool FB_RTDB::mBeginBatch(FirebaseData *fbdo, MB_StringPtr path)
+{
+    struct firebase_rtdb_batch_t &batch = fbdo->session.rtdb.batch;
+
+    // commit the pending writes of previous batch,
+    // the failed writes are relative to the previous path and keep it.
+    if (!flushBatch(fbdo))
+        return false;
+
+    batch.path = path;
+    Core.ut.makePath(batch.path);
+    if (batch.path.length() == 0)
+        batch.path = firebase_pgm_str_1; // "/"
+    else if (batch.path.length() > 1 && batch.path[batch.path.length() - 1] == '/')
+        batch.path.pop_back();
+
+    batch.active = true;
+
+    return true;
+}
+
+bool FB_RTDB::commitBatch(FirebaseData *fbdo)
+{
+    bool ret = flushBatch(fbdo);
+    fbdo->session.rtdb.batch.active = false;
+    return ret;
+}
+
+RTDB_BatchInfo FB_RTDB::batchInfo(FirebaseData *fbdo)
+{
+    struct firebase_rtdb_batch_t &batch = fbdo->session.rtdb.batch;
+    RTDB_BatchInfo info = batch.info;
+    info.pending = batch.items.size();
+    // the writes that were sent or replaced need only one request per commit
+    uint32_t sent = info.writes - info.pending;
+    info.saved = sent > info.commits ? sent - info.commits : 0;
+    return info;
+}
+
+bool FB_RTDB::addBatch(FirebaseData *fbdo, firebase_request_method method, MB_StringPtr path, MB_StringPtr payload,
+                       firebase_data_type type, uint32_t value_addr, uint32_t priority_addr, MB_StringPtr etag, bool queue)
+{
+    struct firebase_rtdb_batch_t &batch = fbdo->session.rtdb.batch;
+
+    // Only the plain set of child node can be kept in batch
+    if ((method != http_put && method != rtdb_set_nocontent) || priority_addr > 0 || queue)
+        return false;
+
+    MB_String tag = etag;
+    if (tag.length() > 0)
+        return false;
+
+    MB_String key = path;
+    makeNodePath(key);
+
+    // The relative path of child node
+    size_t ofs = batch.path.length() == 1 ? 1 : batch.path.length() + 1;
+    if (key.length() <= ofs || (batch.path.length() > 1 && (strncmp(key.c_str(), batch.path.c_str(), batch.path.length()) != 0 ||
+                                                           key[batch.path.length()] != '/')))
+        return false;
+
+    key.erase(0, ofs);
+
+    struct firebase_rtdb_batch_item_t item;
+    item.path = key;
+
+    if (!makeBatchValue(type, value_addr, payload, item.value))
+        return false;
+
+    for (size_t i = 0; i < batch.items.size(); i++)
+    {
+        MB_String &cur = batch.items[i].path;
+        size_t len = cur.length() < key.length() ? cur.length() : key.length();
+        if (strncmp(cur.c_str(), key.c_str(), len) != 0)
+            continue;
+
+        // The pending write at ancestor path, it can't be merged and should be sent first.
+        if (cur.length() < key.length() && key[len] == '/')
+        {
+            if (!flushBatch(fbdo))
+                return false;
+            break;
+        }
+        // The pending write at the same or child path is replaced
+        else if (cur.length() == key.length() || cur[len] == '/')
+        {
+            batch.payload_size -= cur.length() + batch.items[i].value.length() + 4;
+            batch.items.erase(batch.items.begin() + i);
+            batch.info.deduplicated++;
+            i--;
+        }
+    }
+
+    if (batch.items.size() == 0)
+        batch.begin_ms = millis();
+
+    batch.payload_size += item.path.length() + item.value.length() + 4;
+    batch.items.push_back(item);
+    batch.info.writes++;
+
+    return true;
+}
+
+bool FB_RTDB::isBatchFull(FirebaseData *fbdo, bool checkDelay)
+{
+    struct firebase_rtdb_batch_t &batch = fbdo->session.rtdb.batch;
+    struct firebase_rtdb_batch_config_t &cfg = Core.config->rtdb.batch;
+
+    return (cfg.max_writes > 0 && batch.items.size() >= cfg.max_writes) ||
+           (cfg.max_payload_size > 0 && batch.payload_size >= cfg.max_payload_size) ||
+           (checkDelay && cfg.max_delay_ms > 0 && millis() - batch.begin_ms >= cfg.max_delay_ms);
+}
+
+bool FB_RTDB::flushBatch(FirebaseData *fbdo)
+{
+    struct firebase_rtdb_batch_t &batch = fbdo->session.rtdb.batch;
+
+    if (batch.items.size() == 0 || batch.committing)
+        return true;
+
+    // The multi-path update payload e.g. {"child/a":1,"child/b":"x"}
+    MB_String payload;
+    payload.reserve(batch.payload_size + 2);
+    makeBatchPayload(batch.items, 0, payload);
+
+    // The failed writes are kept in batch instead of error queue.
+    batch.committing = true;
+    bool ret = buildRequest(fbdo, rtdb_update_nocontent, toStringPtr(batch.path), toStringPtr(payload), d_json,
+                            _NO_SUB_TYPE, _NO_REF, _NO_QUERY, _NO_PRIORITY, toStringPtr(_NO_ETAG), _NO_ASYNC,
+                            _IS_QUEUE, _NO_BLOB_SIZE, toStringPtr(_NO_FILE));
+    batch.committing = false;
+
+    batch.info.commits++;
+    batch.failed = !ret;
+    if (ret)
+    {
+        batch.items.clear();
+        batch.payload_size = 0;
+    }
+    else
+    {
+        batch.info.failures++;
+        // retry by Firebase.ready() after the max delay
+        batch.begin_ms = millis();
+    }
+
+    return ret;
+}
+
+void FB_RTDB::flushDueBatches()
+{
+    if (!Core.config || Core.config->rtdb.batch.max_delay_ms == 0)
+        return;
+
+    // the batch is committed when its max delay was reached without next write
+    for (size_t id = 0; id < Core.internal.sessions.size(); id++)
+    {
+        FirebaseData *fbdo = addrTo<FirebaseData *>(Core.internal.sessions[id].ptr);
+        if (fbdo && fbdo->session.rtdb.batch.items.size() > 0 &&
+            millis() - fbdo->session.rtdb.batch.begin_ms >= Core.config->rtdb.batch.max_delay_ms)
+            flushBatch(fbdo);
+    }
+}
+
+void FB_RTDB::readDueAsyncResponses()
+{
+    if (!Core.config || Core.config->rtdb.async_pipeline_depth == 0)
+        return;
+
+    // the available responses are read without waiting and their results are passed to the callback
+    for (size_t id = 0; id < Core.internal.sessions.size(); id++)
+    {
+        FirebaseData *fbdo = addrTo<FirebaseData *>(Core.internal.sessions[id].ptr);
+        if (!fbdo)
+            continue;
+
+        if (fbdo->session.rtdb.async_pending.size() > 0)
+            readPipelinedResponses(fbdo, false);
+
+        deliverAsyncResults(fbdo);
+    }
+}
+
+void FB_RTDB::makeNodePath(MB_String &path)
+{
+    Core.ut.makePath(path);
+    while (path.length() > 1 && path[path.length() - 1] == '/')
+        path.pop_back();
+    if (path.length() == 0)
+        path = firebase_pgm_str_1; // "/"
+}
+
+bool FB_RTDB::makeBatchValue(firebase_data_type type, uint32_t value_addr, MB_StringPtr payload, MB_String &value)
+{
+    if (type == d_json || type == d_array)
+    {
+        if (value_addr == 0)
+            return false;
+
+        if (type == d_json)
+            value = addrTo<FirebaseJson *>(value_addr)->raw();
+        else
+            value = addrTo<FirebaseJsonArray *>(value_addr)->raw();
+    }
+    else if (type == d_integer || type == d_float || type == d_double || type == d_boolean || type == d_string)
+    {
+        value.clear();
+        if (type == d_string)
+            value = firebase_pgm_str_4; // "\""
+        value += payload;
+        if (type == d_string)
+            value += firebase_pgm_str_4; // "\""
+    }
+    else
+        return false;
+
+    return true;
+}
+
+void FB_RTDB::makeBatchPayload(MB_VECTOR<struct firebase_rtdb_batch_item_t> &items, size_t ofs, MB_String &payload)
+{
+    // The multi-path update payload e.g. {"child/a":1,"child/b":"x"}, ofs is the length of parent path to skip.
+    payload += firebase_pgm_str_10; // "{"
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        if (i > 0)
+            payload += firebase_pgm_str_3; // ","
+        payload += firebase_pgm_str_4;     // "\""
+        payload += items[i].path.c_str() + ofs;
+        payload += firebase_pgm_str_4; // "\""
+        payload += firebase_pgm_str_2; // ":"
+        payload += items[i].value;
+    }
+    payload += firebase_pgm_str_11; // "}"
+}
+
 void FB_RTDB::setBlobRef(FirebaseData *fbdo, int addr)
 {
     if (fbdo->session.rtdb.blob && fbdo->session.rtdb.isBlobPtr)
@@ -908,6 +1269,10 @@ void FB_RTDB::setBlobRef(FirebaseData *fbdo, int addr)
 
 void FB_RTDB::addQueueData(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req)
 {
+    // The failed request of the queue being processed is still kept in the queue.
+    if (fbdo->_qMan._draining)
+        return;
+
     if (req->method == http_get || (!req->queue && (req->method == http_put ||
                                                     req->method == rtdb_set_nocontent ||
                                                     req->method == http_post ||
@@ -965,64 +1330,293 @@ void FB_RTDB::processErrorQueue(FirebaseData *fbdo, FirebaseData::QueueInfoCallb
     if (!fbdo->reconnect())
         return;
 
-    if (fbdo->_qMan.size() > 0)
+    uint32_t id = fbdo->_qMan.first();
+    if (id == 0)
+        return;
+
+    RTDB_QueueDrainInfo &info = fbdo->_qMan._drainInfo;
+    unsigned long ms = millis();
+    bool batch = Core.config && fbdo->_qMan._drainMode == firebase_queue_drain_mode_batch;
+
+    // The sessions that the write requests are sent on in turn, one request at a time.
+    MB_VECTOR<FirebaseData *> sessions;
+    size_t w = 0;
+    sessions.push_back(fbdo);
+    for (size_t i = 0; i < fbdo->_queueConnections.size(); i++)
     {
+        if (fbdo->_queueConnections[i]->reconnect())
+            sessions.push_back(fbdo->_queueConnections[i]);
+    }
+
+    // The paths of failed queues, the later queues of the same or child paths are held to keep the order.
+    MB_VECTOR<MB_String> failed;
+    MB_VECTOR<uint32_t> ids;
+    MB_VECTOR<struct firebase_rtdb_batch_item_t> items;
+    MB_String path;
 
-        for (uint8_t i = 0; i < fbdo->_qMan.size(); i++)
+    // Items are processed in place from the highest priority class, the failed items stay in the queue.
+    fbdo->_qMan.beginDrain();
+
+    while (id > 0)
+    {
+        QueueItem *item = fbdo->_qMan.get(id);
+
+        if (callback)
         {
-            if (!fbdo->_qMan._queueCollection)
-                return;
+            QueueInfo qinfo;
+            qinfo._isQueue = true;
+            qinfo._dataType = fbdo->getDataType(item->dataType);
+            qinfo._path = item->path;
+            qinfo._currentQueueID = item->qID;
+            qinfo._method = fbdo->getMethod(item->method);
+            qinfo._totalQueue = fbdo->_qMan.size();
+            qinfo._isQueueFull = fbdo->_qMan.size() == fbdo->_qMan._maxQueue;
+            callback(qinfo);
+
+            // The callback may change the queue.
+            item = fbdo->_qMan.get(id);
+            if (!item)
+                break;
+        }
+
+        uint32_t nextID = fbdo->_qMan.next(id);
+
+        path = item->path;
+        makeNodePath(path);
+
+        bool held = false;
+        for (size_t i = 0; i < failed.size() && !held; i++)
+            held = isQueuePathOverlapped(failed[i], path);
+
+        if (held)
+        {
+            info.deferred++;
+            id = nextID;
+            continue;
+        }
+
+        ids.clear();
+        items.clear();
+        ids.push_back(id);
 
-            QueueItem item = fbdo->_qMan._queueCollection->at(i);
+        // Merge the consecutive set and update queues of the non-overlapped paths.
+        if (batch && addQueueDrainItem(item, items))
+        {
+            struct firebase_rtdb_batch_config_t &cfg = Core.config->rtdb.batch;
+            size_t size = 0;
+            for (size_t i = 0; i < items.size(); i++)
+                size += items[i].path.length() + items[i].value.length() + 4;
 
-            if (item.qID == 0)
+            while (nextID > 0 && (cfg.max_writes == 0 || ids.size() < cfg.max_writes) &&
+                   (cfg.max_payload_size == 0 || size < cfg.max_payload_size))
             {
-                fbdo->clearQueueItem(&item);
-                fbdo->_qMan.remove(i);
-                continue;
+                QueueItem *q = fbdo->_qMan.get(nextID);
+
+                path = q->path;
+                makeNodePath(path);
+                for (size_t i = 0; i < failed.size() && !held; i++)
+                    held = isQueuePathOverlapped(failed[i], path);
+
+                size_t n = items.size();
+                if (held || !addQueueDrainItem(q, items))
+                    break;
+
+                // The write to the parent or child path of the pending writes should be sent later.
+                bool conflict = false;
+                for (size_t i = n; i < items.size() && !conflict; i++)
+                {
+                    for (size_t j = 0; j < n && !conflict; j++)
+                        conflict = isQueuePathOverlapped(items[j].path, items[i].path) && items[j].path != items[i].path;
+                }
+
+                if (conflict)
+                {
+                    items.erase(items.begin() + n, items.end());
+                    break;
+                }
+
+                // The pending writes of the same paths are replaced.
+                for (size_t j = n; j-- > 0;)
+                {
+                    for (size_t i = n; i < items.size(); i++)
+                    {
+                        if (items[j].path == items[i].path)
+                        {
+                            size -= items[j].path.length() + items[j].value.length() + 4;
+                            items.erase(items.begin() + j);
+                            n--;
+                            break;
+                        }
+                    }
+                }
+
+                for (size_t i = n; i < items.size(); i++)
+                    size += items[i].path.length() + items[i].value.length() + 4;
+
+                ids.push_back(nextID);
+                nextID = fbdo->_qMan.next(nextID);
             }
+        }
+
+        // The read requests are always sent by the session that holds the queues.
+        FirebaseData *session = item->method == http_get ? fbdo : sessions[w++ % sessions.size()];
+
+        FBUtils::idle();
+        bool ret = ids.size() > 1 ? sendQueueDrainBatch(session, items) : sendQueueItem(session, item);
+        info.requests++;
+
+        if (ret)
+        {
+            for (size_t i = 0; i < ids.size(); i++)
+                fbdo->_qMan.removeById(ids[i]);
+            info.items += ids.size();
+        }
+        else
+        {
+            info.failures++;
 
-            if (callback)
+            if (ids.size() > 1)
             {
-                QueueInfo qinfo;
-                qinfo._isQueue = true;
-                qinfo._dataType = fbdo->getDataType(item.dataType);
-                qinfo._path = item.path;
-                qinfo._currentQueueID = item.qID;
-                qinfo._method = fbdo->getMethod(item.method);
-                qinfo._totalQueue = fbdo->_qMan.size();
-                qinfo._isQueueFull = fbdo->_qMan.size() == fbdo->_qMan._maxQueue;
-                callback(qinfo);
+                for (size_t i = 0; i < items.size(); i++)
+                    failed.push_back(items[i].path);
+            }
+            else
+            {
+                path = item->path;
+                makeNodePath(path);
+                failed.push_back(path);
             }
 
-            FBUtils::idle();
-            if (buildRequest(fbdo, item.method, MB_StringPtr(toAddr(item.path), mb_string_sub_type_mb_string),
-                             MB_StringPtr(toAddr(item.payload), mb_string_sub_type_mb_string), item.dataType,
-                             item.subType, item.method == http_get ? item.address.dout : item.address.din, item.address.query,
-                             item.address.priority, MB_StringPtr(toAddr(item.etag), mb_string_sub_type_mb_string),
-                             item.async, _NO_QUEUE, item.blobSize,
-                             MB_StringPtr(toAddr(item.filename), mb_string_sub_type_mb_string),
-                             (firebase_mem_storage_type)item.storageType))
+            // The failed connection is not used until the next processing.
+            for (size_t i = 1; i < sessions.size(); i++)
             {
-                fbdo->clearQueueItem(&item);
-                fbdo->_qMan.remove(i);
+                if (sessions[i] == session)
+                {
+                    sessions.erase(sessions.begin() + i);
+                    break;
+                }
             }
         }
+
+        if (nextID > 0 && !fbdo->_qMan.get(nextID))
+            break;
+
+        id = nextID;
     }
+
+    fbdo->_qMan.endDrain();
+    info.elapsed_ms += millis() - ms;
 }
 
-bool FB_RTDB::isErrorQueueExisted(FirebaseData *fbdo, uint32_t errorQueueID)
+bool FB_RTDB::sendQueueItem(FirebaseData *fbdo, QueueItem *item)
+{
+    // The queue flag prevents the failed write from being added to the queue again.
+    return buildRequest(fbdo, item->method, MB_StringPtr(toAddr(item->path), mb_string_sub_type_mb_string),
+                        MB_StringPtr(toAddr(item->payload), mb_string_sub_type_mb_string), item->dataType,
+                        item->subType, item->method == http_get ? item->address.dout : item->address.din, item->address.query,
+                        item->address.priority, MB_StringPtr(toAddr(item->etag), mb_string_sub_type_mb_string),
+                        item->async, _IS_QUEUE, item->blobSize,
+                        MB_StringPtr(toAddr(item->filename), mb_string_sub_type_mb_string),
+                        (firebase_mem_storage_type)item->storageType);
+}
+
+bool FB_RTDB::addQueueDrainItem(QueueItem *item, MB_VECTOR<struct firebase_rtdb_batch_item_t> &items)
 {
-    for (uint8_t i = 0; i < fbdo->_qMan.size(); i++)
+    if (item->address.priority > 0 || item->etag.length() > 0)
+        return false;
+
+    struct firebase_rtdb_batch_item_t bItem;
+    bItem.path = item->path;
+    makeNodePath(bItem.path);
+
+    if (item->method == http_put || item->method == rtdb_set_nocontent)
     {
-        if (!fbdo->_qMan._queueCollection)
+        // The set of root node can't be a part of multi-path update.
+        if (bItem.path.length() < 2)
             return false;
 
-        QueueItem q = fbdo->_qMan._queueCollection->at(i);
-        if (q.qID == errorQueueID)
-            return true;
+        if (!makeBatchValue(item->dataType, item->address.din, MB_StringPtr(toAddr(item->payload), mb_string_sub_type_mb_string),
+                            bItem.value))
+            return false;
+
+        items.push_back(bItem);
+        return true;
     }
-    return false;
+
+    // The update of JSON is the multi-path update of its children e.g. {"a":1} at "/node" -> {"node/a":1}
+    if ((item->method != http_patch && item->method != rtdb_update_nocontent) ||
+        item->dataType != d_json || item->address.din == 0)
+        return false;
+
+    // The children are read from the parsed tree of the queued FirebaseJson object.
+    MB_JSON *root = addrTo<FirebaseJson *>(item->address.din)->root;
+    if (!root || !MB_JSON_IsObject(root))
+        return false;
+
+    size_t n = items.size();
+    for (MB_JSON *e = root->child; e; e = e->next)
+    {
+        struct firebase_rtdb_batch_item_t child;
+        child.path = bItem.path;
+        if (child.path.length() > 1)
+            child.path += firebase_pgm_str_1; // "/"
+        child.path += e->string[0] == '/' ? e->string + 1 : e->string;
+        makeNodePath(child.path);
+
+        char *p = MB_JSON_PrintUnformatted(e);
+        if (p)
+        {
+            child.value = p;
+            MB_JSON_free(p);
+        }
+
+        if (child.path.length() < 2 || child.value.length() == 0)
+        {
+            items.erase(items.begin() + n, items.end());
+            break;
+        }
+
+        items.push_back(child);
+    }
+
+    return items.size() > n;
+}
+
+bool FB_RTDB::sendQueueDrainBatch(FirebaseData *fbdo, MB_VECTOR<struct firebase_rtdb_batch_item_t> &items)
+{
+    // The common parent path of all writes.
+    MB_String base = items[0].path;
+    base.erase(base.rfind('/'));
+    for (size_t i = 1; i < items.size(); i++)
+    {
+        while (base.length() > 0 && (strncmp(items[i].path.c_str(), base.c_str(), base.length()) != 0 ||
+                                     items[i].path[base.length()] != '/'))
+            base.erase(base.rfind('/'));
+    }
+
+    MB_String payload;
+    makeBatchPayload(items, base.length() + 1, payload);
+
+    if (base.length() == 0)
+        base = firebase_pgm_str_1; // "/"
+
+    return buildRequest(fbdo, rtdb_update_nocontent, toStringPtr(base), toStringPtr(payload), d_json,
+                        _NO_SUB_TYPE, _NO_REF, _NO_QUERY, _NO_PRIORITY, toStringPtr(_NO_ETAG), _NO_ASYNC,
+                        _IS_QUEUE, _NO_BLOB_SIZE, toStringPtr(_NO_FILE));
+}
+
+bool FB_RTDB::isQueuePathOverlapped(const MB_String &a, const MB_String &b)
+{
+    // The same path or one is the parent of other.
+    size_t len = a.length() < b.length() ? a.length() : b.length();
+    if (len == 1 || strncmp(a.c_str(), b.c_str(), len) != 0)
+        return len == 1;
+    return a.length() == b.length() || (a.length() > len ? a[len] : b[len]) == '/';
+}
+
+bool FB_RTDB::isErrorQueueExisted(FirebaseData *fbdo, uint32_t errorQueueID)
+{
+    return fbdo->_qMan.get(errorQueueID) != nullptr;
 }
 
 #if defined(ESP32) || defined(ESP8266)
@@ -1113,33 +1707,75 @@ void FB_RTDB::endAutoRunErrorQueue(FirebaseData *fbdo)
 
 void FB_RTDB::clearErrorQueue(FirebaseData *fbdo)
 {
-    for (uint8_t i = 0; i < fbdo->_qMan.size(); i++)
+    fbdo->_qMan.clear();
+    resetErrorQueueDrainInfo(fbdo);
+}
+
+void FB_RTDB::setMaxErrorQueue(FirebaseData *fbdo, uint16_t num)
+{
+    fbdo->_qMan.setMax(num);
+}
+
+void FB_RTDB::setErrorQueuePriority(FirebaseData *fbdo, firebase_queue_priority priority)
+{
+    fbdo->_qMan._priority = priority < FIREBASE_QUEUE_PRIORITY_CLASSES ? priority : firebase_queue_priority_control;
+}
+
+void FB_RTDB::setErrorQueueDrainMode(FirebaseData *fbdo, firebase_queue_drain_mode mode)
+{
+    fbdo->_qMan._drainMode = mode;
+}
+
+void FB_RTDB::addErrorQueueConnection(FirebaseData *fbdo, FirebaseData *other)
+{
+    if (!other || other == fbdo)
+        return;
+
+    for (size_t i = 0; i < fbdo->_queueConnections.size(); i++)
     {
-        if (!fbdo->_qMan._queueCollection)
+        if (fbdo->_queueConnections[i] == other)
             return;
-
-        QueueItem item = fbdo->_qMan._queueCollection->at(i);
-        fbdo->clearQueueItem(&item);
     }
+
+    // Both sessions keep the link, the destructor of either session removes it.
+    fbdo->_queueConnections.push_back(other);
+    other->_queueConnectionOwners.push_back(fbdo);
 }
 
-void FB_RTDB::setMaxErrorQueue(FirebaseData *fbdo, uint8_t num)
+void FB_RTDB::removeErrorQueueConnection(FirebaseData *fbdo, FirebaseData *other)
 {
-    fbdo->_qMan._maxQueue = num;
-
-    if (fbdo->_qMan.size() > num)
+    for (size_t i = 0; i < fbdo->_queueConnections.size(); i++)
     {
-        for (uint8_t i = fbdo->_qMan.size() - 1; i >= num; i--)
+        if (fbdo->_queueConnections[i] == other)
         {
-            if (!fbdo->_qMan._queueCollection)
-                return;
+            fbdo->_queueConnections.erase(fbdo->_queueConnections.begin() + i);
+            break;
+        }
+    }
 
-            QueueItem item = fbdo->_qMan._queueCollection->at(i);
-            fbdo->clearQueueItem(&item);
+    for (size_t i = 0; other && i < other->_queueConnectionOwners.size(); i++)
+    {
+        if (other->_queueConnectionOwners[i] == fbdo)
+        {
+            other->_queueConnectionOwners.erase(other->_queueConnectionOwners.begin() + i);
+            break;
         }
     }
 }
 
+RTDB_QueueDrainInfo FB_RTDB::errorQueueDrainInfo(FirebaseData *fbdo)
+{
+    RTDB_QueueDrainInfo info = fbdo->_qMan._drainInfo;
+    info.pending = fbdo->_qMan.size();
+    info.items_per_sec = info.elapsed_ms > 0 ? (float)info.items * 1000 / info.elapsed_ms : 0;
+    return info;
+}
+
+void FB_RTDB::resetErrorQueueDrainInfo(FirebaseData *fbdo)
+{
+    fbdo->_qMan._drainInfo = RTDB_QueueDrainInfo();
+}
+
 bool FB_RTDB::mSaveErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType)
 {
 
@@ -1160,27 +1796,15 @@ bool FB_RTDB::mSaveErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, firebas
         !Core.mbfs.ready(mbfs_type storageType))
         return false;
 
-    FirebaseJsonArray arr;
-
-    // required for ESP32 core 2.0.x
-    Core.mbfs.open(_filename, mbfs_type storageType, mb_fs_open_mode_write);
+    // required for ESP32 core 2.0.x, the queue file is opened again for writing.
+    ret = QueueManager::saveFile(&Core.mbfs, _filename, mbfs_type storageType, &fbdo->_qMan);
 
-    for (uint8_t i = 0; i < fbdo->_qMan.size(); i++)
+    if (ret < 0)
     {
-        if (!fbdo->_qMan._queueCollection)
-            continue;
-
-        QueueItem item = fbdo->_qMan._queueCollection->at(i);
-        arr.clear();
-        arr.add((uint8_t)item.dataType, (uint8_t)item.subType, (uint8_t)item.method,
-                (uint8_t)item.storageType, (uint8_t)item.async);
-        arr.add(item.address.din, item.address.dout, item.address.query,
-                item.address.priority, item.blobSize);
-        arr.add(item.path, item.payload, item.etag, item.filename);
-        Core.mbfs.write(mbfs_type storageType, (uint8_t *)arr.raw(), strlen(arr.raw()));
+        fbdo->session.response.code = ret;
+        return false;
     }
 
-    Core.mbfs.close(mbfs_type storageType);
     return true;
 }
 
@@ -1189,7 +1813,7 @@ bool FB_RTDB::mRestoreErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, fire
     return openErrorQueue(fbdo, filename, storageType, 1) != 0;
 }
 
-uint8_t FB_RTDB::mErrorQueueCount(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType)
+uint16_t FB_RTDB::mErrorQueueCount(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType)
 {
     return openErrorQueue(fbdo, filename, storageType, 0);
 }
@@ -1199,13 +1823,52 @@ bool FB_RTDB::mDeleteStorageFile(MB_StringPtr filename, firebase_mem_storage_typ
     return Core.mbfs.remove(MB_String(filename), mbfs_type storageType);
 }
 
-uint8_t FB_RTDB::openErrorQueue(FirebaseData *fbdo, MB_StringPtr filename,
-                                firebase_mem_storage_type storageType, uint8_t mode)
+bool FB_RTDB::mBeginErrorQueueJournal(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType)
+{
+    int ret = fbdo->_qMan.beginJournal(&Core.mbfs, MB_String(filename), mbfs_type storageType);
+
+    if (ret < 0)
+    {
+        fbdo->session.response.code = ret;
+        return false;
+    }
+
+    return true;
+}
+
+void FB_RTDB::endErrorQueueJournal(FirebaseData *fbdo)
+{
+    fbdo->_qMan.endJournal();
+}
+
+uint16_t FB_RTDB::openErrorQueue(FirebaseData *fbdo, MB_StringPtr filename,
+                                 firebase_mem_storage_type storageType, uint8_t mode)
 {
-    uint8_t count = 0;
+    uint16_t count = 0;
     MB_String _filename = filename;
+    MB_VECTOR<struct QueueItem> items;
+
+    int ret = QueueManager::loadFile(&Core.mbfs, _filename, mbfs_type storageType, items);
+
+    if (ret < -1)
+    {
+        fbdo->session.response.code = ret;
+        return 0;
+    }
+
+    if (ret >= 0)
+    {
+        if (mode == 1)
+        {
+            for (size_t i = 0; i < items.size(); i++)
+                fbdo->_qMan.add(items.at(i));
+        }
+
+        return items.size();
+    }
 
-    int ret = Core.mbfs.open(_filename, mbfs_type storageType, mb_fs_open_mode_read);
+    // The queue file saved in JSON format by the earlier versions.
+    ret = Core.mbfs.open(_filename, mbfs_type storageType, mb_fs_open_mode_read);
 
     if (ret < 0)
     {
@@ -1261,10 +1924,10 @@ uint8_t FB_RTDB::openErrorQueue(FirebaseData *fbdo, MB_StringPtr filename,
 }
 
 #if (defined(MBFS_FLASH_FS) || defined(MBFS_SD_FS)) && (defined(ESP32) || defined(ESP8266) || defined(MB_ARDUINO_PICO))
-uint8_t FB_RTDB::readQueueFile(FirebaseData *fbdo, fs::File &file, QueueItem &item, uint8_t mode)
+uint16_t FB_RTDB::readQueueFile(FirebaseData *fbdo, fs::File &file, QueueItem &item, uint8_t mode)
 {
 
-    uint8_t count = 0;
+    uint16_t count = 0;
     FirebaseJsonArray arr;
     FirebaseJsonData result;
 
@@ -1330,10 +1993,7 @@ uint8_t FB_RTDB::readQueueFile(FirebaseData *fbdo, fs::File &file, QueueItem &it
                         }
                     }
                 }
-                if (!fbdo->_qMan._queueCollection)
-                    fbdo->_qMan._queueCollection = new MB_VECTOR<struct QueueItem>();
-
-                fbdo->_qMan._queueCollection->push_back(item);
+                fbdo->_qMan.add(item);
             }
             count++;
         }
@@ -1344,9 +2004,9 @@ uint8_t FB_RTDB::readQueueFile(FirebaseData *fbdo, fs::File &file, QueueItem &it
 #endif
 
 #if defined(MBFS_ESP32_SDFAT_ENABLED)
-uint8_t FB_RTDB::readQueueFileSdFat(FirebaseData *fbdo, MBFS_SD_FILE &file, QueueItem &item, uint8_t mode)
+uint16_t FB_RTDB::readQueueFileSdFat(FirebaseData *fbdo, MBFS_SD_FILE &file, QueueItem &item, uint8_t mode)
 {
-    uint8_t count = 0;
+    uint16_t count = 0;
     FirebaseJsonArray arr;
     FirebaseJsonData result;
 
@@ -1412,10 +2072,7 @@ uint8_t FB_RTDB::readQueueFileSdFat(FirebaseData *fbdo, MBFS_SD_FILE &file, Queu
                         }
                     }
                 }
-                if (!fbdo->_qMan._queueCollection)
-                    fbdo->_qMan._queueCollection = new MB_VECTOR<struct QueueItem>();
-
-                fbdo->_qMan._queueCollection->push_back(item);
+                fbdo->_qMan.add(item);
             }
             count++;
         }
@@ -1433,7 +2090,7 @@ bool FB_RTDB::isErrorQueueFull(FirebaseData *fbdo)
     return false;
 }
 
-uint8_t FB_RTDB::errorQueueCount(FirebaseData *fbdo)
+uint16_t FB_RTDB::errorQueueCount(FirebaseData *fbdo)
 {
     return fbdo->_qMan.size();
 }
@@ -1610,14 +2267,29 @@ void FB_RTDB::rescon(FirebaseData *fbdo, const char *host, firebase_rtdb_request
                                                      ? true
                                                      : false;
 
+    // The connection buffers do not fit the workload of this request (adaptive buffer sizing).
+    bool resize = fbdo->tcpClient.isBufferResizeRequired();
+
     if (fbdo->session.cert_updated || millis() - fbdo->session.last_conn_ms > fbdo->session.conn_timeout ||
-        fbdo->session.rtdb.stream_path_changed ||
+        fbdo->session.rtdb.stream_path_changed || resize ||
         (req->method == rtdb_stream && fbdo->session.con_mode != firebase_con_mode_rtdb_stream) ||
         (req->method != rtdb_stream && fbdo->session.con_mode == firebase_con_mode_rtdb_stream) ||
         strcmp(host, fbdo->session.host.c_str()) != 0)
     {
+        // Read the remaining responses of pipelined async requests before closing
+        if (fbdo->session.rtdb.async_pending.size() > 0)
+            readPipelinedResponses(fbdo, true);
+
+        // The connection that is not expired can be returned to the shared pool instead of closing
+        if (!resize && !fbdo->session.cert_updated && millis() - fbdo->session.last_conn_ms <= fbdo->session.conn_timeout)
+            fbdo->releaseConnection();
+
         fbdo->session.last_conn_ms = millis();
         fbdo->closeSession();
+
+        if (req->method != rtdb_stream)
+            fbdo->acquireConnection(host, FIREBASE_PORT);
+
         fbdo->setSecure();
     }
 
@@ -1640,11 +2312,40 @@ bool FB_RTDB::handleRequest(FirebaseData *fbdo, struct firebase_rtdb_request_inf
         return false;
 #endif
 
+    // The transient buffers of request are allocated from arena and released at once when the request completed.
+    bool arena = Core.mbfs.beginArena(Core.config->rtdb.request_arena_size);
+    bool ret = mHandleRequest(fbdo, req);
+    if (arena)
+        Core.mbfs.endArena();
+
+    return ret;
+}
+
+bool FB_RTDB::mHandleRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req)
+{
     if (!fbdo->tcpClient.connected())
         fbdo->session.rtdb.async_count = 0;
 
-    if ((fbdo->session.rtdb.async && !req->async) ||
-        fbdo->session.rtdb.async_count > Core.config->async_close_session_max_request)
+    if (fbdo->session.rtdb.async_pending.size() > 0)
+    {
+        // The pipelined async request reads only the available responses and fails when the pipeline
+        // is still full, other requests wait until all pending responses were read.
+        if (req->async && req->method != rtdb_stream && Core.config->rtdb.async_pipeline_depth > 0)
+        {
+            readPipelinedResponses(fbdo, false);
+            if (fbdo->session.rtdb.async_pending.size() >= Core.config->rtdb.async_pipeline_depth)
+            {
+                fbdo->session.response.code = FIREBASE_ERROR_ASYNC_PIPELINE_FULL;
+                Core.errorToString(fbdo->session.response.code, fbdo->session.error);
+                return false;
+            }
+        }
+        else
+            readPipelinedResponses(fbdo, true);
+    }
+    else if (Core.config->rtdb.async_pipeline_depth == 0 &&
+             ((fbdo->session.rtdb.async && !req->async) ||
+              fbdo->session.rtdb.async_count > Core.config->async_close_session_max_request))
     {
         fbdo->session.rtdb.async_count = 0;
         fbdo->closeSession();
@@ -1671,6 +2372,8 @@ bool FB_RTDB::handleRequest(FirebaseData *fbdo, struct firebase_rtdb_request_inf
 
     if (sendRequest(fbdo, req))
     {
+        if (req->async && Core.config->rtdb.async_pipeline_depth > 0)
+            addAsyncRequest(fbdo, req);
 
         if (req->method == rtdb_stream)
         {
@@ -1915,6 +2618,8 @@ bool FB_RTDB::sendRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_
     size_t toRead = 0;
     bool ret = false;
 
+    fbdo->tcpClient.setBufferProfile(getBufferProfile(req), &Core.mflnCache);
+
     rescon(fbdo, Core.config->database_url.c_str(), req);
 
     if (req->method == rtdb_stream)
@@ -1939,8 +2644,9 @@ bool FB_RTDB::sendRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_
 
     fbdo->session.max_payload_length = 0;
 
-    fbdo->tcpClient.setSession(&fbdo->bsslSession);
+    fbdo->tcpClient.setSession(&fbdo->bsslSession, &Core.tlsSessionCache);
     fbdo->tcpClient.begin(Core.config->database_url.c_str(), FIREBASE_PORT, &fbdo->session.response.code);
+    fbdo->tcpClient.resetSendStats();
 
     if (req->task_type == firebase_rtdb_task_upload_rules)
     {
@@ -2016,39 +2722,11 @@ bool FB_RTDB::sendRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_
     fbdo->tcpClient.dataTime = 0;
 
     // Send payload
-    if (req->data.address.din > 0 && req->data.type == d_json)
-    {
-        FirebaseJson *json = addrTo<FirebaseJson *>(req->data.address.din);
-        if (json)
-            fbdo->tcpSend(json->raw());
-    }
-    else if (req->payload.length() > 0 || (req->data.type == d_array && req->data.address.din > 0))
+    if (req->payload_sent)
     {
-        if (req->pre_payload.length() > 0)
-        {
-            fbdo->tcpSend(req->pre_payload.c_str());
-            if (fbdo->session.response.code < 0)
-                return false;
-        }
-
-        if (req->data.type == d_array && req->data.address.din > 0)
-        {
-            FirebaseJsonArray *arr = addrTo<FirebaseJsonArray *>(req->data.address.din);
-            if (arr)
-                fbdo->tcpSend(arr->raw());
-
-            if (fbdo->session.response.code < 0)
-                return false;
-        }
-        else if (req->payload.length() > 0)
-        {
-            fbdo->tcpSend(req->payload.c_str());
-            if (fbdo->session.response.code < 0)
-                return false;
-        }
-
-        if (req->post_payload.length() > 0)
-            fbdo->tcpSend(req->post_payload.c_str());
+        // the payload in memory was sent together with the request header
+        if (fbdo->session.response.code < 0)
+            return false;
     }
     else if (req->data.address.din > 0 && req->data.blobSize > 0)
     {
@@ -2178,30 +2856,40 @@ bool FB_RTDB::encodeFileToClient(FirebaseData *fbdo, size_t bufSize, const MB_St
     out.bufLen = bufSize;
     uint8_t *outBuf = reinterpret_cast<uint8_t *>(Core.mbfs.newP(out.bufLen));
     out.outT = outBuf;
-    unsigned char *base64EncBuf = Core.bh.creatBase64EncBuffer(&Core.mbfs, false);
-    uint8_t *data = reinterpret_cast<uint8_t *>(Core.mbfs.newP(3));
 
-    while (Core.mbfs.available(mbfs_type storageType))
+    // read the file in blocks of 3-byte groups that fill the output buffer once encoded
+    size_t blockSize = bufSize / 4 * 3;
+    if (blockSize < 3)
+        blockSize = 3;
+    uint8_t *data = reinterpret_cast<uint8_t *>(Core.mbfs.newP(blockSize));
+    size_t pending = 0;
+
+    while (total < size && Core.mbfs.available(mbfs_type storageType))
     {
-        // read 3 bytes from stream
-        int read = Core.mbfs.read(mbfs_type storageType, data, 3);
-        if (read)
+        int read = Core.mbfs.read(mbfs_type storageType, data + pending, blockSize - pending);
+        if (read <= 0)
+            break;
+
+        total += read;
+        pending += read;
+
+        // the incomplete group is kept for the next read unless it is the end of file
+        bool last = total >= size;
+        size_t len = last ? pending : pending - pending % 3;
+        if (!Core.bh.encode<uint8_t>(&Core.mbfs, firebase_base64_table, data, len, out, last /* write remaining */))
         {
-            if (!Core.bh.encode<uint8_t>(&Core.mbfs, base64EncBuf, data, read, out, read != 3 /* write remaining */))
-                break;
-            total += read;
-            reportUploadProgress(fbdo, req, total);
-        }
-        else
+            total = 0;
             break;
-    }
+        }
+
+        pending -= len;
+        if (pending > 0)
+            memmove(data, data + len, pending);
 
-    // remainig data to wrire? write it
-    if (size == total && out.bufWrite > 0)
-        Core.bh.writeOutput(&Core.mbfs, out);
+        reportUploadProgress(fbdo, req, total);
+    }
 
     Core.mbfs.delP(&data);
-    Core.mbfs.delP(&base64EncBuf);
     Core.mbfs.delP(&outBuf);
 
     return size == total;
@@ -2280,7 +2968,8 @@ waits:
     if (fbdo->session.con_mode != firebase_con_mode_rtdb_stream)
     {
         if (fbdo->session.rtdb.async)
-            return fbdo->tcpClient.connected();
+            return fbdo->session.rtdb.async_pending.size() > 0 ? readPipelinedResponses(fbdo, false)
+                                                               : fbdo->tcpClient.connected();
         else if (!fbdo->waitResponse(tcpHandler))
             return false;
     }
@@ -2345,6 +3034,10 @@ waits:
             }
 
             fbdo->session.rtdb.resp_etag = response.etag;
+
+            // the streaming reader starts over for every response e.g. the retried request
+            if (fbdo->session.rtdb.json_reader)
+                fbdo->session.rtdb.json_reader->reset();
         }
         // not http header received, stream payload received?
         else if (!tcpHandler.isHeader && tcpHandler.header.length() > 0)
@@ -2437,7 +3130,17 @@ waits:
                 {
 
                     FBUtils::idle();
-                    payload += pChunk;
+
+                    // the streaming reader takes the JSON payload chunk by chunk,
+                    // only the first chunk is kept for the data type parsing in parseTCPResponse()
+                    if (fbdo->session.rtdb.json_reader && response.httpCode == FIREBASE_ERROR_HTTP_CODE_OK)
+                    {
+                        fbdo->session.rtdb.json_reader->parse(pChunk.c_str(), pChunk.length());
+                        if (payload.length() == 0)
+                            payload = pChunk;
+                    }
+                    else
+                        payload += pChunk;
 
                     // early parsing currently available http response for data types, event types, and event data
                     // which these information will be used for download task
@@ -2458,69 +3161,314 @@ waits:
                         // In case file is available in stream with no download request,
                         // we store this file data to temp file (/fb_bin_0.tmp) that user can read from stream data
 
-                        Core.mbfs.remove(pgm2Str(firebase_rtdb_pgm_str_10 /* "/fb_bin_0.tmp" */), mb_fs_mem_storage_type_flash);
-                        int sz = Core.mbfs.open(pgm2Str(firebase_rtdb_pgm_str_10 /* "/fb_bin_0.tmp" */),
-                                                mb_fs_mem_storage_type_flash, mb_fs_open_mode_append);
-                        if (sz < 0)
-                            fbdo->session.response.code = sz;
+                        Core.mbfs.remove(pgm2Str(firebase_rtdb_pgm_str_10 /* "/fb_bin_0.tmp" */), mb_fs_mem_storage_type_flash);
+                        int sz = Core.mbfs.open(pgm2Str(firebase_rtdb_pgm_str_10 /* "/fb_bin_0.tmp" */),
+                                                mb_fs_mem_storage_type_flash, mb_fs_open_mode_append);
+                        if (sz < 0)
+                            fbdo->session.response.code = sz;
+
+                        // we keep the first part of JSON for parsing later with parsePayload()
+                        MB_String stream = payload.substr(0, response.payloadOfs);
+                        // append " and } to make a valid JSON
+                        stream += firebase_pgm_str_4;  // "\""
+                        stream += firebase_pgm_str_11; // "}"
+
+                        payload.erase(0, response.payloadOfs);
+
+                        // stream event data complete
+                        if (streamDataComplete)
+                        {
+                            trimEndJson(payload);
+                            Core.bh.decodeToFile(&Core.mbfs, payload.c_str(),
+                                                 payload.length(), mb_fs_mem_storage_type_flash);
+                        }
+                        // stream event data is not complete, try to read incoming data as a chunk (multiples of 4 bytes length)
+                        // base64 decoded and store in temp file
+                        else
+                        {
+                            unsigned long time = millis();
+                            while (!streamDataComplete && millis() - time < 1000 /* something wrongs if time out */)
+                                // keep reading until the end of JSON tag found
+                                readBase64FileChunk(fbdo, payload, tcpHandler, response, pChunkSize, streamDataComplete);
+                        }
+
+                        // Save the payload
+                        payload = stream;
+                        payload.shrink_to_fit();
+                        Core.mbfs.close(mb_fs_mem_storage_type_flash);
+                        goto skip;
+#endif
+                    }
+                }
+
+                if (Core.ut.isResponseComplete(&tcpHandler, &response, complete, fbdo->session.con_mode != firebase_con_mode_rtdb_stream))
+                    goto skip;
+            }
+        }
+
+        tcpHandler.dataTime = millis();
+    }
+
+skip:
+
+    // To make sure all chunks read and
+    // ready to send next request
+    if (response.isChunkedEnc)
+        fbdo->tcpClient.flush();
+
+    endDownload(fbdo, req, tcpHandler, response);
+
+    if (fbdo->session.rtdb.json_reader && response.httpCode == FIREBASE_ERROR_HTTP_CODE_OK)
+    {
+        fbdo->session.rtdb.resp_data_type = response.dataType;
+        fbdo->session.content_length = response.payloadLen;
+
+        // the payload was already parsed by the streaming reader
+        if (!fbdo->session.rtdb.json_reader->end() && !response.noContent &&
+            fbdo->session.response.code == FIREBASE_ERROR_HTTP_CODE_OK)
+        {
+            fbdo->session.response.code = FIREBASE_ERROR_EXPECTED_JSON_DATA;
+            Core.errorToString(fbdo->session.response.code, fbdo->session.error);
+        }
+
+        payload.clear();
+    }
+
+    parsePayload(fbdo, req, response, payload);
+
+    handleNoContent(fbdo, response);
+
+    return fbdo->session.response.code == FIREBASE_ERROR_HTTP_CODE_OK ||
+           (fbdo->session.con_mode == firebase_con_mode_rtdb_stream && fbdo->session.response.code == FIREBASE_ERROR_HTTP_CODE_UNDEFINED);
+}
+
+void FB_RTDB::addAsyncRequest(FirebaseData *fbdo, firebase_rtdb_request_info_t *req)
+{
+    struct firebase_rtdb_async_request_t item;
+    item.id = ++fbdo->session.rtdb.async_id;
+    item.path = req->path;
+
+    // The response timeout is counted from the first request in pipeline
+    if (fbdo->session.rtdb.async_pending.size() == 0)
+        fbdo->session.rtdb.async_reader.data_ms = millis();
+
+    fbdo->session.rtdb.async_pending.push_back(item);
+}
+
+bool FB_RTDB::readPipelinedResponses(FirebaseData *fbdo, bool wait)
+{
+    struct firebase_rtdb_async_reader_t &reader = fbdo->session.rtdb.async_reader;
+
+    while (fbdo->session.rtdb.async_pending.size() > 0)
+    {
+        // The responses are lost when the connection was closed or used by other services
+        if (!fbdo->tcpClient.connected() || fbdo->session.con_mode != firebase_con_mode_rtdb)
+        {
+            abortAsyncRequests(fbdo, FIREBASE_ERROR_TCP_ERROR_NOT_CONNECTED);
+            return false;
+        }
+
+        if (fbdo->tcpClient.available() <= 0)
+        {
+            if (millis() - reader.data_ms > Core.config->timeout.serverResponse)
+            {
+                abortAsyncRequests(fbdo, FIREBASE_ERROR_TCP_RESPONSE_PAYLOAD_READ_TIMED_OUT);
+                fbdo->closeSession();
+                return false;
+            }
+
+            if (!wait)
+                break;
+
+            FBUtils::idle();
+            continue;
+        }
+
+        reader.data_ms = millis();
+
+        // Read only the remaining bytes of current response, the rest belongs to the next response
+        if (reader.state == firebase_rtdb_async_read_content || reader.state == firebase_rtdb_async_read_chunk_data)
+        {
+            char buf[129];
+            int len = fbdo->tcpClient.available();
+            if (len > reader.remaining)
+                len = reader.remaining;
+            if (len > 128)
+                len = 128;
+
+            len = fbdo->tcpClient.readBytes(buf, len);
+            if (len <= 0)
+                continue;
+
+            buf[len] = 0;
+            reader.remaining -= len;
+
+            // Keep the payload up to the response buffer size, the rest of response is discarded
+            if (!reader.truncated && reader.payload.length() + len <= fbdo->session.resp_size)
+                reader.payload += buf;
+            else
+                reader.truncated = true;
+
+            if (reader.remaining == 0)
+            {
+                if (reader.state == firebase_rtdb_async_read_content)
+                    completeAsyncRequest(fbdo, reader.http_code);
+                else
+                    reader.state = firebase_rtdb_async_read_chunk_end;
+            }
+
+            continue;
+        }
+
+        // The other parts are line based, wait until the line is complete
+        Core.hh.readLine(&fbdo->tcpClient, reader.line);
+        if (reader.line.length() == 0 || reader.line[reader.line.length() - 1] != '\n')
+            continue;
+
+        bool emptyLine = reader.line.length() == 1 || (reader.line.length() == 2 && reader.line[0] == '\r');
+
+        switch (reader.state)
+        {
+        case firebase_rtdb_async_read_status:
+        {
+            int pos = 0;
+            reader.http_code = Core.hh.getStatusCode(&Core.sh, reader.line, pos);
+            if (reader.http_code > 0)
+            {
+                reader.header.clear();
+                reader.state = firebase_rtdb_async_read_header;
+            }
+            else if (!emptyLine)
+            {
+                // The response is out of sync
+                reader.line.clear();
+                abortAsyncRequests(fbdo, FIREBASE_ERROR_TCP_RESPONSE_READ_FAILED);
+                fbdo->closeSession();
+                return false;
+            }
+            break;
+        }
+
+        case firebase_rtdb_async_read_header:
+            if (emptyLine)
+            {
+                struct server_response_data_t response;
+                response.httpCode = reader.http_code;
+                Core.hh.parseRespHeader(&Core.sh, reader.header, response);
+
+                reader.close = response.connection.length() > 0 &&
+                               !Core.sh.compare(response.connection, 0, firebase_pgm_str_15 /* "keep-alive" */);
+
+                // Skip the interim response
+                if (reader.http_code == 100)
+                    reader.state = firebase_rtdb_async_read_status;
+                else if (response.isChunkedEnc)
+                    reader.state = firebase_rtdb_async_read_chunk_size;
+                else if (response.noContent || response.contentLen <= 0)
+                    completeAsyncRequest(fbdo, reader.http_code);
+                else
+                {
+                    reader.remaining = response.contentLen;
+                    reader.state = firebase_rtdb_async_read_content;
+                }
+            }
+            else
+                reader.header += reader.line;
+            break;
 
-                        // we keep the first part of JSON for parsing later with parsePayload()
-                        MB_String stream = payload.substr(0, response.payloadOfs);
-                        // append " and } to make a valid JSON
-                        stream += firebase_pgm_str_4;  // "\""
-                        stream += firebase_pgm_str_11; // "}"
+        case firebase_rtdb_async_read_chunk_size:
+        {
+            size_t len = 0;
+            while (len < reader.line.length() && isxdigit(reader.line[len]))
+                len++;
 
-                        payload.erase(0, response.payloadOfs);
+            reader.remaining = Core.hh.hex2int(reader.line.substr(0, len).c_str());
+            reader.state = reader.remaining > 0 ? firebase_rtdb_async_read_chunk_data
+                                                : firebase_rtdb_async_read_trailer;
+            break;
+        }
 
-                        // stream event data complete
-                        if (streamDataComplete)
-                        {
-                            trimEndJson(payload);
-                            Core.bh.decodeToFile(&Core.mbfs, payload.c_str(),
-                                                 payload.length(), mb_fs_mem_storage_type_flash);
-                        }
-                        // stream event data is not complete, try to read incoming data as a chunk (multiples of 4 bytes length)
-                        // base64 decoded and store in temp file
-                        else
-                        {
-                            unsigned long time = millis();
-                            while (!streamDataComplete && millis() - time < 1000 /* something wrongs if time out */)
-                                // keep reading until the end of JSON tag found
-                                readBase64FileChunk(fbdo, payload, tcpHandler, response, pChunkSize, streamDataComplete);
-                        }
+        case firebase_rtdb_async_read_chunk_end:
+            reader.state = firebase_rtdb_async_read_chunk_size;
+            break;
 
-                        // Save the payload
-                        payload = stream;
-                        payload.shrink_to_fit();
-                        Core.mbfs.close(mb_fs_mem_storage_type_flash);
-                        goto skip;
-#endif
-                    }
-                }
+        case firebase_rtdb_async_read_trailer:
+            if (emptyLine)
+                completeAsyncRequest(fbdo, reader.http_code);
+            break;
 
-                if (Core.ut.isResponseComplete(&tcpHandler, &response, complete, fbdo->session.con_mode != firebase_con_mode_rtdb_stream))
-                    goto skip;
-            }
+        default:
+            break;
         }
 
-        tcpHandler.dataTime = millis();
+        reader.line.clear();
     }
 
-skip:
+    return true;
+}
 
-    // To make sure all chunks read and
-    // ready to send next request
-    if (response.isChunkedEnc)
-        fbdo->tcpClient.flush();
+void FB_RTDB::completeAsyncRequest(FirebaseData *fbdo, int code)
+{
+    struct firebase_rtdb_async_reader_t &reader = fbdo->session.rtdb.async_reader;
 
-    endDownload(fbdo, req, tcpHandler, response);
+    RTDB_AsyncResultInfo info;
+    if (fbdo->session.rtdb.async_pending.size() > 0)
+    {
+        info.id = fbdo->session.rtdb.async_pending[0].id;
+        info.path = fbdo->session.rtdb.async_pending[0].path;
+        fbdo->session.rtdb.async_pending.erase(fbdo->session.rtdb.async_pending.begin());
+    }
+    info.httpCode = code;
+    info.payload = reader.payload;
+    info.truncated = reader.truncated;
+
+    bool close = reader.close;
+
+    reader.state = firebase_rtdb_async_read_status;
+    reader.http_code = 0;
+    reader.remaining = 0;
+    reader.close = false;
+    reader.truncated = false;
+    reader.line.clear();
+    reader.header.clear();
+    reader.payload.clear();
+
+    // The result is passed to the callback later by deliverAsyncResults, not inside the request that read it
+    if (fbdo->session.rtdb.async_cb)
+        fbdo->session.rtdb.async_results.push_back(info);
+
+    // Server will close the connection, the remaining requests will not be responded
+    if (close)
+    {
+        abortAsyncRequests(fbdo, FIREBASE_ERROR_TCP_ERROR_NOT_CONNECTED);
+        fbdo->closeSession();
+    }
+}
 
-    parsePayload(fbdo, req, response, payload);
+void FB_RTDB::deliverAsyncResults(FirebaseData *fbdo)
+{
+    // The results are taken out before calling back, the callback may send the next async requests
+    MB_VECTOR<RTDB_AsyncResultInfo> results;
+    results.swap(fbdo->session.rtdb.async_results);
 
-    handleNoContent(fbdo, response);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        if (fbdo->session.rtdb.async_cb)
+            fbdo->session.rtdb.async_cb(results[i]);
+    }
+}
 
-    return fbdo->session.response.code == FIREBASE_ERROR_HTTP_CODE_OK ||
-           (fbdo->session.con_mode == firebase_con_mode_rtdb_stream && fbdo->session.response.code == FIREBASE_ERROR_HTTP_CODE_UNDEFINED);
+void FB_RTDB::abortAsyncRequests(FirebaseData *fbdo, int code)
+{
+    // Discard the partial response
+    fbdo->session.rtdb.async_reader.payload.clear();
+    fbdo->session.rtdb.async_reader.close = false;
+    fbdo->session.rtdb.async_reader.truncated = false;
+
+    while (fbdo->session.rtdb.async_pending.size() > 0)
+        completeAsyncRequest(fbdo, code);
+
+    fbdo->session.rtdb.async_reader.line.clear();
 }
 
 void FB_RTDB::trimEndJson(MB_String &payload)
@@ -2555,8 +3503,12 @@ void FB_RTDB::readBase64FileChunk(FirebaseData *fbdo, MB_String &payload, struct
             {
                 int toLen = chunkSize - payload.length();
                 payload += pChunk.substr(0, toLen);
-                Core.bh.decodeToFile(&Core.mbfs, payload.c_str(), payload.length(), mb_fs_mem_storage_type_flash);
-                payload = pChunk.substr(toLen, total - chunkSize);
+                // decode the complete 4-character groups only, the rest is decoded with the next chunk
+                size_t decLen = payload.length() - payload.length() % 4;
+                if (decLen > 0)
+                    Core.bh.decodeToFile(&Core.mbfs, payload.c_str(), decLen, mb_fs_mem_storage_type_flash);
+                payload.erase(0, decLen);
+                payload += pChunk.substr(toLen, total - chunkSize);
             }
             else
                 payload += pChunk;
@@ -2746,7 +3698,7 @@ void FB_RTDB::sendCB(FirebaseData *fbdo)
 
     // prevent the data available and stream data changed flags reset by
     // streamAvailable without stream callbacks assigned.
-    if (!fbdo->_dataAvailableCallback && !fbdo->_multiPathDataCallback)
+    if (!fbdo->_dataAvailableCallback && !fbdo->_multiPathDataCallback && fbdo->_multiPathChildCallbacks.size() == 0)
         return;
 
     if (!fbdo->streamAvailable())
@@ -2804,7 +3756,7 @@ void FB_RTDB::sendCB(FirebaseData *fbdo)
 
         s.empty();
     }
-    else if (fbdo->_multiPathDataCallback)
+    else
     {
         FIREBASE_MP_STREAM_CLASS s;
         s.begin(&fbdo->session.rtdb.stream);
@@ -2815,55 +3767,225 @@ void FB_RTDB::sendCB(FirebaseData *fbdo)
         s.sif->payload_length = fbdo->session.payload_length;
         s.sif->max_payload_length = fbdo->session.max_payload_length;
 
-        if (!fbdo->session.jsonPtr)
-            fbdo->session.jsonPtr = new FirebaseJson();
+        // the event data is parsed once for the indexed child paths callbacks and the data callback
+        MB_JSON *root = nullptr;
 
         if (fbdo->session.rtdb.resp_data_type == d_json)
+        {
+            if (!fbdo->session.jsonPtr)
+                fbdo->session.jsonPtr = new FirebaseJson();
+
             fbdo->session.jsonPtr->setJsonData(fbdo->session.rtdb.raw.c_str());
+            root = fbdo->session.jsonPtr->root;
+        }
 
-        if (s.sif->data_type == d_json)
-            s.sif->m_json = fbdo->session.jsonPtr;
-        else
+        // only the changed child paths are dispatched
+        dispatchMultiPathStream(fbdo, s, root);
+
+        if (fbdo->_multiPathDataCallback)
         {
-            fbdo->session.jsonPtr->clear();
-            s.sif->data = fbdo->session.rtdb.raw.c_str();
+            if (!fbdo->session.jsonPtr)
+                fbdo->session.jsonPtr = new FirebaseJson();
+
+            if (s.sif->data_type == d_json)
+                s.sif->m_json = fbdo->session.jsonPtr;
+            else
+            {
+                fbdo->session.jsonPtr->clear();
+                s.sif->data = fbdo->session.rtdb.raw.c_str();
+            }
+
+            fbdo->_multiPathDataCallback(s);
         }
+        else if (root && fbdo->session.jsonPtr)
+            fbdo->session.jsonPtr->clear();
 
-        fbdo->_multiPathDataCallback(s);
         fbdo->session.rtdb.data_available = false;
         s.empty();
     }
 }
 
-void FB_RTDB::splitStreamPayload(const MB_String &payloads, MB_VECTOR<MB_String> &payload)
+int FB_RTDB::findMultiPathNode(FirebaseData *fbdo, int parent, const char *key, size_t len)
+{
+    MB_VECTOR<struct firebase_mp_stream_path_node_t> &nodes = fbdo->session.rtdb.mp_stream_paths;
+
+    for (int i = nodes[parent].first_child; i > -1; i = nodes[i].next_sibling)
+    {
+        if (nodes[i].key.length() == len && memcmp(nodes[i].key.c_str(), key, len) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+void FB_RTDB::dispatchMultiPathStream(FirebaseData *fbdo, FIREBASE_MP_STREAM_CLASS &s, MB_JSON *root)
+{
+    MB_VECTOR<struct firebase_mp_stream_path_node_t> &nodes = fbdo->session.rtdb.mp_stream_paths;
+
+    if (nodes.size() == 0)
+        return;
+
+    // walk down the index along the event path, the child paths that are the event path
+    // or its parents get the whole event data
+    const char *p = fbdo->session.rtdb.path.c_str();
+    int node = 0;
+
+    while (*p)
+    {
+        while (*p == '/')
+            p++;
+
+        const char *e = p;
+        while (*e && *e != '/')
+            e++;
+
+        if (e == p)
+            break;
+
+        node = findMultiPathNode(fbdo, node, p, e - p);
+
+        if (node < 0)
+            return;
+
+        if (nodes[node].callback_index > -1)
+            callMultiPathChild(fbdo, s, node, nullptr);
+
+        // the index was removed in the callback
+        if (nodes.size() == 0)
+            return;
+
+        p = e;
+    }
+
+    if (nodes[node].first_child < 0)
+        return;
+
+    // the child paths under the event path, the put event replaces the data at the event path
+    // and the registered child paths that are not in the event data were deleted,
+    // the patch event only changes the keys of the event data
+    bool replace = !Core.sh.compare(fbdo->session.rtdb.event_type, 0, firebase_pgm_str_17 /* "patch" */);
+
+    // the event data that could not be parsed
+    if (fbdo->session.rtdb.resp_data_type == d_json && !root)
+        return;
+
+    if (root || replace)
+        dispatchMultiPathJson(fbdo, s, node, root, replace);
+}
+
+void FB_RTDB::dispatchMultiPathJson(FirebaseData *fbdo, FIREBASE_MP_STREAM_CLASS &s, int parent, MB_JSON *item, bool replace)
 {
-    int ofs = 0;
-    int pos1 = 0, pos2 = 0, pos3 = 0;
+    MB_VECTOR<struct firebase_mp_stream_path_node_t> &nodes = fbdo->session.rtdb.mp_stream_paths;
 
-    while (pos1 > -1)
+    if (replace)
     {
-        if (Core.sh.find(payloads, firebase_rtdb_pgm_str_12 /* "event: " */, false, ofs, pos1))
+        // visit the registered children, the absent keys get the null value
+        for (int node = nodes[parent].first_child; node > -1; node = nodes[node].next_sibling)
         {
-            ofs = pos1 + 1;
-            if (Core.sh.find(payloads, firebase_rtdb_pgm_str_13 /* "data: " */, false, ofs, pos2))
-            {
-                ofs = pos2 + 1;
-                if (Core.sh.find(payloads, firebase_pgm_str_12 /* "\n" */, false, ofs, pos3))
-                    ofs = pos3 + 1;
-                else
-                    pos3 = payloads.length();
+            MB_JSON *e = item && MB_JSON_IsObject(item) ? MB_JSON_GetObjectItemCaseSensitive(item, nodes[node].key.c_str()) : nullptr;
 
-                payload.push_back(payloads.substr(pos1, pos3 - pos1));
+            if (nodes[node].callback_index > -1)
+            {
+                MB_JSON *deleted = e ? nullptr : MB_JSON_CreateNull();
+                callMultiPathChild(fbdo, s, node, e ? e : deleted);
+                if (deleted)
+                    MB_JSON_Delete(deleted);
             }
+
+            if (nodes.size() == 0)
+                return;
+
+            if (nodes[node].first_child > -1)
+                dispatchMultiPathJson(fbdo, s, node, e, true);
+
+            if (nodes.size() == 0)
+                return;
+        }
+
+        return;
+    }
+
+    for (MB_JSON *e = item->child; e; e = e->next)
+    {
+        if (!e->string)
+            continue;
+
+        int node = findMultiPathNode(fbdo, parent, e->string, strlen(e->string));
+
+        if (node < 0)
+            continue;
+
+        if (nodes[node].callback_index > -1)
+            callMultiPathChild(fbdo, s, node, e);
+
+        if (nodes.size() == 0)
+            return;
+
+        // the patched key replaces its whole data
+        if (nodes[node].first_child > -1)
+            dispatchMultiPathJson(fbdo, s, node, e, true);
+    }
+}
+
+void FB_RTDB::callMultiPathChild(FirebaseData *fbdo, FIREBASE_MP_STREAM_CLASS &s, int node, MB_JSON *item)
+{
+    struct firebase_mp_stream_path_node_t &n = fbdo->session.rtdb.mp_stream_paths[node];
+
+    if (item && MB_JSON_IsString(item))
+    {
+        // the parsed string was unescaped
+        s.value = item->valuestring;
+        s.type = fbdo->getDataType(d_string).c_str();
+        s.dataPath = n.path.c_str();
+    }
+    else if (item)
+    {
+        char *p = MB_JSON_PrintUnformatted(item);
+        if (!p)
+            return;
+
+        uint8_t type = d_json;
+
+        if (MB_JSON_IsArray(item))
+            type = d_array;
+        else if (MB_JSON_IsBool(item))
+            type = d_boolean;
+        else if (MB_JSON_IsNull(item))
+            type = d_null;
+        else if (MB_JSON_IsNumber(item))
+        {
+            // the number type is from its token in the event data as the response payload (see FBUtils)
+            if (item->type & MB_JSON_NumberIsDecimal)
+                type = strlen(p) <= 7 ? d_float : d_double;
+            else
+                type = item->valuedouble > 0x7fffffff ? d_double : d_integer;
         }
+
+        s.value = p;
+
+        MB_JSON_free(p);
+        s.type = fbdo->getDataType(type).c_str();
+        s.dataPath = n.path.c_str();
     }
+    else
+    {
+        s.value = fbdo->session.rtdb.raw.c_str();
+        s.type = s.sif->data_type_str.c_str();
+        s.dataPath = s.sif->path.c_str();
+    }
+
+    s.eventType = s.sif->event_type_str.c_str();
+
+    fbdo->_multiPathChildCallbacks[n.callback_index](s);
 }
 
-void FB_RTDB::parseStreamPayload(FirebaseData *fbdo, const MB_String &payload)
+void FB_RTDB::parseStreamPayload(FirebaseData *fbdo, const MB_String &payload, int begin, int end)
 {
     struct server_response_data_t response;
 
-    Core.hh.parseRespPayload(&Core.sh, payload, response, false);
+    Core.hh.parseStreamEvent(&Core.sh, payload.c_str(), begin, end, response);
+    const char *eventType = payload.c_str() + response.eventType.ofs;
+    int eventTypeLen = response.eventType.len;
 
     fbdo->session.rtdb.resp_data_type = response.dataType;
     fbdo->session.content_length = response.payloadLen;
@@ -2881,7 +4003,8 @@ void FB_RTDB::parseStreamPayload(FirebaseData *fbdo, const MB_String &payload)
         }
 
         fbdo->session.rtdb.raw.clear();
-        Core.bh.decodeToArray<uint8_t>(&Core.mbfs, payload.c_str() + response.payloadOfs, *fbdo->session.rtdb.blob);
+        if (response.payloadLen > 0)
+            Core.bh.decodeToArray<uint8_t>(&Core.mbfs, payload.c_str() + response.payloadOfs, response.payloadLen, *fbdo->session.rtdb.blob);
     }
     else if (fbdo->session.rtdb.resp_data_type == d_file)
     {
@@ -2889,8 +4012,8 @@ void FB_RTDB::parseStreamPayload(FirebaseData *fbdo, const MB_String &payload)
         fbdo->session.rtdb.raw.clear();
     }
 
-    if (Core.sh.compare(response.eventType, 0, firebase_pgm_str_16 /* "put" */) ||
-        Core.sh.compare(response.eventType, 0, firebase_pgm_str_17 /* "patch" */))
+    if (Core.sh.compare(eventType, eventTypeLen, 0, firebase_pgm_str_16 /* "put" */) ||
+        Core.sh.compare(eventType, eventTypeLen, 0, firebase_pgm_str_17 /* "patch" */))
     {
 
         handlePayload(fbdo, response, payload);
@@ -2915,30 +4038,31 @@ void FB_RTDB::parseStreamPayload(FirebaseData *fbdo, const MB_String &payload)
     else
     {
         // Firebase keep alive event
-        if (Core.sh.compare(response.eventType, 0, firebase_pgm_str_15 /* "keep-alive" */))
+        if (Core.sh.compare(eventType, eventTypeLen, 0, firebase_pgm_str_15 /* "keep-alive" */))
         {
             if (fbdo->_timeoutCallback)
                 fbdo->sendStreamToCB(0);
         }
 
         // Firebase cancel and auth_revoked events
-        else if (Core.sh.compare(response.eventType, 0, firebase_rtdb_pgm_str_14 /* "cancel" */) ||
-                 Core.sh.compare(response.eventType, 0, firebase_rtdb_pgm_str_15 /* "auth_revoked" */))
+        else if (Core.sh.compare(eventType, eventTypeLen, 0, firebase_rtdb_pgm_str_14 /* "cancel" */) ||
+                 Core.sh.compare(eventType, eventTypeLen, 0, firebase_rtdb_pgm_str_15 /* "auth_revoked" */))
         {
-            fbdo->session.rtdb.event_type = response.eventType;
+            fbdo->session.rtdb.event_type.clear();
+            fbdo->session.rtdb.event_type.append(eventType, eventTypeLen);
             // make stream available status
             fbdo->session.rtdb.stream_data_changed = true;
             fbdo->session.rtdb.data_available = true;
 
             // We need to close the current session due to the token was already expired.
-            if (Core.sh.compare(response.eventType, 0, firebase_rtdb_pgm_str_15 /* "auth_revoked" */))
+            if (Core.sh.compare(eventType, eventTypeLen, 0, firebase_rtdb_pgm_str_15 /* "auth_revoked" */))
                 fbdo->closeSession();
         }
     }
 }
 
 void FB_RTDB::parsePayload(FirebaseData *fbdo, firebase_rtdb_request_info_t *req,
-                           struct server_response_data_t &response, MB_String payload)
+                           struct server_response_data_t &response, MB_String &payload)
 {
     // parse the payload
     if (payload.length() > 0)
@@ -2946,35 +4070,25 @@ void FB_RTDB::parsePayload(FirebaseData *fbdo, firebase_rtdb_request_info_t *req
         // stream data?
         if (response.isEvent)
         {
-            int pos = 0, ofs = 0, jsonCount = 0;
+            int ofs = 0, begin = 0, end = 0;
+            int len = payload.length();
             bool validJson = false;
 
-            // counting the occurences of JSON sets
-            while (pos > -1)
-            {
-                if (Core.sh.find(payload, firebase_rtdb_pgm_str_12 /* "event: " */, false, ofs, pos))
-                {
-                    ofs = pos + 1;
-                    jsonCount++;
-                }
-            }
-
-            // we need to spit the tream data if stream data contains multiple sets of JSON
+            // The stream data may contain multiple sets of event JSON
             // that happens in case simultaneously children data changes.
             // {json1}{json..}{json n}
-            // Then we pase each JSON and send to callback function.
-            MB_VECTOR<MB_String> payloadList;
-            splitStreamPayload(payload, payloadList);
-            for (size_t i = 0; i < payloadList.size(); i++)
+            // Each set is located by offsets in the payload buffer and parsed in place,
+            // then we send it to callback function.
+            while (Core.hh.nextStreamEvent(&Core.sh, payload.c_str(), len, ofs, begin, end))
             {
-                if (Core.ut.validJS(payloadList[i].c_str()))
+                if (Core.ut.validJS(payload.c_str() + begin, end - begin))
                 {
                     validJson = true;
-                    parseStreamPayload(fbdo, payloadList[i].c_str());
+                    parseStreamPayload(fbdo, payload, begin, end);
                     sendCB(fbdo);
                 }
             }
-            payloadList.clear(); // clear payload after splitting
+
             payload.clear();
 
             if (validJson)
@@ -3068,15 +4182,23 @@ void FB_RTDB::handlePayload(FirebaseData *fbdo, struct server_response_data_t &r
 
     if (response.isEvent)
     {
-        response.eventPathChanged = strcmp(response.eventPath.c_str(), fbdo->session.rtdb.path.c_str()) != 0;
-        fbdo->session.rtdb.path = response.eventPath;
-        fbdo->session.rtdb.event_type = response.eventType;
+        // the event parts are in the payload buffer
+        const char *path = payload.c_str() + response.eventPath.ofs;
+        response.eventPathChanged = fbdo->session.rtdb.path.length() != (size_t)response.eventPath.len ||
+                                    strncmp(path, fbdo->session.rtdb.path.c_str(), response.eventPath.len) != 0;
+        fbdo->session.rtdb.path.clear();
+        fbdo->session.rtdb.path.append(path, response.eventPath.len);
+        fbdo->session.rtdb.event_type.clear();
+        fbdo->session.rtdb.event_type.append(payload.c_str() + response.eventType.ofs, response.eventType.len);
     }
 
     if (fbdo->session.rtdb.resp_data_type != d_blob && fbdo->session.rtdb.resp_data_type != d_file_ota)
     {
         if (response.isEvent)
-            fbdo->session.rtdb.raw = response.eventData.c_str();
+        {
+            fbdo->session.rtdb.raw.clear();
+            fbdo->session.rtdb.raw.append(payload.c_str() + response.eventData.ofs, response.eventData.len);
+        }
         else
             fbdo->session.rtdb.raw = payload;
 
@@ -3150,6 +4272,19 @@ firebase_request_method FB_RTDB::getHTTPMethod(firebase_rtdb_request_info_t *req
     return req->method;
 }
 
+firebase_bssl_buffer_profile FB_RTDB::getBufferProfile(struct firebase_rtdb_request_info_t *req)
+{
+    if (req->method == rtdb_stream)
+        return firebase_bssl_buffer_profile_stream;
+    else if (req->method == rtdb_backup ||
+             ((req->data.type == d_file || req->data.type == d_file_ota) && getHTTPMethod(req) == http_get))
+        return firebase_bssl_buffer_profile_download;
+    else if (req->method == rtdb_restore || (req->data.type == d_file && hasPayload(req)))
+        return firebase_bssl_buffer_profile_upload;
+
+    return firebase_bssl_buffer_profile_request;
+}
+
 bool FB_RTDB::hasPayload(struct firebase_rtdb_request_info_t *req)
 {
     return getHTTPMethod(req) == http_put || getHTTPMethod(req) == http_post || getHTTPMethod(req) == http_patch;
@@ -3173,7 +4308,13 @@ bool FB_RTDB::sendRequestHeader(FirebaseData *fbdo, struct firebase_rtdb_request
             hasServerValue = Core.sh.find(req->payload, firebase_rtdb_pgm_str_17 /* "\".sv\"" */, false, 0, p);
     }
 
+    // The invariant parts of header were pre-rendered and reused until the token or config changed.
+    updateHeaderCache(fbdo);
+    struct firebase_rtdb_header_cache_t &cache = fbdo->session.rtdb.header_cache;
+
     MB_String header;
+    // reserve once for the whole header which sent in single write
+    header.reserve(req->path.length() + cache.auth_query.length() + cache.common.length() + 256);
 
     Core.hh.addRequestHeaderFirst(header, fbdo->session.classic_request &&
                                                   (http_method == http_put || http_method == http_delete)
@@ -3201,21 +4342,8 @@ bool FB_RTDB::sendRequestHeader(FirebaseData *fbdo, struct firebase_rtdb_request
 
     if (appendAuth)
     {
-        header += firebase_rtdb_pgm_str_18; // ".json"
-        if (Core.getTokenType() != token_type_oauth2_access_token && !Core.config->signer.test_mode)
-            Core.uh.addParam(header, firebase_rtdb_pgm_str_19 /* "auth=" */, "", hasQueryParams, true);
-
-        fbdo->tcpSend(header.c_str());
-        header.clear();
-
-        if (fbdo->session.response.code < 0)
-            return false;
-
-        if (Core.getTokenType() != token_type_oauth2_access_token && !Core.config->signer.test_mode)
-            fbdo->tcpSend(Core.internal.auth_token.c_str());
-
-        if (fbdo->session.response.code < 0)
-            return false;
+        header += cache.auth_query; // ".json?auth=<token>"
+        hasQueryParams = cache.auth_param;
     }
 
     if (fbdo->session.rtdb.read_tmo > 0)
@@ -3258,32 +4386,7 @@ bool FB_RTDB::sendRequestHeader(FirebaseData *fbdo, struct firebase_rtdb_request
         req->method == rtdb_update_nocontent)
         Core.uh.addParam(header, firebase_rtdb_pgm_str_29 /* "print=silent" */, "", hasQueryParams, true);
 
-    Core.hh.addRequestHeaderLast(header);
-    Core.hh.addHostHeader(header, Core.config->database_url.c_str());
-    Core.hh.addUAHeader(header);
-    Core.hh.getCustomHeaders(&Core.sh, header, Core.config->signer.customHeaders);
-
-    if (Core.getTokenType() == token_type_oauth2_access_token)
-    {
-        Core.hh.addAuthHeaderFirst(header, token_type_oauth2_access_token);
-
-        if (Core.config->signer.tokens.auth_type.length() > 0 &&
-            Core.config->signer.tokens.auth_type[Core.config->signer.tokens.auth_type.length() - 1] != ' ')
-            header += firebase_pgm_str_9; // " "
-
-        fbdo->tcpSend(header.c_str());
-        header.clear();
-
-        if (fbdo->session.response.code < 0)
-            return false;
-
-        fbdo->tcpSend(Core.internal.auth_token.c_str());
-
-        if (fbdo->session.response.code < 0)
-            return false;
-
-        Core.hh.addNewLine(header);
-    }
+    header += cache.common; // " HTTP/1.1\r\n", Host, User-Agent, custom headers and Authorization headers
 
     // Timestamp cannot use with ETag header, due to internal server error
     if (!hasServerValue && !hasQuery && req->data.type != d_timestamp &&
@@ -3337,7 +4440,14 @@ bool FB_RTDB::sendRequestHeader(FirebaseData *fbdo, struct firebase_rtdb_request
 
     Core.hh.addNewLine(header);
 
-    fbdo->tcpSend(header.c_str());
+    // The header and the payload in memory are sent in single gather write
+    esp_ssl_iovec_t iov[4];
+    iov[0].data = reinterpret_cast<const uint8_t *>(header.c_str());
+    iov[0].len = header.length();
+    size_t count = 1 + getPayloadBuffers(req, iov + 1);
+    req->payload_sent = count > 1;
+
+    fbdo->tcpWritev(iov, count);
     header.clear();
 
     if (fbdo->session.response.code < 0)
@@ -3346,6 +4456,106 @@ bool FB_RTDB::sendRequestHeader(FirebaseData *fbdo, struct firebase_rtdb_request
     return true;
 }
 
+size_t FB_RTDB::getPayloadBuffers(struct firebase_rtdb_request_info_t *req, esp_ssl_iovec_t *iov)
+{
+    const char *buf[3] = {nullptr, nullptr, nullptr};
+
+    if (req->data.address.din > 0 && req->data.type == d_json)
+    {
+        FirebaseJson *json = addrTo<FirebaseJson *>(req->data.address.din);
+        if (json)
+            buf[1] = json->raw();
+    }
+    else if (req->payload.length() > 0 || (req->data.type == d_array && req->data.address.din > 0))
+    {
+        buf[0] = req->pre_payload.c_str();
+
+        if (req->data.type == d_array && req->data.address.din > 0)
+        {
+            FirebaseJsonArray *arr = addrTo<FirebaseJsonArray *>(req->data.address.din);
+            if (arr)
+                buf[1] = arr->raw();
+        }
+        else
+            buf[1] = req->payload.c_str();
+
+        buf[2] = req->post_payload.c_str();
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < 3; i++)
+    {
+        if (buf[i] && strlen(buf[i]) > 0)
+        {
+            iov[count].data = reinterpret_cast<const uint8_t *>(buf[i]);
+            iov[count++].len = strlen(buf[i]);
+        }
+    }
+
+    return count;
+}
+
+void FB_RTDB::updateHeaderCache(FirebaseData *fbdo)
+{
+    struct firebase_rtdb_header_cache_t &cache = fbdo->session.rtdb.header_cache;
+    const MB_String &token = Core.internal.auth_token;
+    firebase_auth_token_type tokenType = Core.getTokenType();
+
+    if (cache.common.length() > 0 && cache.token_type == tokenType &&
+        cache.test_mode == Core.config->signer.test_mode &&
+        (!cache.has_token || cache.token_len == token.length()) &&
+        strcmp(cache.host.c_str(), Core.config->database_url.c_str()) == 0 &&
+        strcmp(cache.custom_headers.c_str(), Core.config->signer.customHeaders.c_str()) == 0)
+    {
+        if (!cache.has_token)
+            return;
+
+        // The token is at the end of auth query or before the last CRLF of common headers.
+        const char *p = tokenType == token_type_oauth2_access_token
+                            ? cache.common.c_str() + cache.common.length() - 2 - cache.token_len
+                            : cache.auth_query.c_str() + cache.auth_query.length() - cache.token_len;
+
+        if (memcmp(p, token.c_str(), cache.token_len) == 0)
+            return;
+    }
+
+    cache.token_type = tokenType;
+    cache.test_mode = Core.config->signer.test_mode;
+    cache.host = Core.config->database_url;
+    cache.custom_headers = Core.config->signer.customHeaders;
+    cache.has_token = false;
+    cache.token_len = 0;
+    cache.auth_param = false;
+
+    cache.auth_query = firebase_rtdb_pgm_str_18; // ".json"
+    if (tokenType != token_type_oauth2_access_token && !Core.config->signer.test_mode)
+    {
+        Core.uh.addParam(cache.auth_query, firebase_rtdb_pgm_str_19 /* "auth=" */, token, cache.auth_param, true);
+        cache.has_token = true;
+        cache.token_len = token.length();
+    }
+
+    cache.common.clear();
+    Core.hh.addRequestHeaderLast(cache.common);
+    Core.hh.addHostHeader(cache.common, Core.config->database_url.c_str());
+    Core.hh.addUAHeader(cache.common);
+    Core.hh.getCustomHeaders(&Core.sh, cache.common, Core.config->signer.customHeaders);
+
+    if (tokenType == token_type_oauth2_access_token)
+    {
+        Core.hh.addAuthHeaderFirst(cache.common, token_type_oauth2_access_token);
+
+        if (Core.config->signer.tokens.auth_type.length() > 0 &&
+            Core.config->signer.tokens.auth_type[Core.config->signer.tokens.auth_type.length() - 1] != ' ')
+            cache.common += firebase_pgm_str_9; // " "
+
+        cache.common += token;
+        cache.has_token = true;
+        cache.token_len = token.length();
+        Core.hh.addNewLine(cache.common);
+    }
+}
+
 void FB_RTDB::removeStreamCallback(FirebaseData *fbdo)
 {
     fbdo->setSession(true, false);
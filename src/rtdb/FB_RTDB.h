@@ -1909,6 +1909,21 @@ public:
                         _NO_ASYNC, _NO_QUEUE, _NO_BLOB_SIZE, toStringPtr(_NO_FILE));
   }
 
+  /** Read (get) the JSON at the defined node with the streaming reader.
+   * The response payload is parsed chunk by chunk while it is received and every element
+   * is reported to the reader callback as (path, type, value) event without buffering the whole payload.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param path The path to the node.
+   * @param reader The pointer to FirebaseJsonReader object that was set up with FirebaseJsonReader.begin().
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * @note The [FirebaseData object].to<FirebaseJson>() and [FirebaseData object].payload() will be empty.
+   * The operation failed with FIREBASE_ERROR_EXPECTED_JSON_DATA error when the payload is not a valid JSON.
+   */
+  template <typename T = const char *>
+  bool getJSON(FirebaseData *fbdo, T path, FirebaseJsonReader *reader) { return mGetJSON(fbdo, toStringPtr(path), reader); }
+
   /** Read (get) the array at the defined node.
    *
    * @param fbdo The pointer to Firebase Data Object.
@@ -2250,6 +2265,36 @@ public:
    */
   void removeMultiPathStreamCallback(FirebaseData *fbdo);
 
+  /** Add the child path to the multiple paths stream index with its own callback function.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param childPath The child path relative to the multiple paths stream parent path.
+   * @param childCallback The Callback function that accepts MultiPathStreamData parameter.
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * @note The stream event data will be parsed once and only the callbacks of the child paths
+   * which their data changed will be called.
+   *
+   * The child paths that were deleted by the put event at their parent path get the null value.
+   *
+   * The properties [MultiPathStreamData object].value, [MultiPathStreamData object].dataPath,
+   * [MultiPathStreamData object].type and [MultiPathStreamData object].eventType are already set
+   * when the child callback was called, no need to call [MultiPathStreamData object].get.
+   *
+   * setMultiPathStreamCallback should be called to run the stream, its multiPathDataCallback can be NULL.
+   */
+  template <typename T = const char *>
+  bool addMultiPathStreamChild(FirebaseData *fbdo, T childPath, FirebaseData::MultiPathStreamEventCallback childCallback)
+  {
+    return mAddMultiPathStreamChild(fbdo, toStringPtr(childPath), childCallback);
+  }
+
+  /** Remove all child paths and their callback functions from the multiple paths stream index.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   */
+  void removeMultiPathStreamChildren(FirebaseData *fbdo);
+
   /** Run stream manually.
    * To manually triggering the stream callback function, this should call repeatedly in loop().
    */
@@ -2301,17 +2346,151 @@ public:
    */
   void setMaxRetry(FirebaseData *fbdo, uint8_t num);
 
+  /** Set the callback function for the responses of pipelined async requests.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param callback The callback function that accept RTDB_AsyncResultInfo data.
+   *
+   * @note The pipelining is enabled by setting config.rtdb.async_pipeline_depth greater than 0.
+   * The async requests e.g. setAsync and pushAsync will be sent back-to-back on the same connection
+   * and their responses will be read in the same order as requests were sent.
+   * The async request fails with FIREBASE_ERROR_ASYNC_PIPELINE_FULL when the pipeline is full.
+   * The callback is called from Firebase.ready() and readAsyncResponses, not from inside other requests.
+   */
+  void setAsyncCallback(FirebaseData *fbdo, RTDB_AsyncResultCallback callback);
+
+  /** Read the available responses of pipelined async requests.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param wait Optional. Set to true to wait until all responses were read or timed out.
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * @note The responses are also read by Firebase.ready() and when the next request was sent,
+   * their results are passed to the callback by Firebase.ready() or this function.
+   */
+  bool readAsyncResponses(FirebaseData *fbdo, bool wait = false);
+
+  /** Get the number of pipelined async requests that wait for their responses.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @return The number of pending async requests.
+   */
+  size_t asyncPendingCount(FirebaseData *fbdo);
+
+  /** Begin the write batch at the defined node path.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param path The parent path of the child nodes to write.
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * @note The set functions (without priority and ETag) of the child nodes of this path will be kept in batch
+   * and sent as a single multi-path update request (updateNodeSilent) when commitBatch was called
+   * or the batch limits in config.rtdb.batch were reached.
+   * The later write to the same path replaces the pending write.
+   * The pending writes will be committed before any other request of this Firebase Data Object.
+   *
+   * The set function returns true when the write was kept (buffered) in batch, not when it was written.
+   * When the commit was failed, its writes are kept in batch and the commit is retried by the next
+   * write, commitBatch and Firebase.ready(), which return false until the commit was succeeded.
+   * The new write is not kept and returns false when the batch is full and still can't be committed.
+   * Firebase.ready() should be polled in the loop for config.rtdb.batch.max_delay_ms to take effect.
+   */
+  template <typename T = const char *>
+  bool beginBatch(FirebaseData *fbdo, T path) { return mBeginBatch(fbdo, toStringPtr(path)); }
+
+  /** Commit the pending writes of the write batch and end the batch.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * @note The writes are kept when the commit was failed, call commitBatch again to retry.
+   */
+  bool commitBatch(FirebaseData *fbdo);
+
+  /** Get the statistics of the write batch.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @return RTDB_BatchInfo The firebase_rtdb_batch_info_t structured data that provides
+   * the number of writes, deduplicated writes, commits, failures, saved requests and pending writes.
+   */
+  RTDB_BatchInfo batchInfo(FirebaseData *fbdo);
+
 #if defined(ENABLE_ERROR_QUEUE) || defined(FIREBASE_ENABLE_ERROR_QUEUE)
 
-  /** Set the maximum Firebase Error Queues in the collection (0 255).
+  /** Set the maximum Firebase Error Queues in the collection (0 65534).
    *
    * Firebase read/store operation causes by network problems and buffer overflow
    * will be added to Firebase Error Queues collection.
    *
+   * The memory for the queues is allocated when they are added, up to this number.
+   *
    * @param fbdo The pointer to Firebase Data Object.
    * @param num The maximum Firebase Error Queues.
    */
-  void setMaxErrorQueue(FirebaseData *fbdo, uint8_t num);
+  void setMaxErrorQueue(FirebaseData *fbdo, uint16_t num);
+
+  /** Set the priority class of the Firebase Error Queues added after this call.
+   *
+   * The queues in higher class are processed first e.g. the control writes ahead of the bulk telemetry,
+   * the queues in the same class are processed in order.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param priority The priority class, firebase_queue_priority_bulk, firebase_queue_priority_normal (default)
+   * or firebase_queue_priority_control.
+   */
+  void setErrorQueuePriority(FirebaseData *fbdo, firebase_queue_priority priority);
+
+  /** Set the processing mode of the Firebase Error Queues.
+   *
+   * In batch mode, the consecutive queues of set (without priority and ETag) and update of JSON
+   * are merged into the multi-path update requests, limited by config.rtdb.batch.max_writes and
+   * config.rtdb.batch.max_payload_size.
+   *
+   * The queues of the same or overlapped paths are always applied in order, the merge stops at the queue
+   * of other operation or overlapped path, and the queues after the failed queue of the same or parent path
+   * are held until the next processing.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param mode The processing mode, firebase_queue_drain_mode_sequential (default) or firebase_queue_drain_mode_batch.
+   */
+  void setErrorQueueDrainMode(FirebaseData *fbdo, firebase_queue_drain_mode mode);
+
+  /** Add the Firebase Data Object which its connection is also used to send the write requests
+   * of the Firebase Error Queues processing.
+   *
+   * The write requests are sent on the connections of the Firebase Data Object and the added objects in turn,
+   * the connection that failed is skipped until the next processing. The read (get) queues are
+   * always processed by the Firebase Data Object that holds the queues.
+   *
+   * @note This is not the parallel processing, the requests are sent one at a time and each request waits
+   * for its response before the next request is sent. The other connections keep the processing going
+   * when one connection failed, use the batch drain mode (setErrorQueueDrainMode) to reduce the number of requests.
+   * The object is removed automatically when either Firebase Data Object was destroyed.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param other The pointer to other Firebase Data Object, which should not be used for stream.
+   */
+  void addErrorQueueConnection(FirebaseData *fbdo, FirebaseData *other);
+
+  /** Remove the Firebase Data Object that was added by addErrorQueueConnection.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param other The pointer to other Firebase Data Object to remove.
+   */
+  void removeErrorQueueConnection(FirebaseData *fbdo, FirebaseData *other);
+
+  /** Get the statistics of the Firebase Error Queues processing.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @return RTDB_QueueDrainInfo The statistics e.g. the number of sent queues and requests and the throughput.
+   */
+  RTDB_QueueDrainInfo errorQueueDrainInfo(FirebaseData *fbdo);
+
+  /** Reset the statistics of the Firebase Error Queues processing.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   */
+  void resetErrorQueueDrainInfo(FirebaseData *fbdo);
 
   /** Save Firebase Error Queues as file in flash memory (save only database store queues).
    *
@@ -2355,20 +2534,43 @@ public:
    * @param fbdo The pointer to Firebase Data Object.
    * @param filename Filename to be read and count for queues.
    * @param storageType The enum of memory storage type e.g. mem_storage_type_flash and mem_storage_type_sd. The file systems can be changed in FirebaseFS.h.
-   * @return Number (0-255) of queues store in defined queue file.
+   * @return Number of queues store in defined queue file.
    */
   template <typename T = const char *>
-  uint8_t errorQueueCount(FirebaseData *fbdo, T filename, firebase_mem_storage_type storageType)
+  uint16_t errorQueueCount(FirebaseData *fbdo, T filename, firebase_mem_storage_type storageType)
   {
     return mErrorQueueCount(fbdo, toStringPtr(filename), storageType);
   }
 
+  /** Keep the Firebase Error Queues in an append-only journal file.
+   *
+   * The queues found in the journal file (e.g. left from the power loss) are restored to the collection.
+   * Then every added and completed queue is appended to the file as one small record, the file
+   * is compacted when the completed records outnumber the pending ones.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param filename The journal file name.
+   * @param storageType The enum of memory storage type e.g. mem_storage_type_flash and mem_storage_type_sd. The file systems can be changed in FirebaseFS.h.
+   * @return Boolean value, indicates the success of the operation.
+   */
+  template <typename T = const char *>
+  bool beginErrorQueueJournal(FirebaseData *fbdo, T filename, firebase_mem_storage_type storageType)
+  {
+    return mBeginErrorQueueJournal(fbdo, toStringPtr(filename), storageType);
+  }
+
+  /** Stop writing the Firebase Error Queues to the journal file.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   */
+  void endErrorQueueJournal(FirebaseData *fbdo);
+
   /** Determine number of queues in Firebase Data object's Error Queues collection.
    *
    * @param fbdo The pointer to Firebase Data Object.
-   * @return Number (0-255) of queues in Firebase Data object's error queue collection.
+   * @return Number of queues in Firebase Data object's error queue collection.
    */
-  uint8_t errorQueueCount(FirebaseData *fbdo);
+  uint16_t errorQueueCount(FirebaseData *fbdo);
 
   /** Determine whether the Firebase Error Queues collection was full or not.
    *
@@ -2440,6 +2642,8 @@ public:
   void endAutoRunErrorQueue(FirebaseData *fbdo);
 
   /** Clear all Firbase Error Queues in Error Queue collection.
+   *
+   * The statistics of the Error Queues processing are also reset.
    *
    * @param fbdo The pointer to Firebase Data Object.
    */
@@ -2495,6 +2699,16 @@ public:
     return dataPushHandler(fbdo, path, fileName, storageType, true);
   }
 
+  /** Set (put) the value at the defined node.
+   *
+   * @param fbdo The pointer to Firebase Data Object.
+   * @param path The path to the node which value will be set.
+   * @param value The value to set.
+   * @return Boolean value, indicates the success of the operation.
+   *
+   * @note When the write batch was begun by beginBatch, true means the value was kept (buffered) in batch
+   * and not yet written to the database, see beginBatch.
+   */
   template <typename T1 = const char *, typename T2>
   bool set(FirebaseData *fbdo, T1 path, T2 value)
   {
@@ -2595,18 +2809,37 @@ private:
   void rescon(FirebaseData *fbdo, const char *host, firebase_rtdb_request_info_t *req);
   void clearDataStatus(FirebaseData *fbdo);
   bool handleRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req);
+  bool mHandleRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req);
+  void updateHeaderCache(FirebaseData *fbdo);
+  size_t getPayloadBuffers(struct firebase_rtdb_request_info_t *req, esp_ssl_iovec_t *iov);
   bool sendRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req);
   int preRequestCheck(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req);
   firebase_request_method getHTTPMethod(firebase_rtdb_request_info_t *req);
+  firebase_bssl_buffer_profile getBufferProfile(struct firebase_rtdb_request_info_t *req);
   bool hasPayload(struct firebase_rtdb_request_info_t *req);
   bool sendRequestHeader(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req);
   int getPayloadLen(firebase_rtdb_request_info_t *req);
   bool waitResponse(FirebaseData *fbdo, firebase_rtdb_request_info_t *req);
   bool handleResponse(FirebaseData *fbdo, firebase_rtdb_request_info_t *req);
+  void addAsyncRequest(FirebaseData *fbdo, firebase_rtdb_request_info_t *req);
+  bool readPipelinedResponses(FirebaseData *fbdo, bool wait);
+  void deliverAsyncResults(FirebaseData *fbdo);
+  void completeAsyncRequest(FirebaseData *fbdo, int code);
+  void abortAsyncRequests(FirebaseData *fbdo, int code);
+  bool mBeginBatch(FirebaseData *fbdo, MB_StringPtr path);
+  bool addBatch(FirebaseData *fbdo, firebase_request_method method, MB_StringPtr path, MB_StringPtr payload,
+                firebase_data_type type, uint32_t value_addr, uint32_t priority_addr, MB_StringPtr etag, bool queue);
+  bool isBatchFull(FirebaseData *fbdo, bool checkDelay);
+  bool flushBatch(FirebaseData *fbdo);
+  void flushDueBatches();
+  void readDueAsyncResponses();
+  void makeNodePath(MB_String &path);
+  bool makeBatchValue(firebase_data_type type, uint32_t value_addr, MB_StringPtr payload, MB_String &value);
+  void makeBatchPayload(MB_VECTOR<struct firebase_rtdb_batch_item_t> &items, size_t ofs, MB_String &payload);
   int openFile(FirebaseData *fbdo, firebase_rtdb_request_info_t *req, mb_fs_open_mode mode, bool closeSession = false);
   void waitRxReady(FirebaseData *fbdo, unsigned long &dataTime);
   void parsePayload(FirebaseData *fbdo, firebase_rtdb_request_info_t *req, struct server_response_data_t &response,
-                    MB_String payload);
+                    MB_String &payload);
   void handlePayload(FirebaseData *fbdo, struct server_response_data_t &response, const MB_String &payload);
   bool processRequest(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req);
   bool encodeFileToClient(FirebaseData *fbdo, size_t bufSize, const MB_String &filePath,
@@ -2627,14 +2860,18 @@ private:
   bool mDeleteNodesByTimestamp(FirebaseData *fbdo, MB_StringPtr path, MB_StringPtr timestampNode,
                                MB_StringPtr limit, MB_StringPtr dataRetentionPeriod);
   bool mBeginMultiPathStream(FirebaseData *fbdo, MB_StringPtr parentPath);
+  bool mGetJSON(FirebaseData *fbdo, MB_StringPtr path, FirebaseJsonReader *reader);
+  bool mAddMultiPathStreamChild(FirebaseData *fbdo, MB_StringPtr childPath,
+                                FirebaseData::MultiPathStreamEventCallback childCallback);
   bool mBackup(FirebaseData *fbdo, firebase_mem_storage_type storageType, MB_StringPtr nodePath,
                MB_StringPtr fileName, RTDB_DownloadProgressCallback callback = NULL);
   bool mRestore(FirebaseData *fbdo, firebase_mem_storage_type storageType, MB_StringPtr nodePath,
                 MB_StringPtr fileName, RTDB_UploadProgressCallback callback = NULL);
-  uint8_t mErrorQueueCount(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType);
+  uint16_t mErrorQueueCount(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType);
   bool mRestoreErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType);
   bool mDeleteStorageFile(MB_StringPtr filename, firebase_mem_storage_type storageType);
   bool mSaveErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType);
+  bool mBeginErrorQueueJournal(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType);
   void setBlobRef(FirebaseData *fbdo, int addr);
   void mSetwriteSizeLimit(FirebaseData *fbdo, MB_StringPtr size);
   bool mGetRules(FirebaseData *fbdo, firebase_mem_storage_type storageType, MB_StringPtr filename,
@@ -2658,8 +2895,11 @@ private:
   int handleRedirect(FirebaseData *fbdo, firebase_rtdb_request_info_t *req, struct firebase_tcp_response_handler_t &tcpHandler,
                      struct server_response_data_t &response);
   void sendCB(FirebaseData *fbdo);
-  void splitStreamPayload(const MB_String &payloads, MB_VECTOR<MB_String> &payload);
-  void parseStreamPayload(FirebaseData *fbdo, const MB_String &payload);
+  int findMultiPathNode(FirebaseData *fbdo, int parent, const char *key, size_t len);
+  void dispatchMultiPathStream(FirebaseData *fbdo, FIREBASE_MP_STREAM_CLASS &s, MB_JSON *root);
+  void dispatchMultiPathJson(FirebaseData *fbdo, FIREBASE_MP_STREAM_CLASS &s, int parent, MB_JSON *item, bool replace);
+  void callMultiPathChild(FirebaseData *fbdo, FIREBASE_MP_STREAM_CLASS &s, int node, MB_JSON *item);
+  void parseStreamPayload(FirebaseData *fbdo, const MB_String &payload, int begin, int end);
   void storeToken(MB_String &atok, const char *databaseSecret);
   void restoreToken(MB_String &atok, firebase_auth_token_type tk);
   bool mSetQueryIndex(FirebaseData *fbdo, MB_StringPtr path, MB_StringPtr node, MB_StringPtr databaseSecret);
@@ -2682,17 +2922,21 @@ private:
 #if defined(ENABLE_ERROR_QUEUE) || defined(FIREBASE_ENABLE_ERROR_QUEUE)
 
   void addQueueData(FirebaseData *fbdo, struct firebase_rtdb_request_info_t *req);
+  bool sendQueueItem(FirebaseData *fbdo, QueueItem *item);
+  bool addQueueDrainItem(QueueItem *item, MB_VECTOR<struct firebase_rtdb_batch_item_t> &items);
+  bool sendQueueDrainBatch(FirebaseData *fbdo, MB_VECTOR<struct firebase_rtdb_batch_item_t> &items);
+  bool isQueuePathOverlapped(const MB_String &a, const MB_String &b);
 
 #if defined(ESP8266)
   void runErrorQueueTask();
 #endif
 
-  uint8_t openErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType, uint8_t mode);
+  uint16_t openErrorQueue(FirebaseData *fbdo, MB_StringPtr filename, firebase_mem_storage_type storageType, uint8_t mode);
 #if (defined(MBFS_FLASH_FS) || defined(MBFS_SD_FS)) && (defined(ESP32) || defined(ESP8266) || defined(MB_ARDUINO_PICO))
-  uint8_t readQueueFile(FirebaseData *fbdo, fs::File &file, QueueItem &item, uint8_t mode);
+  uint16_t readQueueFile(FirebaseData *fbdo, fs::File &file, QueueItem &item, uint8_t mode);
 #endif
 #if defined(MBFS_ESP32_SDFAT_ENABLED)
-  uint8_t readQueueFileSdFat(FirebaseData *fbdo, MBFS_SD_FILE &file, QueueItem &item, uint8_t mode);
+  uint16_t readQueueFileSdFat(FirebaseData *fbdo, MBFS_SD_FILE &file, QueueItem &item, uint8_t mode);
 #endif
 
 #endif
@@ -39,6 +39,44 @@
 #include "./FB_Utils.h"
 #include "QueryFilter.h"
 
+// The priority classes of the Firebase Error Queues, the queues in higher class are processed first.
+typedef enum
+{
+    firebase_queue_priority_bulk,
+    firebase_queue_priority_normal,
+    firebase_queue_priority_control
+} firebase_queue_priority;
+
+#define FIREBASE_QUEUE_PRIORITY_CLASSES 3
+
+// The modes of Firebase Error Queues processing.
+typedef enum
+{
+    // The queues are sent one request per queue.
+    firebase_queue_drain_mode_sequential,
+    // The consecutive set and update queues are merged into the multi-path update requests.
+    firebase_queue_drain_mode_batch
+} firebase_queue_drain_mode;
+
+typedef struct firebase_queue_drain_info_t
+{
+    // The number of queues that were sent and removed.
+    uint32_t items = 0;
+    // The number of requests that were sent.
+    uint32_t requests = 0;
+    // The number of requests that were failed.
+    uint32_t failures = 0;
+    // The number of queues that were held back because the earlier queue of the same or parent path was failed.
+    uint32_t deferred = 0;
+    // The time in ms that was spent on processing the queues.
+    uint32_t elapsed_ms = 0;
+    // The number of queues that were sent per second.
+    float items_per_sec = 0;
+    // The number of queues that are waiting to be processed.
+    uint16_t pending = 0;
+
+} RTDB_QueueDrainInfo;
+
 struct QueueItem
 {
     firebase_data_type dataType = firebase_data_type::d_any;
@@ -60,6 +98,7 @@ struct QueueItem
     struct firebase_rtdb_address_t address;
     int blobSize = 0;
     bool async = false;
+    uint8_t queuePriority = firebase_queue_priority_normal;
 };
 
 class QueueInfo
@@ -69,7 +108,7 @@ class QueueInfo
 public:
     QueueInfo();
     ~QueueInfo();
-    uint8_t totalQueues();
+    uint16_t totalQueues();
     uint32_t currentQueueID();
     bool isQueueFull();
     String dataType();
@@ -78,7 +117,7 @@ public:
 
 private:
     void clear();
-    uint8_t _totalQueue = 0;
+    uint16_t _totalQueue = 0;
     uint32_t _currentQueueID = 0;
     bool _isQueueFull = false;
     bool _isQueue = false;
@@ -36,67 +36,627 @@
 
 #include "QueueManager.h"
 
+#define FIREBASE_QUEUE_FILE_HEADER_SIZE 5
+#define FIREBASE_QUEUE_RECORD_HEADER_SIZE 9
+#define FIREBASE_QUEUE_RECORD_ITEM_SIZE 42
+#define FIREBASE_QUEUE_RECORD_ITEM_FIXED_SIZE 25
+
+static const uint8_t fb_queue_file_header[FIREBASE_QUEUE_FILE_HEADER_SIZE] = {'F', 'B', 'Q', 'J', 1};
+
+static uint8_t *fb_queue_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+    p[3] = (v >> 24) & 0xff;
+    return p + 4;
+}
+
+static uint32_t fb_queue_get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t *fb_queue_put_string(uint8_t *p, const MB_String &s)
+{
+    p = fb_queue_put32(p, s.length());
+    memcpy(p, s.c_str(), s.length());
+    return p + s.length();
+}
+
+static bool fb_queue_get_string(const uint8_t *&p, const uint8_t *end, MB_String &s)
+{
+    if (end - p < 4)
+        return false;
+
+    uint32_t len = fb_queue_get32(p);
+    p += 4;
+
+    if ((uint32_t)(end - p) < len)
+        return false;
+
+    s.clear();
+    if (len > 0)
+        s.append((const char *)p, len);
+    p += len;
+    return true;
+}
+
+static bool fb_queue_write_record(MB_FS *mbfs, mbfs_file_type type, uint8_t recordType, uint32_t id, const QueueItem *item,
+                                  uint32_t generation = 0)
+{
+    size_t len = FIREBASE_QUEUE_RECORD_HEADER_SIZE + 2;
+    if (item)
+        len += FIREBASE_QUEUE_RECORD_ITEM_SIZE + item->path.length() + item->payload.length() +
+               item->etag.length() + item->filename.length();
+    else if (recordType == 'C')
+        len += 4;
+
+    uint8_t *buf = reinterpret_cast<uint8_t *>(mbfs->newP(len));
+    if (!buf)
+        return false;
+
+    uint8_t *p = buf + FIREBASE_QUEUE_RECORD_HEADER_SIZE;
+
+    if (item)
+    {
+        *p++ = (uint8_t)item->dataType;
+        *p++ = (uint8_t)item->subType;
+        *p++ = (uint8_t)item->method;
+        *p++ = (uint8_t)item->storageType;
+        *p++ = (uint8_t)item->async;
+        p = fb_queue_put32(p, item->address.din);
+        p = fb_queue_put32(p, item->address.dout);
+        p = fb_queue_put32(p, item->address.query);
+        p = fb_queue_put32(p, item->address.priority);
+        p = fb_queue_put32(p, item->blobSize);
+        p = fb_queue_put_string(p, item->path);
+        p = fb_queue_put_string(p, item->payload);
+        p = fb_queue_put_string(p, item->etag);
+        p = fb_queue_put_string(p, item->filename);
+        *p++ = item->queuePriority;
+    }
+    else if (recordType == 'C')
+        p = fb_queue_put32(p, generation);
+
+    buf[0] = recordType;
+    fb_queue_put32(buf + 1, id);
+    fb_queue_put32(buf + 5, p - buf - FIREBASE_QUEUE_RECORD_HEADER_SIZE);
+
+    uint16_t sum = FBUtils::fletcher16(buf, p - buf);
+    *p++ = sum & 0xff;
+    *p++ = sum >> 8;
+
+    bool ret = mbfs->write(type, buf, len) == (int)len;
+    mbfs->delP(&buf);
+    return ret;
+}
+
+static bool fb_queue_read_item(const uint8_t *p, const uint8_t *end, QueueItem &item)
+{
+    if (end - p < FIREBASE_QUEUE_RECORD_ITEM_FIXED_SIZE)
+        return false;
+
+    item.dataType = (firebase_data_type)p[0];
+    item.subType = p[1];
+    item.method = (firebase_request_method)p[2];
+    item.storageType = (firebase_mem_storage_type)p[3];
+    item.async = p[4] > 0;
+    item.address.din = fb_queue_get32(p + 5);
+    item.address.dout = fb_queue_get32(p + 9);
+    item.address.query = fb_queue_get32(p + 13);
+    item.address.priority = fb_queue_get32(p + 17);
+    item.blobSize = fb_queue_get32(p + 21);
+    p += FIREBASE_QUEUE_RECORD_ITEM_FIXED_SIZE;
+
+    if (!fb_queue_get_string(p, end, item.path) || !fb_queue_get_string(p, end, item.payload) ||
+        !fb_queue_get_string(p, end, item.etag) || !fb_queue_get_string(p, end, item.filename))
+        return false;
+
+    // The priority class was added later, the records without it are in normal class.
+    item.queuePriority = p < end && *p < FIREBASE_QUEUE_PRIORITY_CLASSES ? *p : (uint8_t)firebase_queue_priority_normal;
+    return true;
+}
+
 QueueManager::QueueManager()
 {
+    for (uint8_t i = 0; i < FIREBASE_QUEUE_PRIORITY_CLASSES; i++)
+        _head[i] = _tail[i] = FIREBASE_QUEUE_SLOT_NONE;
 }
+
 QueueManager::~QueueManager()
 {
-    clear();
-    if (_queueCollection)
-        delete _queueCollection;
-    _queueCollection = nullptr;
+    release();
+}
+
+void QueueManager::release()
+{
+    if (_slots)
+        delete[] _slots;
+    _slots = nullptr;
+    _capacity = 0;
+    _count = 0;
+    _free = FIREBASE_QUEUE_SLOT_NONE;
+    for (uint8_t i = 0; i < FIREBASE_QUEUE_PRIORITY_CLASSES; i++)
+        _head[i] = _tail[i] = FIREBASE_QUEUE_SLOT_NONE;
 }
 
 void QueueManager::clear()
 {
-    if (_queueCollection)
+    for (uint16_t i = 0; i < _capacity; i++)
     {
-        for (uint8_t i = 0; i < _queueCollection->size(); i++)
+        if (_slots[i].used)
         {
-#if defined(MB_USE_STD_VECTOR)
-            QueueItem item = _queueCollection->at(i);
-#else
-            QueueItem item = (*_queueCollection)[i];
-#endif
-
-            item.path.clear();
-            item.filename.clear();
-            item.payload.clear();
-            item.address.dout = 0;
-            item.address.din = 0;
-            item.blobSize = 0;
-            item.address.priority=0;
-            item.address.query = 0;
+            _slots[i].item = QueueItem();
+            _slots[i].used = false;
         }
+        _slots[i].prev = FIREBASE_QUEUE_SLOT_NONE;
+        _slots[i].next = i + 1 < _capacity ? i + 1 : FIREBASE_QUEUE_SLOT_NONE;
     }
+
+    _count = 0;
+    _free = _capacity > 0 ? 0 : FIREBASE_QUEUE_SLOT_NONE;
+    for (uint8_t i = 0; i < FIREBASE_QUEUE_PRIORITY_CLASSES; i++)
+        _head[i] = _tail[i] = FIREBASE_QUEUE_SLOT_NONE;
+
+    if (_mbfs)
+        compactJournal();
 }
 
-bool QueueManager::add(struct QueueItem q)
+bool QueueManager::grow()
 {
-    if (!_queueCollection)
-        _queueCollection = new MB_VECTOR<QueueItem>();
+    uint32_t cap = _capacity < 4 ? 4 : (uint32_t)_capacity * 2;
+    if (cap > _maxQueue)
+        cap = _maxQueue;
+    if (cap >= FIREBASE_QUEUE_SLOT_NONE)
+        cap = FIREBASE_QUEUE_SLOT_NONE - 1;
+
+    if (cap <= _capacity)
+        return false;
+
+    firebase_queue_slot_t *slots = new firebase_queue_slot_t[cap];
+    if (!slots)
+        return false;
+
+    // Items keep their slot indexes (and queue IDs), the new slots are put to the free list.
+    for (uint16_t i = 0; i < _capacity; i++)
+        slots[i] = _slots[i];
+
+    for (uint16_t i = _capacity; i < cap; i++)
+        slots[i].next = i + 1 < cap ? i + 1 : _free;
+
+    _free = _capacity;
+
+    if (_slots)
+        delete[] _slots;
+    _slots = slots;
+    _capacity = cap;
+    return true;
+}
+
+int QueueManager::slotOf(uint32_t id)
+{
+    uint16_t slot = id & 0xFFFF;
+    if (id == 0 || slot >= _capacity || !_slots[slot].used || _slots[slot].generation != (id >> 16))
+        return -1;
+    return slot;
+}
 
-    if (_queueCollection->size() < _maxQueue)
+bool QueueManager::add(struct QueueItem &q)
+{
+    if (_count >= _maxQueue || (_free == FIREBASE_QUEUE_SLOT_NONE && (_draining || !grow())))
+        return false;
+
+    uint16_t slot = _free;
+    firebase_queue_slot_t &s = _slots[slot];
+    _free = s.next;
+
+    if (q.queuePriority >= FIREBASE_QUEUE_PRIORITY_CLASSES)
+        q.queuePriority = FIREBASE_QUEUE_PRIORITY_CLASSES - 1;
+
+    // generation 0 is reserved, the queue ID is never 0.
+    if (++s.generation == 0)
+        s.generation = 1;
+
+    q.qID = idOf(slot);
+    s.item = q;
+    s.used = true;
+
+    uint8_t c = q.queuePriority;
+    s.prev = _tail[c];
+    s.next = FIREBASE_QUEUE_SLOT_NONE;
+    if (_tail[c] != FIREBASE_QUEUE_SLOT_NONE)
+        _slots[_tail[c]].next = slot;
+    else
+        _head[c] = slot;
+    _tail[c] = slot;
+    _count++;
+
+    appendJournal('A', s.item);
+    return true;
+}
+
+void QueueManager::remove(uint8_t index)
+{
+    uint32_t id = first();
+    for (; id > 0 && index > 0; index--)
+        id = next(id);
+
+    if (id > 0)
+        removeById(id);
+}
+
+bool QueueManager::removeById(uint32_t id)
+{
+    int slot = slotOf(id);
+    if (slot < 0)
+        return false;
+
+    firebase_queue_slot_t &s = _slots[slot];
+    uint8_t c = s.item.queuePriority;
+
+    if (s.prev != FIREBASE_QUEUE_SLOT_NONE)
+        _slots[s.prev].next = s.next;
+    else
+        _head[c] = s.next;
+
+    if (s.next != FIREBASE_QUEUE_SLOT_NONE)
+        _slots[s.next].prev = s.prev;
+    else
+        _tail[c] = s.prev;
+
+    s.item = QueueItem();
+    s.item.qID = id;
+    s.used = false;
+    s.prev = FIREBASE_QUEUE_SLOT_NONE;
+    s.next = _free;
+    _free = slot;
+    _count--;
+
+    appendJournal('D', s.item);
+    return true;
+}
+
+QueueItem *QueueManager::get(uint32_t id)
+{
+    int slot = slotOf(id);
+    return slot < 0 ? nullptr : &_slots[slot].item;
+}
+
+uint32_t QueueManager::first()
+{
+    for (int c = FIREBASE_QUEUE_PRIORITY_CLASSES - 1; c >= 0; c--)
     {
-        _queueCollection->push_back(q);
-        return true;
+        if (_head[c] != FIREBASE_QUEUE_SLOT_NONE)
+            return idOf(_head[c]);
     }
-    return false;
+    return 0;
 }
 
-void QueueManager::remove(uint8_t index)
+uint32_t QueueManager::next(uint32_t id)
 {
-    if (_queueCollection)
-        _queueCollection->erase(_queueCollection->begin() + index);
+    int slot = slotOf(id);
+    if (slot < 0)
+        return 0;
+
+    if (_slots[slot].next != FIREBASE_QUEUE_SLOT_NONE)
+        return idOf(_slots[slot].next);
+
+    for (int c = _slots[slot].item.queuePriority - 1; c >= 0; c--)
+    {
+        if (_head[c] != FIREBASE_QUEUE_SLOT_NONE)
+            return idOf(_head[c]);
+    }
+    return 0;
+}
+
+void QueueManager::setMax(uint16_t num)
+{
+    if (num >= FIREBASE_QUEUE_SLOT_NONE)
+        num = FIREBASE_QUEUE_SLOT_NONE - 1;
+
+    _maxQueue = num;
+
+    // Drop the newest items of the lowest priority classes first.
+    for (uint8_t c = 0; c < FIREBASE_QUEUE_PRIORITY_CLASSES && _count > _maxQueue; c++)
+    {
+        while (_count > _maxQueue && _tail[c] != FIREBASE_QUEUE_SLOT_NONE)
+            removeById(idOf(_tail[c]));
+    }
 }
 
 size_t QueueManager::size()
 {
-    if (_queueCollection)
-        return _queueCollection->size();
+    return _count;
+}
+
+int QueueManager::saveFile(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type, QueueManager *queue)
+{
+    int ret = mbfs->open(filename, type, mb_fs_open_mode_write);
+    if (ret < 0)
+        return ret;
+
+    size_t count = 0;
+    bool ok = mbfs->write(type, (uint8_t *)fb_queue_file_header, FIREBASE_QUEUE_FILE_HEADER_SIZE) == FIREBASE_QUEUE_FILE_HEADER_SIZE;
+
+    // In processing order, the order of items in each priority class is kept when they are restored.
+    for (uint32_t id = queue->first(); ok && id > 0; id = queue->next(id), count++)
+        ok = fb_queue_write_record(mbfs, type, 'A', id, queue->get(id));
+
+    // The commit marker tells the recovery that the snapshot was written completely.
+    if (ok)
+        ok = fb_queue_write_record(mbfs, type, 'C', count, nullptr, queue->_journalGeneration);
+
+    mbfs->close(type);
+
+    return ok ? 0 : MB_FS_ERROR_FILE_IO_ERROR;
+}
+
+int QueueManager::loadFile(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type, MB_VECTOR<struct QueueItem> &items,
+                           bool *committed, uint32_t *generation)
+{
+    if (committed)
+        *committed = false;
+
+    int ret = mbfs->open(filename, type, mb_fs_open_mode_read);
+    if (ret < 0)
+        return ret;
+
+    uint8_t header[FIREBASE_QUEUE_RECORD_HEADER_SIZE];
+    int records = mbfs->read(type, header, FIREBASE_QUEUE_FILE_HEADER_SIZE);
+
+    if (records == FIREBASE_QUEUE_FILE_HEADER_SIZE && memcmp(header, fb_queue_file_header, FIREBASE_QUEUE_FILE_HEADER_SIZE) == 0)
+        records = 0;
+    else
+        records = records > 0 ? -1 : 0;
+
+    // Stop at the first incomplete or corrupted record, the rest of the file is a torn write.
+    while (records >= 0 && mbfs->available(type) >= FIREBASE_QUEUE_RECORD_HEADER_SIZE + 2)
+    {
+        FBUtils::idle();
+
+        if (mbfs->read(type, header, FIREBASE_QUEUE_RECORD_HEADER_SIZE) != FIREBASE_QUEUE_RECORD_HEADER_SIZE)
+            break;
+
+        uint32_t bodyLen = fb_queue_get32(header + 5);
+        if ((uint32_t)mbfs->available(type) < bodyLen + 2)
+            break;
+
+        size_t len = FIREBASE_QUEUE_RECORD_HEADER_SIZE + bodyLen;
+        uint8_t *buf = reinterpret_cast<uint8_t *>(mbfs->newP(len + 2));
+        if (!buf)
+            break;
+
+        memcpy(buf, header, FIREBASE_QUEUE_RECORD_HEADER_SIZE);
+
+        bool ok = mbfs->read(type, buf + FIREBASE_QUEUE_RECORD_HEADER_SIZE, bodyLen + 2) == (int)(bodyLen + 2) &&
+                  FBUtils::fletcher16(buf, len) == (buf[len] | (buf[len + 1] << 8));
+
+        uint32_t id = fb_queue_get32(buf + 1);
+
+        if (ok && buf[0] == 'A')
+        {
+            QueueItem item;
+            ok = fb_queue_read_item(buf + FIREBASE_QUEUE_RECORD_HEADER_SIZE, buf + len, item);
+            item.qID = id;
+
+            size_t i = 0;
+            while (ok && i < items.size() && items.at(i).qID != id)
+                i++;
+
+            if (ok && i < items.size())
+                items.erase(items.begin() + i);
+
+            if (ok)
+                items.push_back(item);
+        }
+        else if (ok && buf[0] == 'D')
+        {
+            for (size_t i = 0; i < items.size(); i++)
+            {
+                if (items.at(i).qID == id)
+                {
+                    items.erase(items.begin() + i);
+                    break;
+                }
+            }
+        }
+        else if (ok && buf[0] == 'C')
+        {
+            if (committed)
+                *committed = true;
+
+            // The commit marker without generation was written before the generation was added.
+            if (generation)
+                *generation = bodyLen >= 4 ? fb_queue_get32(buf + FIREBASE_QUEUE_RECORD_HEADER_SIZE) : 0;
+        }
+        else
+            ok = false;
+
+        mbfs->delP(&buf);
+
+        if (!ok)
+            break;
+
+        records++;
+    }
+
+    mbfs->close(type);
+
+    return records;
+}
+
+int QueueManager::beginJournal(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type)
+{
+    endJournal();
+
+    if (!mbfs->checkStorageReady(type))
+        return type == mbfs_sd ? MB_FS_ERROR_SD_STORAGE_IS_NOT_READY : MB_FS_ERROR_FLASH_STORAGE_IS_NOT_READY;
+
+    MB_String tmp = filename;
+    tmp += ".tmp";
+
+    MB_VECTOR<struct QueueItem> items;
+    bool committed = false;
+    uint32_t generation = 0;
+
+    // The complete snapshot left by an interrupted compaction wins over the partially rewritten journal,
+    // the journal of the same or newer generation (the snapshot was rewritten but the temp file was not removed)
+    // also has the records that were appended later.
+    if (mbfs->existed(tmp, type) && loadFile(mbfs, tmp, type, items, &committed, &generation) >= 0 && committed)
+    {
+        MB_VECTOR<struct QueueItem> journal;
+        uint32_t journalGeneration = 0;
+        committed = false;
+
+        if (mbfs->existed(filename, type) && loadFile(mbfs, filename, type, journal, &committed, &journalGeneration) >= 0 &&
+            committed && journalGeneration >= generation)
+        {
+            items = journal;
+            generation = journalGeneration;
+        }
+    }
+    else
+    {
+        items.clear();
+        generation = 0;
+
+        if (mbfs->existed(filename, type))
+        {
+            int ret = loadFile(mbfs, filename, type, items, nullptr, &generation);
+
+            // Do not overwrite the queue file saved in other format.
+            if (ret < 0)
+                return ret == -1 ? MB_FS_ERROR_FILE_IO_ERROR : ret;
+        }
+    }
+
+    // The items get new queue IDs, the journal is rewritten with them below.
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        QueueItem *item = get(items.at(i).qID);
+        if (!item || item->path != items.at(i).path || item->payload != items.at(i).payload)
+            add(items.at(i));
+    }
+
+    _mbfs = mbfs;
+    _journalFile = filename;
+    _journalType = type;
+    _journalGeneration = generation;
+
+    if (!compactJournal())
+    {
+        endJournal();
+        return MB_FS_ERROR_FILE_IO_ERROR;
+    }
+
     return 0;
 }
 
+void QueueManager::endJournal()
+{
+    flushJournal();
+    _mbfs = nullptr;
+    _journalFile.clear();
+    _journalType = mbfs_undefined;
+    _journalRecords = 0;
+    _journalGeneration = 0;
+}
+
+bool QueueManager::appendJournal(uint8_t recordType, const struct QueueItem &item)
+{
+    if (!_mbfs)
+        return false;
+
+    // The tombstones are appended together when the drain ends, the removed items are only sent again
+    // when the device was reset before that.
+    if (_draining && recordType == 'D')
+    {
+        _journalPending.push_back(item.qID);
+        return true;
+    }
+
+    return writeJournal(recordType, recordType == 'A' ? &item : nullptr, item.qID);
+}
+
+bool QueueManager::flushJournal()
+{
+    if (!_mbfs || _journalPending.size() == 0)
+        return true;
+
+    return writeJournal('D', nullptr, 0);
+}
+
+bool QueueManager::writeJournal(uint8_t recordType, const struct QueueItem *item, uint32_t id)
+{
+    // The pending tombstones and the record are appended with one file open.
+    bool ret = _mbfs->open(_journalFile, _journalType, mb_fs_open_mode_append) == 0;
+
+    if (ret)
+    {
+        for (size_t i = 0; ret && i < _journalPending.size(); i++, _journalRecords++)
+            ret = fb_queue_write_record(_mbfs, _journalType, 'D', _journalPending[i], nullptr);
+
+        if (ret && id > 0)
+        {
+            ret = fb_queue_write_record(_mbfs, _journalType, recordType, id, item);
+            _journalRecords++;
+        }
+
+        _mbfs->close(_journalType);
+    }
+
+    _journalPending.clear();
+
+    // The commit record and the live items are the only records needed, rewrite once the dead ones dominate.
+    size_t dead = _journalRecords > size() + 1 ? _journalRecords - size() - 1 : 0;
+
+    // A failed append may leave a torn record, rewrite the journal so the next appends stay readable.
+    if (!ret || (dead >= FIREBASE_QUEUE_JOURNAL_COMPACT_THRESHOLD && dead > size()))
+        return compactJournal() && ret;
+
+    return ret;
+}
+
+bool QueueManager::compactJournal()
+{
+    if (!_mbfs)
+        return false;
+
+    MB_String tmp = _journalFile;
+    tmp += ".tmp";
+
+    // The snapshot and the records appended to it are newer than any earlier snapshot left in temp file.
+    _journalGeneration++;
+
+    if (saveFile(_mbfs, tmp, _journalType, this) < 0)
+        return false;
+
+    // The complete snapshot replaces the journal, the journal is rewritten when the temp file can't be renamed.
+    if (!_mbfs->rename(tmp, _journalFile, _journalType))
+    {
+        if (saveFile(_mbfs, _journalFile, _journalType, this) < 0)
+            return false;
+        _mbfs->remove(tmp, _journalType);
+    }
+
+    _journalPending.clear();
+    _journalRecords = size() + 1;
+
+    return true;
+}
+
+void QueueManager::beginDrain()
+{
+    _draining = true;
+}
+
+void QueueManager::endDrain()
+{
+    _draining = false;
+    flushJournal();
+}
+
 #endif
 
 #endif //ENABLE
\ No newline at end of file
@@ -36,6 +36,25 @@
 #include "./FB_Utils.h"
 #include "QueueInfo.h"
 
+// Number of dead (completed) records after which the queue journal is compacted,
+// compaction also waits until the dead records outnumber the live ones.
+#ifndef FIREBASE_QUEUE_JOURNAL_COMPACT_THRESHOLD
+#define FIREBASE_QUEUE_JOURNAL_COMPACT_THRESHOLD 16
+#endif
+
+#define FIREBASE_QUEUE_SLOT_NONE 0xFFFF
+
+struct firebase_queue_slot_t
+{
+    struct QueueItem item;
+    uint16_t generation = 0;
+    uint16_t prev = FIREBASE_QUEUE_SLOT_NONE;
+    uint16_t next = FIREBASE_QUEUE_SLOT_NONE;
+    bool used = false;
+};
+
+// Fixed-capacity slots (grown on demand up to the maximum queues) linked into one FIFO per priority class.
+// The queue ID is the slot index with its reuse generation, the lookup, add and remove are O(1).
 class QueueManager
 {
     friend class FB_RTDB;
@@ -45,14 +64,64 @@ public:
     QueueManager();
     ~QueueManager();
 
-    bool add(QueueItem q);
+    // Add a copy of the item to the tail of its priority class and assign the queue ID to q.qID.
+    bool add(QueueItem &q);
+    // Remove the item at the index in the processing order (see first and next).
     void remove(uint8_t index);
+    bool removeById(uint32_t id);
+    // The item in place, valid until the next add, or nullptr when the queue ID is not existed.
+    QueueItem *get(uint32_t id);
+    // The queue ID of the oldest item in the highest priority class, 0 when empty.
+    uint32_t first();
+    // The queue ID of the item processed after the item with the queue ID, 0 at the end.
+    uint32_t next(uint32_t id);
     size_t size();
 
 private:
     void clear();
-    MB_VECTOR<struct QueueItem> *_queueCollection = nullptr;
-    uint8_t _maxQueue = 10;
+    void release();
+    void setMax(uint16_t num);
+    bool grow();
+    int slotOf(uint32_t id);
+    uint32_t idOf(uint16_t slot) { return ((uint32_t)_slots[slot].generation << 16) | slot; }
+
+    // Binary queue file, a header followed by length-prefixed and checksummed records
+    // ('A' add item, 'D' tombstone by queue ID, 'C' commit marker with the snapshot generation written after a snapshot).
+    // loadFile returns the number of valid records, -1 for a file in other format (JSON) or MB_FS error.
+    static int saveFile(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type, QueueManager *queue);
+    static int loadFile(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type, MB_VECTOR<struct QueueItem> &items,
+                        bool *committed = nullptr, uint32_t *generation = nullptr);
+
+    int beginJournal(MB_FS *mbfs, const MB_String &filename, mbfs_file_type type);
+    void endJournal();
+    bool appendJournal(uint8_t recordType, const struct QueueItem &item);
+    bool writeJournal(uint8_t recordType, const struct QueueItem *item, uint32_t id);
+    bool flushJournal();
+    bool compactJournal();
+    // The items are processed in place, the tombstones of removed items are appended together in endDrain.
+    void beginDrain();
+    void endDrain();
+
+    firebase_queue_slot_t *_slots = nullptr;
+    uint16_t _capacity = 0;
+    uint16_t _count = 0;
+    uint16_t _free = FIREBASE_QUEUE_SLOT_NONE;
+    uint16_t _head[FIREBASE_QUEUE_PRIORITY_CLASSES];
+    uint16_t _tail[FIREBASE_QUEUE_PRIORITY_CLASSES];
+    uint16_t _maxQueue = 10;
+    uint8_t _priority = firebase_queue_priority_normal;
+    uint8_t _drainMode = firebase_queue_drain_mode_sequential;
+    RTDB_QueueDrainInfo _drainInfo;
+    // The slots are not reallocated while the items are being processed in place.
+    bool _draining = false;
+    MB_FS *_mbfs = nullptr;
+    MB_String _journalFile;
+    mbfs_file_type _journalType = mbfs_undefined;
+    uint16_t _journalRecords = 0;
+    // The snapshot generation, increased on every compaction.
+    uint32_t _journalGeneration = 0;
+    // The queue IDs of the items removed while draining, their tombstones are not written yet.
+    MB_VECTOR<uint32_t> _journalPending;
 };
 
 #endif
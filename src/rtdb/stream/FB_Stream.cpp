@@ -185,7 +185,7 @@ void FIREBASE_STREAM_CLASS::mSetResFloat(const char *value)
     if (strlen(value) > 0)
     {
         char *pEnd;
-        fVal.setd(strtod(value, &pEnd));
+        fVal.setd(MB_JSON_StrToDouble(value, &pEnd));
     }
     else
         fVal.setd(0);
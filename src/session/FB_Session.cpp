@@ -48,6 +48,8 @@ FirebaseData::~FirebaseData()
 
     clear();
 
+    unlinkQueueConnections();
+
     if (session.dataPtr)
     {
         delete session.dataPtr;
@@ -127,6 +129,13 @@ int FirebaseData::tcpWrite(const uint8_t *data, size_t size)
     return r;
 }
 
+int FirebaseData::tcpWritev(const esp_ssl_iovec_t *iov, size_t count)
+{
+    int r = tcpClient.writev(iov, count);
+    setSession(false, r > 0);
+    return r;
+}
+
 void FirebaseData::addSession(firebase_con_mode mode)
 {
     setSession(true, false);
@@ -177,6 +186,40 @@ void FirebaseData::addQueueSession()
     }
 }
 #endif
+void FirebaseData::unlinkQueueConnections()
+{
+#if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
+    for (size_t i = 0; i < _queueConnectionOwners.size(); i++)
+    {
+        MB_VECTOR<FirebaseData *> &list = _queueConnectionOwners[i]->_queueConnections;
+        for (size_t j = 0; j < list.size(); j++)
+        {
+            if (list[j] == this)
+            {
+                list.erase(list.begin() + j);
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < _queueConnections.size(); i++)
+    {
+        MB_VECTOR<FirebaseData *> &list = _queueConnections[i]->_queueConnectionOwners;
+        for (size_t j = 0; j < list.size(); j++)
+        {
+            if (list[j] == this)
+            {
+                list.erase(list.begin() + j);
+                break;
+            }
+        }
+    }
+
+    MB_VECTOR<FirebaseData *>().swap(_queueConnectionOwners);
+    MB_VECTOR<FirebaseData *>().swap(_queueConnections);
+#endif
+}
+
 void FirebaseData::removeQueueSession()
 {
     if (!Core.config)
@@ -258,7 +301,7 @@ void FirebaseData::mSetFloatValue(const char *value)
     if (strlen(value) > 0)
     {
         char *pEnd;
-        fVal.setd(strtod(value, &pEnd));
+        fVal.setd(MB_JSON_StrToDouble(value, &pEnd));
     }
     else
         fVal.setd(0);
@@ -552,7 +595,7 @@ void FirebaseData::addQueue(QueueItem *qItem)
 {
     if (_qMan.size() < _qMan._maxQueue && qItem->payload.length() <= session.rtdb.max_blob_size)
     {
-        qItem->qID = random(100000, 200000);
+        qItem->queuePriority = _qMan._priority;
         if (_qMan.add(*qItem))
             session.rtdb.queue_ID = qItem->qID;
         else
@@ -760,6 +803,16 @@ int FirebaseData::maxPayloadLength()
     return session.max_payload_length;
 }
 
+int FirebaseData::sentRecords()
+{
+    return tcpClient.sentRecords();
+}
+
+int FirebaseData::sentBytes()
+{
+    return tcpClient.sentBytes();
+}
+
 #if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
 void FirebaseData::sendStreamToCB(int code, bool report)
 {
@@ -786,6 +839,30 @@ void FirebaseData::closeSession()
     Core.closeSession(&tcpClient, &session);
 }
 
+bool FirebaseData::releaseConnection()
+{
+    // Only the idle connection of non-stream request can be shared
+    if (!Core.config || session.con_mode == firebase_con_mode_undefined ||
+        session.con_mode == firebase_con_mode_rtdb_stream)
+        return false;
+
+#if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
+    // The responses of async requests may be still pending
+    if (session.rtdb.async && (Core.config->rtdb.async_pipeline_depth == 0 || session.rtdb.async_pending.size() > 0))
+        return false;
+#endif
+
+    return Core.tcpPool.release(&tcpClient, &Core.config->connection_pool);
+}
+
+bool FirebaseData::acquireConnection(const char *host, uint16_t port)
+{
+    if (!Core.config)
+        return false;
+
+    return Core.tcpPool.acquire(&tcpClient, host, port, &Core.config->connection_pool);
+}
+
 bool FirebaseData::reconnect(unsigned long dataTime)
 {
     return Core.reconnect(&tcpClient, &session, dataTime);
@@ -847,15 +924,15 @@ void FirebaseData::setSecure()
         if (Core.config->cert.file.length() == 0)
         {
             if (session.cert_ptr > 0)
-                tcpClient.setCACert(reinterpret_cast<const char *>(session.cert_ptr));
+                tcpClient.setCACert(reinterpret_cast<const char *>(session.cert_ptr), &Core.trustAnchors);
             else if (Core.config->cert.data != NULL)
-                tcpClient.setCACert(Core.config->cert.data);
+                tcpClient.setCACert(Core.config->cert.data, &Core.trustAnchors);
             else
                 tcpClient.setCACert(NULL);
         }
         else
         {
-            if (!tcpClient.setCertFile(Core.config->cert.file.c_str(), mbfs_type Core.getCAFileStorage()))
+            if (!tcpClient.setCertFile(Core.config->cert.file.c_str(), mbfs_type Core.getCAFileStorage(), &Core.trustAnchors))
                 tcpClient.setCACert(NULL);
         }
         session.cert_updated = false;
@@ -963,7 +1040,7 @@ bool FirebaseData::readPayload(MB_String *chunkOut, struct firebase_tcp_response
             // read the avilable data
             // chunk transfer encoding?
             if (response.isChunkedEnc)
-                tcpHandler.bufferAvailable = Core.hh.readChunkedData(&Core.sh, &Core.mbfs, &tcpClient, pChunk, nullptr, tcpHandler);
+                tcpHandler.bufferAvailable = Core.hh.readChunkedData(&tcpClient, pChunk, tcpHandler.chunkBufSize, tcpHandler);
             else
             {
 
@@ -972,13 +1049,18 @@ bool FirebaseData::readPayload(MB_String *chunkOut, struct firebase_tcp_response
                 else
                 {
                     // for chunk base64 payload, we need to ensure the size is the multiples of 4 for decoding
+                    int len = tcpHandler.chunkBufSize;
+                    if (tcpHandler.payloadRead + len > tcpHandler.payloadLen)
+                        len = tcpHandler.payloadLen - tcpHandler.payloadRead;
+
+                    // read the available data in block, the connection was checked only when no data to read
                     int readIndex = 0;
-                    while (readIndex < tcpHandler.chunkBufSize && tcpHandler.payloadRead + readIndex < tcpHandler.payloadLen)
+                    while (readIndex < len)
                     {
-                        int r = tcpClient.read();
-                        if (r > -1)
-                            pChunk[readIndex++] = (char)r;
-                        if (!reconnect(tcpHandler.dataTime))
+                        int r = Core.hh.readAvailable(&tcpClient, pChunk + readIndex, len - readIndex);
+                        if (r > 0)
+                            readIndex += r;
+                        else if (!reconnect(tcpHandler.dataTime))
                             break;
                     }
                     tcpHandler.bufferAvailable = readIndex;
@@ -1655,6 +1737,8 @@ void FirebaseData::clear()
 
     _dataAvailableCallback = NULL;
     _multiPathDataCallback = NULL;
+    MB_VECTOR<MultiPathStreamEventCallback>().swap(_multiPathChildCallbacks);
+    MB_VECTOR<struct firebase_mp_stream_path_node_t>().swap(session.rtdb.mp_stream_paths);
     _timeoutCallback = NULL;
     _queueInfoCallback = NULL;
 
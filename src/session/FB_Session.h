@@ -178,6 +178,10 @@ public:
    * @param tx The number of bytes for transmit buffer memory for secured mode BearSSL (512 is minimum, 16384 is maximum).
    *
    * @note Set this option to false to support get large Blob and File operations.
+   *
+   * When config.bssl_buffer.adaptive is true, the buffer sizes will be chosen from the workload of request
+   * (stream, request, file download or upload) and the maximum fragment length negotiation support of host,
+   * these sizes are used only for stream and request to the host that does not support the negotiation.
    */
   void setBSSLBufferSize(uint16_t rx, uint16_t tx);
 
@@ -689,6 +693,18 @@ public:
    */
   int maxPayloadLength();
 
+  /** Get the number of TLS records that were sent for the last request.
+   *
+   * @return integer number of sent records (including TLS handshake records for new connection).
+   */
+  int sentRecords();
+
+  /** Get the number of bytes that were sent on wire for the last request.
+   *
+   * @return integer number of sent bytes (including TLS handshake and record overhead).
+   */
+  int sentBytes();
+
   /** Check the overflow of the returned payload data buffer (RTDB only).
    *
    * @return The overflow status.
@@ -768,6 +784,7 @@ private:
 #if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
   StreamEventCallback _dataAvailableCallback = NULL;
   MultiPathStreamEventCallback _multiPathDataCallback = NULL;
+  MB_VECTOR<MultiPathStreamEventCallback> _multiPathChildCallbacks;
   StreamTimeoutCallback _timeoutCallback = NULL;
   QueueInfoCallback _queueInfoCallback = NULL;
 #endif
@@ -785,6 +802,10 @@ private:
 
 #if defined(ENABLE_RTDB) || defined(FIREBASE_ENABLE_RTDB)
   QueueManager _qMan;
+  // The sessions that the writes of error queues processing are sent on in turn, and the sessions
+  // that send on this session, they are unlinked when either session was destroyed.
+  MB_VECTOR<FirebaseData *> _queueConnections;
+  MB_VECTOR<FirebaseData *> _queueConnectionOwners;
   union IVal
   {
     uint64_t uint64;
@@ -820,6 +841,8 @@ private:
   struct firebase_session_info_t session;
 
   void closeSession();
+  bool releaseConnection();
+  bool acquireConnection(const char *host, uint16_t port);
   bool handleStreamRead();
 #if defined(ENABLE_GC_STORAGE) || defined(FIREBASE_ENABLE_GC_STORAGE)
   void createResumableTask(struct fb_gcs_upload_resumable_task_info_t &ruTask, size_t fileSize,
@@ -888,8 +911,10 @@ private:
   void setSession(bool remove, bool status);
   int tcpSend(const char *s);
   int tcpWrite(const uint8_t *data, size_t size);
+  int tcpWritev(const esp_ssl_iovec_t *iov, size_t count);
   void addQueueSession();
   void removeQueueSession();
+  void unlinkQueueConnections();
   void setRaw(bool trim);
   bool configReady()
   {